@@ -0,0 +1,115 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include "bench.hpp"
+
+// stdlib
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+// project
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/hedged_handler.hpp>
+#include <mikrotik/api/mock/server.hpp>
+#include <mikrotik/api/shared_connection.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+
+// a device answering every 50th request 2 ms late, like one under CPU load.
+// the latencies are reported as the p50 and p99 counters in microseconds, the
+// tail is what hedging is meant to cut
+namespace {
+    mock::server&
+    device() {
+        static mock::server srv;
+        static bool ready = [] {
+            srv.on("/system/identity/print", [](const mock::request&) {
+                static std::atomic<unsigned> calls{0};
+                if (calls.fetch_add(1) % 50 == 0)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                return std::vector<reply>{{reply::re, {"=name=MikroTik"}},
+                                          {reply::done, {}}};
+            });
+            return true;
+        }();
+        (void) ready;
+        return srv;
+    }
+
+    template<class Fn>
+    void
+    measure(benchmark::State& state, Fn&& execute) {
+        std::vector<double> latencies;
+        for (auto _ : state) {
+            auto start = std::chrono::steady_clock::now();
+            benchmark::DoNotOptimize(execute());
+            latencies.push_back(std::chrono::duration<double, std::micro>(
+                                       std::chrono::steady_clock::now() - start)
+                                       .count());
+        }
+        std::sort(latencies.begin(), latencies.end());
+        auto at = [&](double p) {
+            return latencies[static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1))];
+        };
+        state.counters["p50"] = at(0.5);
+        state.counters["p99"] = at(0.99);
+        state.SetItemsProcessed(state.iterations());
+    }
+}
+
+// every sentence waits for the one connection to answer it
+static void
+tail_latency_single(benchmark::State& state) {
+    auto& srv = device();
+    shared_connection conn(srv.address(), "admin", "", srv.port());
+    sentence snt = "system"_cmd / "identity" / "print";
+
+    measure(state, [&] { return conn.submit(snt).get(); });
+}
+BENCHMARK(tail_latency_single)->Iterations(2000)->UseRealTime();
+
+// late sentences are duplicated on a second connection after the p95 latency
+static void
+tail_latency_hedged(benchmark::State& state) {
+    auto& srv = device();
+    hedged_handler api(srv.address(), "admin", "", srv.port());
+    sentence snt = "system"_cmd / "identity" / "print";
+
+    measure(state, [&] { return api.execute(snt); });
+    state.counters["hedges/op"] = benchmark::Counter(static_cast<double>(api.hedges()),
+                                                     benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(tail_latency_hedged)->Iterations(2000)->UseRealTime();
@@ -0,0 +1,63 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <cstddef>
+
+// Google Benchmark
+#include <benchmark/benchmark.h>
+
+namespace bench {
+    // the amount of calls to the global operator new since the start of the program,
+    // counted by the replacement in bench.main.cpp
+    std::size_t allocations() noexcept;
+
+    // counts the allocations made while it is alive, and reports them to the
+    // benchmark as the allocs/op counter
+    struct allocation_counter {
+        explicit allocation_counter(benchmark::State& state) noexcept
+             : _state(state),
+               _start(allocations()) { }
+
+        ~allocation_counter() noexcept {
+            _state.counters["allocs/op"] = benchmark::Counter(static_cast<double>(allocations() - _start),
+                                                              benchmark::Counter::kAvgIterations);
+        }
+
+    private:
+        benchmark::State& _state;
+        std::size_t _start;
+    };
+}
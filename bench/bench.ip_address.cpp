@@ -0,0 +1,94 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include "bench.hpp"
+
+// stdlib
+#include <string_view>
+
+// project
+#include <mikrotik/api/ip_address.hpp>
+using namespace mikrotik::api;
+
+static void
+ip_address_parse(benchmark::State& state) {
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        std::string_view str = "192.168.88.1";
+        benchmark::DoNotOptimize(str);
+        ip_address addr(str);
+        benchmark::DoNotOptimize(addr);
+    }
+}
+BENCHMARK(ip_address_parse);
+
+static void
+ip_address_parse_bad(benchmark::State& state) {
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        std::string_view str = "192.168.888.1";
+        benchmark::DoNotOptimize(str);
+        try {
+            ip_address addr(str);
+            benchmark::DoNotOptimize(addr);
+        } catch (const std::exception& ex) {
+            benchmark::DoNotOptimize(ex);
+        }
+    }
+}
+BENCHMARK(ip_address_parse_bad);
+
+static void
+ip_address_render(benchmark::State& state) {
+    const ip_address addr("192.168.88.1");
+    auto port = static_cast<int>(state.range(0));
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(addr.render(port));
+    }
+}
+BENCHMARK(ip_address_render)->Arg(0)->Arg(8728)->ArgName("port");
+
+static void
+ip_address_to_chars(benchmark::State& state) {
+    const ip_address addr("192.168.88.1");
+    char buf[16];
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(addr.to_chars(buf, buf + sizeof(buf)));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(ip_address_to_chars);
@@ -0,0 +1,123 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include "bench.hpp"
+
+// stdlib
+#include <cstddef>
+#include <string>
+
+// project
+#include "impl/calc_len.hpp"
+#include <mikrotik/api/impl/length_codec.hpp>
+using namespace mikrotik::api::impl;
+
+namespace {
+    // a length from the middle of every size class, by the size of its prefix
+    constexpr const std::size_t class_lengths[] = {0, 0x40, 0x2000, 0x10'0000, 0x800'0000, 0x8000'0000};
+
+    void
+    length_classes(benchmark::internal::Benchmark* bench) {
+        for (int size = 1; size <= 5; ++size) {
+            bench->Arg(size);
+        }
+        bench->ArgName("prefix bytes");
+    }
+}
+
+static void
+encode_length(benchmark::State& state) {
+    auto len = class_lengths[state.range(0)];
+    char buf[max_length_size];
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(len);
+        benchmark::DoNotOptimize(encode_length(len, buf));
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(encode_length)->Apply(length_classes);
+
+static void
+decode_length(benchmark::State& state) {
+    char buf[max_length_size];
+    auto size = encode_length(class_lengths[state.range(0)], buf);
+    std::string_view data(buf, size);
+    std::size_t len = 0;
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(data);
+        benchmark::DoNotOptimize(decode_length(data, len));
+        benchmark::DoNotOptimize(len);
+    }
+}
+BENCHMARK(decode_length)->Apply(length_classes);
+
+// the length of every word of a typical reply, encoded and decoded back to back
+static void
+length_round_trip_mixed(benchmark::State& state) {
+    constexpr const std::size_t lengths[] = {3, 8, 15, 22, 17, 9, 31, 140, 12, 0};
+    char buf[max_length_size * std::size(lengths)];
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        auto out = buf;
+        for (auto len : lengths) {
+            out += encode_length(len, out);
+        }
+        std::string_view data(buf, static_cast<std::size_t>(out - buf));
+        std::size_t sum = 0;
+        while (!data.empty()) {
+            std::size_t len = 0;
+            data.remove_prefix(decode_length(data, len));
+            sum += len;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(std::size(lengths)));
+}
+BENCHMARK(length_round_trip_mixed);
+
+// the string returning version, kept around for compatibility
+static void
+calc_len_string(benchmark::State& state) {
+    std::string word(class_lengths[state.range(0)], 'a');
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calc_len(word));
+    }
+}
+BENCHMARK(calc_len_string)->Arg(1)->Arg(2)->Arg(3)->ArgName("prefix bytes");
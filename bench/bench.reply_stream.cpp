@@ -0,0 +1,195 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include "bench.hpp"
+
+// stdlib
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// project
+#include "impl/calc_len.hpp"
+#include "impl/scan_sentence.hpp"
+#include <mikrotik/api/attribute_map.hpp>
+#include <mikrotik/api/protocol.hpp>
+#include <mikrotik/api/reply.hpp>
+#include <mikrotik/api/reply_view.hpp>
+using namespace mikrotik::api;
+
+namespace {
+    void
+    append_word(std::string& out, std::string_view word) {
+        out += impl::calc_len(word);
+        out += word;
+    }
+
+    // the bytes a router sends as the reply to a print command returning rows rows
+    std::string
+    record_stream(std::size_t rows) {
+        std::string ret;
+        for (std::size_t i = 0; i < rows; ++i) {
+            auto id = std::to_string(i);
+            append_word(ret, "!re");
+            append_word(ret, "=.id=*" + id);
+            append_word(ret, "=name=ether" + id);
+            append_word(ret, "=type=ether");
+            append_word(ret, "=mtu=1500");
+            append_word(ret, "=mac-address=4C:5E:0C:12:34:56");
+            append_word(ret, "=rx-byte=" + std::to_string(i * 1500));
+            append_word(ret, "=running=true");
+            append_word(ret, "=comment=");
+            ret += '\0';
+        }
+        append_word(ret, "!done");
+        ret += '\0';
+        return ret;
+    }
+
+    void
+    stream_sizes(benchmark::internal::Benchmark* bench) {
+        bench->RangeMultiplier(10)
+              ->Range(1'000, 1'000'000)
+              ->ArgName("rows")
+              ->Unit(benchmark::kMillisecond);
+    }
+
+    // calls fn with every reply in data, as read_view() would see them
+    template<class Fn>
+    void
+    decode(std::string_view data, Fn&& fn) {
+        std::vector<std::string_view> words;
+        reply_view view;
+        std::size_t need;
+        while (auto size = impl::scan_sentence(data, words, need)) {
+            impl::make_view(words, view);
+            fn(view);
+            data.remove_prefix(size);
+        }
+    }
+
+    void
+    report(benchmark::State& state, const std::string& data) {
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+        state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(data.size()));
+    }
+}
+
+// decoding into views pointing into the stream, like read_view() and stream()
+static void
+reply_stream_view(benchmark::State& state) {
+    auto data = record_stream(static_cast<std::size_t>(state.range(0)));
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        std::size_t attrs = 0;
+        decode(data, [&attrs](const reply_view& view) {
+            attrs += view.attributes.size();
+        });
+        benchmark::DoNotOptimize(attrs);
+    }
+    report(state, data);
+}
+BENCHMARK(reply_stream_view)->Apply(stream_sizes);
+
+// feeding the protocol in chunks of the size of a socket read, like api_handler
+// does, without the system calls
+static void
+reply_stream_protocol(benchmark::State& state) {
+    auto data = record_stream(static_cast<std::size_t>(state.range(0)));
+    constexpr const std::size_t chunk = 16 * 1024;
+
+    protocol proto;
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        std::size_t attrs = 0;
+        std::string_view rest = data;
+        while (!rest.empty()) {
+            auto ev = proto.next_event();
+            if (ev == protocol::need_input) {
+                auto len = std::min(chunk, rest.size());
+                proto.feed(rest.substr(0, len));
+                rest.remove_prefix(len);
+            } else {
+                attrs += proto.view().attributes.size();
+            }
+        }
+        while (proto.next_event() == protocol::received) {
+            attrs += proto.view().attributes.size();
+        }
+        benchmark::DoNotOptimize(attrs);
+    }
+    report(state, data);
+}
+BENCHMARK(reply_stream_protocol)->Apply(stream_sizes);
+
+// decoding into owning replies, like read()
+static void
+reply_stream_copy(benchmark::State& state) {
+    auto data = record_stream(static_cast<std::size_t>(state.range(0)));
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        decode(data, [](const reply_view& view) {
+            reply rep;
+            rep.reply_type = view.reply_type;
+            rep.attributes.assign(view.attributes.begin(), view.attributes.end());
+            benchmark::DoNotOptimize(rep);
+        });
+    }
+    report(state, data);
+}
+BENCHMARK(reply_stream_copy)->Apply(stream_sizes);
+
+// decoding into views and looking up attributes in each row
+static void
+reply_stream_attribute_map(benchmark::State& state) {
+    auto data = record_stream(static_cast<std::size_t>(state.range(0)));
+    constexpr const attribute_map::key name("name");
+    constexpr const attribute_map::key rx_byte("rx-byte");
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        std::size_t found = 0;
+        decode(data, [&](const reply_view& view) {
+            attribute_map attrs(view);
+            found += attrs.get(name).has_value();
+            found += attrs.get(rx_byte).has_value();
+        });
+        benchmark::DoNotOptimize(found);
+    }
+    report(state, data);
+}
+BENCHMARK(reply_stream_attribute_map)->Apply(stream_sizes);
@@ -0,0 +1,123 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include "bench.hpp"
+
+// stdlib
+#include <string>
+#include <vector>
+
+// project
+#include <mikrotik/api/api_handler.hpp>
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/mock/server.hpp>
+#include <mikrotik/api/pipeline.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+
+// the allocation counters of these include the allocations of the server threads
+namespace {
+    mock::server&
+    device() {
+        static mock::server srv;
+        static bool ready = [] {
+            srv.table("/system/identity", {{{"name", "MikroTik"}}});
+            srv.generate("/interface", 100'000, [](std::size_t idx) {
+                auto id = std::to_string(idx);
+                return mock::row{{".id", "*" + id},
+                                 {"name", "ether" + id},
+                                 {"type", "ether"},
+                                 {"mtu", "1500"},
+                                 {"running", "true"}};
+            });
+            return true;
+        }();
+        (void) ready;
+        return srv;
+    }
+}
+
+// one command and its replies at a time over loopback
+static void
+round_trip(benchmark::State& state) {
+    auto& srv = device();
+    api_handler api(srv.address(), "admin", "", srv.port());
+    sentence snt = "system"_cmd / "identity" / "print";
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        api.send(snt);
+        while (api.read_view().reply_type != reply_view::done) { }
+    }
+}
+BENCHMARK(round_trip);
+
+// the same commands, the given amount of them in flight at a time
+static void
+round_trip_pipelined(benchmark::State& state) {
+    auto& srv = device();
+    api_handler api(srv.address(), "admin", "", srv.port());
+    pipeline pipe(api);
+    sentence snt = "system"_cmd / "identity" / "print";
+    std::vector<pipeline::tag_type> tags(static_cast<std::size_t>(state.range(0)));
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        for (auto& tag : tags) {
+            tag = pipe.submit(snt);
+        }
+        for (auto tag : tags) {
+            while (pipe.read(tag).reply_type != reply::done) { }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(round_trip_pipelined)->RangeMultiplier(4)->Range(1, 64)->ArgName("in flight");
+
+static void
+stream_rows(benchmark::State& state) {
+    auto& srv = device();
+    api_handler api(srv.address(), "admin", "", srv.port());
+    auto snt = ("interface"_cmd / "print")({"running", "true"});
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        std::size_t rows = 0;
+        for (const auto& row : api.stream(snt)) {
+            rows += row.attributes.size() != 0;
+        }
+        benchmark::DoNotOptimize(rows);
+    }
+    state.SetItemsProcessed(state.iterations() * 100'000);
+}
+BENCHMARK(stream_rows)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,178 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include "bench.hpp"
+
+// stdlib
+#include <string>
+#include <vector>
+
+// project
+#include "impl/encode_sentence.hpp"
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/ip_address.hpp>
+#include <mikrotik/api/prepared_sentence.hpp>
+#include <mikrotik/api/protocol.hpp>
+#include <mikrotik/api/sentence.hpp>
+#include <mikrotik/api/static_command.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+
+static void
+sentence_dsl(benchmark::State& state) {
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        auto snt = ("ip"_cmd / "address" / "add")[{"address", "10.0.0.1/24"}]
+                                                 [{"interface", "ether1"}]
+                                                 [{"comment", "uplink"}];
+        benchmark::DoNotOptimize(snt);
+    }
+}
+BENCHMARK(sentence_dsl);
+
+static void
+sentence_builder(benchmark::State& state) {
+    constexpr auto cmd = command_path("ip", "address", "add");
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        sentence snt = cmd;
+        snt.add_attribute("address", "10.0.0.1/24")
+           .add_attribute("interface", "ether1")
+           .add_attribute("comment", "uplink");
+        benchmark::DoNotOptimize(snt);
+    }
+}
+BENCHMARK(sentence_builder);
+
+static void
+sentence_builder_typed(benchmark::State& state) {
+    constexpr auto cmd = command_path("interface", "print");
+    const ip_address address("10.0.0.1");
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        sentence snt = cmd;
+        snt.add_attribute("count", 42)
+           .add_attribute("disabled", false)
+           .add_query("address", address);
+        benchmark::DoNotOptimize(snt);
+    }
+}
+BENCHMARK(sentence_builder_typed);
+
+static void
+prepared_sentence_bind(benchmark::State& state) {
+    prepared_sentence snt(("ip"_cmd / "address" / "add")[{"interface", "ether1"}],
+                          {"address", "comment"});
+    auto address = snt.slot("address");
+    auto comment = snt.slot("comment");
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        snt.bind(address, "10.0.0.1/24")
+           .bind(comment, "uplink");
+        benchmark::DoNotOptimize(snt);
+    }
+}
+BENCHMARK(prepared_sentence_bind);
+
+// the buffers passed to the socket when the sentence is sent
+static void
+sentence_encode(benchmark::State& state) {
+    auto snt = ("ip"_cmd / "address" / "add")[{"address", "10.0.0.1/24"}]
+                                             [{"interface", "ether1"}]
+                                             [{"comment", "uplink"}];
+    std::string trailer;
+    std::vector<impl::socket::buffer> bufs;
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        bufs.clear();
+        impl::encode_sentence(snt, ".tag=1", trailer, bufs);
+        benchmark::DoNotOptimize(bufs.data());
+    }
+}
+BENCHMARK(sentence_encode);
+
+// queuing a sentence, and taking the gather list written to the socket,
+// which the sentence is sent from without copying its bytes
+static void
+sentence_send(benchmark::State& state) {
+    auto snt = ("ip"_cmd / "address" / "add")[{"address", "10.0.0.1/24"}]
+                                             [{"interface", "ether1"}]
+                                             [{"comment", "uplink"}];
+    protocol proto;
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        proto.send(snt, ".tag=1");
+        auto out = proto.next_output();
+        benchmark::DoNotOptimize(out.bufs);
+        proto.consume_output(out.size());
+    }
+}
+BENCHMARK(sentence_send);
+
+static void
+static_command_send(benchmark::State& state) {
+    constexpr auto cmd = command_path("system", "identity", "print");
+    protocol proto;
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        proto.send_encoded(cmd.encoded());
+        auto out = proto.next_output();
+        benchmark::DoNotOptimize(out.bufs);
+        proto.consume_output(out.size());
+    }
+}
+BENCHMARK(static_command_send);
+
+static void
+prepared_sentence_send(benchmark::State& state) {
+    prepared_sentence snt(("ip"_cmd / "address" / "add")[{"interface", "ether1"}],
+                          {"address", "comment"});
+    snt.bind(snt.slot("address"), "10.0.0.1/24")
+       .bind(snt.slot("comment"), "uplink");
+    protocol proto;
+
+    bench::allocation_counter allocs(state);
+    for (auto _ : state) {
+        proto.send(snt, ".tag=1");
+        auto out = proto.next_output();
+        benchmark::DoNotOptimize(out.bufs);
+        proto.consume_output(out.size());
+    }
+}
+BENCHMARK(prepared_sentence_send);
@@ -0,0 +1,128 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include "bench.hpp"
+
+// stdlib
+#include <future>
+#include <memory>
+#include <vector>
+
+// project
+#include <mikrotik/api/api_handler.hpp>
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/mock/server.hpp>
+#include <mikrotik/api/shared_connection.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+
+// every submitting thread sends a command and waits for its replies, so the
+// throughput shows how well the connections scale with the amount of threads.
+// allocations are not counted, as the counter is shared by all threads
+namespace {
+    mock::server&
+    device() {
+        static mock::server srv;
+        static bool ready = [] {
+            srv.table("/system/identity", {{{"name", "MikroTik"}}});
+            return true;
+        }();
+        (void) ready;
+        return srv;
+    }
+
+    std::unique_ptr<shared_connection> shared;
+
+    void
+    thread_counts(benchmark::internal::Benchmark* bench) {
+        bench->ThreadRange(1, 32)->UseRealTime();
+    }
+}
+
+// all threads submit to one shared connection
+static void
+contention_shared_connection(benchmark::State& state) {
+    auto& srv = device();
+    if (state.thread_index() == 0)
+        shared = std::make_unique<shared_connection>(srv.address(), "admin", "", srv.port());
+    sentence snt = "system"_cmd / "identity" / "print";
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(shared->submit(snt).get());
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+        shared.reset();
+}
+BENCHMARK(contention_shared_connection)->Apply(thread_counts);
+
+// the same commands, submitted a batch at a time, so the I/O thread has more
+// commands to send with a single write
+static void
+contention_shared_connection_batched(benchmark::State& state) {
+    auto& srv = device();
+    if (state.thread_index() == 0)
+        shared = std::make_unique<shared_connection>(srv.address(), "admin", "", srv.port());
+    sentence snt = "system"_cmd / "identity" / "print";
+    std::vector<std::future<std::vector<reply>>> futures(16);
+
+    for (auto _ : state) {
+        for (auto& fut : futures) {
+            fut = shared->submit(snt);
+        }
+        for (auto& fut : futures) {
+            benchmark::DoNotOptimize(fut.get());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(futures.size()));
+
+    if (state.thread_index() == 0)
+        shared.reset();
+}
+BENCHMARK(contention_shared_connection_batched)->Apply(thread_counts);
+
+// every thread with its own api_handler, and its own session on the device
+static void
+contention_own_connections(benchmark::State& state) {
+    auto& srv = device();
+    api_handler api(srv.address(), "admin", "", srv.port());
+    sentence snt = "system"_cmd / "identity" / "print";
+
+    for (auto _ : state) {
+        api.send(snt);
+        while (api.read_view().reply_type != reply_view::done) { }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(contention_own_connections)->Apply(thread_counts);
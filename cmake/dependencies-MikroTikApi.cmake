@@ -59,6 +59,10 @@ else ()
     )
 endif ()
 
+## System dependencies
+set(THREADS_PREFER_PTHREAD_FLAG On)
+find_package(Threads REQUIRED)
+
 ## Test Dependencies
 if (${PROJECT_NAME}_BUILD_TESTS)
     # Catch2
@@ -70,6 +74,18 @@ if (${PROJECT_NAME}_BUILD_TESTS)
 
 endif ()
 
+## Benchmark Dependencies
+if (${PROJECT_NAME}_BUILD_BENCHMARKS)
+    # Google Benchmark
+    set(BENCHMARK_ENABLE_TESTING Off CACHE BOOL "Disable the tests of Google Benchmark" FORCE)
+    GetDependency(
+            benchmark
+            REPOSITORY_URL https://github.com/google/benchmark.git
+            VERSION v1.7.1
+    )
+
+endif ()
+
 ## Example Dependencies
 if (${PROJECT_NAME}_BUILD_EXAMPLES)
     # cxxopts
@@ -0,0 +1,162 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include "counters.hpp"
+
+// stdlib
+#include <cstdlib>
+#include <new>
+
+#ifdef __linux__
+#    include <dlfcn.h>
+#    include <poll.h>
+#    include <sys/socket.h>
+#    include <unistd.h>
+#endif
+
+namespace {
+    thread_local bool enabled = false;
+    thread_local counters::snapshot work;
+}
+
+bool
+counters::syscalls_supported() noexcept {
+#ifdef __linux__
+    return true;
+#else
+    return false;
+#endif
+}
+
+void
+counters::enable() noexcept {
+    enabled = true;
+    work = {};
+}
+
+counters::snapshot
+counters::current() noexcept {
+    return work;
+}
+
+// allocations are counted by replacing the global operator new
+
+void*
+operator new(std::size_t size) {
+    if (enabled)
+        ++work.allocations;
+    if (auto ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void
+operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void
+operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+// socket calls are counted by interposing the libc functions, which the
+// dynamic linker resolves to these instead of the ones in libc
+#ifdef __linux__
+namespace {
+    template<class Fn>
+    Fn*
+    real(Fn*& fn, const char* name) noexcept {
+        if (!fn)
+            fn = reinterpret_cast<Fn*>(dlsym(RTLD_NEXT, name));
+        return fn;
+    }
+
+    void
+    count_call() noexcept {
+        if (enabled)
+            ++work.syscalls;
+    }
+
+    ssize_t
+    count_io(ssize_t ret, std::uint64_t& bytes) noexcept {
+        if (enabled && ret > 0)
+            bytes += static_cast<std::uint64_t>(ret);
+        return ret;
+    }
+}
+
+extern "C" {
+int
+socket(int domain, int type, int protocol) noexcept {
+    static decltype(::socket)* fn = nullptr;
+    count_call();
+    return real(fn, "socket")(domain, type, protocol);
+}
+
+int
+connect(int fd, const sockaddr* addr, socklen_t len) {
+    static decltype(::connect)* fn = nullptr;
+    count_call();
+    return real(fn, "connect")(fd, addr, len);
+}
+
+int
+poll(pollfd* fds, nfds_t count, int timeout) {
+    static decltype(::poll)* fn = nullptr;
+    count_call();
+    return real(fn, "poll")(fds, count, timeout);
+}
+
+ssize_t
+recv(int fd, void* buf, size_t len, int flags) {
+    static decltype(::recv)* fn = nullptr;
+    count_call();
+    return count_io(real(fn, "recv")(fd, buf, len, flags), work.bytes_in);
+}
+
+ssize_t
+send(int fd, const void* buf, size_t len, int flags) {
+    static decltype(::send)* fn = nullptr;
+    count_call();
+    return count_io(real(fn, "send")(fd, buf, len, flags), work.bytes_out);
+}
+
+ssize_t
+sendmsg(int fd, const msghdr* msg, int flags) {
+    static decltype(::sendmsg)* fn = nullptr;
+    count_call();
+    return count_io(real(fn, "sendmsg")(fd, msg, flags), work.bytes_out);
+}
+}
+#endif
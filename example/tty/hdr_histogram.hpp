@@ -0,0 +1,147 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * \brief A latency histogram with 3 significant digits over a huge range
+ *
+ * Works like HdrHistogram: values are counted in buckets of doubling size,
+ * each one split into 1024 sub-buckets, so every recorded value is kept with
+ * an error of at most 1/1024 of its magnitude, from 1 up to max_value.
+ * Recording is a few instructions, and the memory used does not depend on
+ * the amount of recorded values.
+ */
+struct hdr_histogram {
+    /// The largest value kept exactly, about an hour in nanoseconds
+    static constexpr const std::uint64_t max_value = (std::uint64_t{1} << 42) - 1;
+
+    hdr_histogram()
+         : _counts(index_of(max_value) + 1) { }
+
+    void
+    record(std::uint64_t value) noexcept {
+        value = std::min(value, max_value);
+        ++_counts[index_of(value)];
+        ++_total;
+        _sum += value;
+        _min = std::min(_min, value);
+        _max = std::max(_max, value);
+    }
+
+    void
+    merge(const hdr_histogram& other) noexcept {
+        for (std::size_t i = 0; i < _counts.size(); ++i) {
+            _counts[i] += other._counts[i];
+        }
+        _total += other._total;
+        _sum += other._sum;
+        _min = std::min(_min, other._min);
+        _max = std::max(_max, other._max);
+    }
+
+    std::uint64_t count() const noexcept { return _total; }
+    std::uint64_t min() const noexcept { return _total ? _min : 0; }
+    std::uint64_t max() const noexcept { return _max; }
+
+    double
+    mean() const noexcept {
+        return _total ? static_cast<double>(_sum) / static_cast<double>(_total) : 0.0;
+    }
+
+    // the smallest value that percentile percent of the recorded values are not
+    // larger than, rounded up to the end of its sub-bucket
+    std::uint64_t
+    value_at(double percentile) const noexcept {
+        if (_total == 0)
+            return 0;
+        auto wanted = static_cast<std::uint64_t>(percentile / 100.0 * static_cast<double>(_total) + 0.5);
+        wanted = std::clamp<std::uint64_t>(wanted, 1, _total);
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < _counts.size(); ++i) {
+            seen += _counts[i];
+            if (seen >= wanted)
+                return std::min(highest_of(i), _max);
+        }
+        return _max;
+    }
+
+private:
+    static constexpr const unsigned sub_bits = 10;
+    static constexpr const std::uint64_t sub_count = std::uint64_t{1} << sub_bits;
+
+    // values below 2 * sub_count are counted exactly, above that bucket k >= 1
+    // counts [sub_count << k, 2 * sub_count << k) in sub_count steps of 1 << k
+    static std::size_t
+    index_of(std::uint64_t value) noexcept {
+        if (value < 2 * sub_count)
+            return static_cast<std::size_t>(value);
+        auto k = msb(value) - sub_bits;
+        return static_cast<std::size_t>(2 * sub_count + (k - 1) * sub_count + ((value >> k) - sub_count));
+    }
+
+    static std::uint64_t
+    highest_of(std::size_t index) noexcept {
+        if (index < 2 * sub_count)
+            return index;
+        auto k = (index - 2 * sub_count) / sub_count + 1;
+        auto sub = (index - 2 * sub_count) % sub_count + sub_count;
+        return ((sub + 1) << k) - 1;
+    }
+
+    static unsigned
+    msb(std::uint64_t value) noexcept {
+#ifdef __GNUC__
+        return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned ret = 0;
+        while (value >>= 1) {
+            ++ret;
+        }
+        return ret;
+#endif
+    }
+
+    std::vector<std::uint64_t> _counts;
+    std::uint64_t _total = 0;
+    std::uint64_t _sum = 0;
+    std::uint64_t _min = max_value;
+    std::uint64_t _max = 0;
+};
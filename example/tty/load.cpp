@@ -0,0 +1,252 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include "load.hpp"
+
+// stdlib
+#include <atomic>
+#include <exception>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+// {fmt}
+#include "lib/fmt.hpp"
+
+// MikroTikAPI
+#include <mikrotik/api/api_handler.hpp>
+
+// project
+#include "counters.hpp"
+#include "hdr_histogram.hpp"
+
+using clock_type = std::chrono::steady_clock;
+
+namespace {
+    struct worker_result {
+        hdr_histogram latencies;
+        counters::snapshot work;
+        std::uint64_t commands = 0;
+        std::uint64_t traps = 0;
+        clock_type::time_point finish;
+        std::string error;
+    };
+
+    struct shared_state {
+        clock_type::time_point start;
+        clock_type::time_point end;
+        std::atomic<std::uint64_t> remaining;
+    };
+
+    bool
+    take_one(const load_options& opts, shared_state& shared) noexcept {
+        if (opts.count == 0)
+            return true;
+        auto left = shared.remaining.load();
+        while (left != 0) {
+            if (shared.remaining.compare_exchange_weak(left, left - 1))
+                return true;
+        }
+        return false;
+    }
+
+    void
+    run_worker(unsigned idx, const load_options& opts, shared_state& shared, worker_result& res) {
+        counters::enable();
+        try {
+            mikrotik::api::api_handler api(opts.address.c_str(), opts.user, opts.pass, opts.port);
+
+            std::vector<mikrotik::api::sentence> sentences;
+            std::vector<std::size_t> wheel;
+            for (const auto& cmd : opts.mix) {
+                for (unsigned i = 0; i < cmd.weight; ++i) {
+                    wheel.push_back(sentences.size());
+                }
+                sentences.emplace_back(cmd.words.begin(), cmd.words.end());
+            }
+            std::mt19937 rng(idx);
+            std::uniform_int_distribution<std::size_t> pick(0, wheel.size() - 1);
+
+            // commands are sent at fixed intervals when a rate is given, and their latency
+            // is measured from when they should have been sent, so a slow reply does not hide
+            // the delay it causes to the commands after it
+            auto interval = std::chrono::duration_cast<clock_type::duration>(
+                   std::chrono::duration<double>(opts.rate > 0 ? opts.concurrency / opts.rate : 0.0));
+            auto next = shared.start + interval * idx / opts.concurrency;
+
+            // every connection logs in before the measurement starts
+            std::this_thread::sleep_until(shared.start);
+            auto base = counters::current();
+            while (clock_type::now() < shared.end && take_one(opts, shared)) {
+                auto begin = clock_type::now();
+                if (opts.rate > 0) {
+                    // the next command would be due after the measurement ended
+                    if (next >= shared.end)
+                        break;
+                    std::this_thread::sleep_until(next);
+                    begin = next;
+                    next += interval;
+                }
+
+                api.send(sentences[wheel[pick(rng)]]);
+                auto type = mikrotik::api::reply::re;
+                while (type != mikrotik::api::reply::done && type != mikrotik::api::reply::fatal) {
+                    type = api.read_view().reply_type;
+                    res.traps += type == mikrotik::api::reply::trap;
+                }
+                if (type == mikrotik::api::reply::fatal)
+                    throw std::runtime_error("connection terminated by the device");
+
+                auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - begin);
+                res.latencies.record(static_cast<std::uint64_t>(latency.count()));
+                ++res.commands;
+            }
+
+            auto now = counters::current();
+            res.work.allocations = now.allocations - base.allocations;
+            res.work.syscalls = now.syscalls - base.syscalls;
+            res.work.bytes_in = now.bytes_in - base.bytes_in;
+            res.work.bytes_out = now.bytes_out - base.bytes_out;
+        } catch (const std::exception& ex) {
+            res.error = ex.what();
+        }
+        res.finish = clock_type::now();
+    }
+
+    double
+    per_command(std::uint64_t total, std::uint64_t commands) {
+        return commands ? static_cast<double>(total) / static_cast<double>(commands) : 0.0;
+    }
+
+    double
+    in_us(std::uint64_t ns) {
+        return static_cast<double>(ns) / 1000.0;
+    }
+}
+
+std::vector<weighted_command>
+parse_mix(std::istream& in) {
+    std::vector<weighted_command> ret;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream words(line);
+        weighted_command cmd{1, {}};
+        std::string word;
+        while (words >> word) {
+            cmd.words.push_back(word);
+        }
+        if (cmd.words.empty() || cmd.words.front()[0] == '#')
+            continue;
+
+        auto& first = cmd.words.front();
+        if (first.find_first_not_of("0123456789") == std::string::npos) {
+            cmd.weight = static_cast<unsigned>(std::stoul(first));
+            cmd.words.erase(cmd.words.begin());
+        }
+        if (!cmd.words.empty() && cmd.weight != 0)
+            ret.push_back(std::move(cmd));
+    }
+    return ret;
+}
+
+int
+run_load(const load_options& opts) {
+    if (opts.mix.empty()) {
+        fmt::print("no commands to send\n");
+        return -1;
+    }
+
+    shared_state shared;
+    shared.remaining = opts.count;
+    shared.start = clock_type::now() + std::chrono::milliseconds(100 + 10 * opts.concurrency);
+    shared.end = shared.start + std::chrono::duration_cast<clock_type::duration>(opts.duration);
+
+    std::vector<worker_result> results(opts.concurrency);
+    std::vector<std::thread> workers;
+    for (unsigned i = 0; i < opts.concurrency; ++i) {
+        workers.emplace_back(run_worker, i, std::cref(opts), std::ref(shared), std::ref(results[i]));
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    hdr_histogram latencies;
+    counters::snapshot work;
+    std::uint64_t commands = 0;
+    std::uint64_t traps = 0;
+    std::size_t errors = 0;
+    auto finish = shared.start;
+    for (const auto& res : results) {
+        finish = std::max(finish, res.finish);
+        latencies.merge(res.latencies);
+        work.allocations += res.work.allocations;
+        work.syscalls += res.work.syscalls;
+        work.bytes_in += res.work.bytes_in;
+        work.bytes_out += res.work.bytes_out;
+        commands += res.commands;
+        traps += res.traps;
+        if (!res.error.empty()) {
+            fmt::print("connection failed: {}\n", res.error);
+            ++errors;
+        }
+    }
+
+    auto elapsed = std::chrono::duration<double>(finish - shared.start).count();
+    if (elapsed <= 0)
+        elapsed = 1e-9;
+    fmt::print("commands:    {} ({} traps) in {:.2f} s over {} connections, {} failed\n",
+               commands, traps, elapsed, opts.concurrency, errors);
+    fmt::print("throughput:  {:.1f} commands/s\n", static_cast<double>(commands) / elapsed);
+    fmt::print("latency:     min {:.1f} us, p50 {:.1f} us, p90 {:.1f} us, p99 {:.1f} us, "
+               "p99.9 {:.1f} us, max {:.1f} us, mean {:.1f} us\n",
+               in_us(latencies.min()),
+               in_us(latencies.value_at(50)),
+               in_us(latencies.value_at(90)),
+               in_us(latencies.value_at(99)),
+               in_us(latencies.value_at(99.9)),
+               in_us(latencies.max()),
+               latencies.mean() / 1000.0);
+    if (counters::syscalls_supported()) {
+        fmt::print("bandwidth:   {:.2f} MiB/s in, {:.2f} MiB/s out\n",
+                   static_cast<double>(work.bytes_in) / elapsed / 1048576.0,
+                   static_cast<double>(work.bytes_out) / elapsed / 1048576.0);
+        fmt::print("per command: {:.2f} syscalls, {:.2f} allocations\n",
+                   per_command(work.syscalls, commands),
+                   per_command(work.allocations, commands));
+    } else {
+        fmt::print("per command: {:.2f} allocations\n",
+                   per_command(work.allocations, commands));
+    }
+    return errors == 0 ? 0 : -1;
+}
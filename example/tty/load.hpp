@@ -0,0 +1,69 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <chrono>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+/// A command of the load and how often it is sent relative to the others
+struct weighted_command {
+    unsigned weight;                ///< The relative frequency of the command
+    std::vector<std::string> words; ///< The words of the command
+};
+
+/// What load to generate against which device
+struct load_options {
+    std::string address;
+    std::uint16_t port = 8728;
+    std::string user;
+    std::string pass;
+
+    std::vector<weighted_command> mix;                 ///< The commands to send
+    unsigned concurrency = 1;                          ///< The amount of connections, each on its own thread
+    double rate = 0;                                   ///< Commands per second in total, or 0 to send as fast as possible
+    std::chrono::duration<double> duration{10};        ///< How long to send commands for
+    std::uint64_t count = 0;                           ///< The maximum amount of commands to send, or 0 for no limit
+};
+
+// reads a command mix: every line is a command with its words separated by
+// whitespace, optionally preceded by its weight. empty lines and lines starting
+// with # are skipped
+std::vector<weighted_command> parse_mix(std::istream& in);
+
+// generates the load, then prints the report. returns the exit code of the program
+int run_load(const load_options& opts);
@@ -32,8 +32,14 @@
 //
 
 // stdlib
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <exception>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <sstream>
 #include <string>
 
 // {fmt}
@@ -48,8 +54,12 @@
 // MikroTikAPI
 #include <mikrotik/api/api_handler.hpp>
 #include <mikrotik/api/command.hpp>
+#include <mikrotik/api/mock/server.hpp>
 using namespace mikrotik::api::literals;
 
+// project
+#include "load.hpp"
+
 int
 main(int argc, char** argv) {
     cxxopts::Options opts("mikrottyk", "A MikroTik device tty presenting the usage of MikroTikAPI.");
@@ -62,8 +72,34 @@ main(int argc, char** argv) {
                 cxxopts::value<std::string>()->default_value(""))
            ("4,ip4", "The IPv4 address of the MikroTik device. [192.168.88.1]",
                 cxxopts::value<std::string>()->default_value("192.168.88.1"))
+           ("port", "The port of the API service of the MikroTik device. [8728]",
+                cxxopts::value<std::uint16_t>()->default_value("8728"))
            ("h,help", "Print this help message")
     ;
+    opts.add_options("Bench")
+           ("b,bench", "Instead of the tty, send commands to the device as a load generator, "
+                       "and report the throughput and latencies.")
+           ("c,concurrency", "The amount of connections sending commands in parallel. [1]",
+                cxxopts::value<unsigned>()->default_value("1"))
+           ("r,rate", "The amount of commands to send per second on all connections, 0 for "
+                      "as fast as possible. [0]",
+                cxxopts::value<double>()->default_value("0"))
+           ("d,duration", "The amount of seconds to send commands for. [10]",
+                cxxopts::value<double>()->default_value("10"))
+           ("n,count", "The maximum amount of commands to send, 0 for no limit. [0]",
+                cxxopts::value<std::uint64_t>()->default_value("0"))
+           ("command", "The command to send, with its words separated by spaces. "
+                       "[/system/resource/print]",
+                cxxopts::value<std::string>()->default_value("/system/resource/print"))
+           ("m,mix", "A file of commands to send instead of --command: one command per line, "
+                     "optionally preceded by its relative weight.",
+                cxxopts::value<std::string>())
+           ("mock", "Send the commands to a mock device started in the process instead.")
+           ("mock-rows", "The amount of rows in each table of the mock device. [10]",
+                cxxopts::value<std::size_t>()->default_value("10"))
+           ("mock-latency", "The latency of the mock device in microseconds. [0]",
+                cxxopts::value<long>()->default_value("0"))
+    ;
     // clang-format on
 
     auto ops = opts.parse(argc, argv);
@@ -77,9 +113,60 @@ main(int argc, char** argv) {
     std::string usr = ops["user"].as<std::string>();
     std::string passwd = ops["password"].as<std::string>();
     std::string ip4 = ops["ip4"].as<std::string>();
+    auto port = ops["port"].as<std::uint16_t>();
+
+    // mock device
+    std::unique_ptr<mikrotik::api::mock::server> mock;
+    if (ops.count("mock")) {
+        try {
+            mock = std::make_unique<mikrotik::api::mock::server>();
+        } catch (const std::exception& ex) {
+            fmt::print(ex.what());
+            return -1;
+        }
+        mock->add_user(usr, passwd);
+        auto rows = ops["mock-rows"].as<std::size_t>();
+        for (auto path : {"/interface", "/ip/address", "/ip/route", "/system/resource"}) {
+            mock->generate(path, rows, [](std::size_t idx) {
+                auto id = std::to_string(idx);
+                return mikrotik::api::mock::row{{".id", "*" + id},
+                                                {"name", "item" + id},
+                                                {"comment", "generated by mikrottyk"},
+                                                {"disabled", "false"}};
+            });
+        }
+        mock->latency(std::chrono::microseconds(ops["mock-latency"].as<long>()));
+        ip4 = "127.0.0.1";
+        port = mock->port();
+    }
+
+    // load generator
+    if (ops.count("bench")) {
+        load_options load;
+        load.address = ip4;
+        load.port = port;
+        load.user = usr;
+        load.pass = passwd;
+        load.concurrency = std::max(ops["concurrency"].as<unsigned>(), 1u);
+        load.rate = ops["rate"].as<double>();
+        load.duration = std::chrono::duration<double>(ops["duration"].as<double>());
+        load.count = ops["count"].as<std::uint64_t>();
+        if (ops.count("mix")) {
+            std::ifstream mix(ops["mix"].as<std::string>());
+            if (!mix) {
+                fmt::print("cannot open command mix: {}\n", ops["mix"].as<std::string>());
+                return -1;
+            }
+            load.mix = parse_mix(mix);
+        } else {
+            std::istringstream command(ops["command"].as<std::string>());
+            load.mix = parse_mix(command);
+        }
+        return run_load(load);
+    }
 
     try {
-        mikrotik::api::api_handler api(ip4.c_str(), usr, passwd);
+        mikrotik::api::api_handler api(ip4.c_str(), usr, passwd, port);
 
         std::vector<std::string> words;
         for (;;) {
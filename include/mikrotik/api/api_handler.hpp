@@ -34,17 +34,31 @@
 #pragma once
 
 // stdlib
+#include <chrono>
+#include <cstdint>
+#include <memory_resource>
 #include <string>
 #include <string_view>
+#include <vector>
 
 // project
 #include "impl/sockets.hpp"
 #include "ip_address.hpp"
+#include "prepared_sentence.hpp"
+#include "protocol.hpp"
 #include "reply.hpp"
+#include "reply_view.hpp"
+#include "row_stream.hpp"
 #include "sentence.hpp"
+#include "static_command.hpp"
+#include "timeouts.hpp"
 #include <mikrotik_api_export.h>
 
 namespace mikrotik::api {
+    namespace impl {
+        struct connector;
+    }
+
     /**
      * \brief Handles all interaction with the MikroTik API.
      *
@@ -63,6 +77,9 @@ namespace mikrotik::api {
      * a timeout is likely to occur, which will result in an exception,
      * but will also halt the program for some time,
      * before the resident socket library realizes data's incorrect.
+     * To not wait for the socket library, pass \ref timeouts to the constructor:
+     * connecting, logging in, and every send and read then throw
+     * \ref socket_timeout if they take longer than allowed.
      *
      * The public API allows sending and receiving sentences.
      * A sentence according to the MikroTik API docs, is a list of words,
@@ -125,12 +142,21 @@ namespace mikrotik::api {
          * the function will always send it after sending the contents of the
          * sentence.
          *
+         * The whole sentence is sent with as few calls to the resident socket
+         * implementation as possible, usually one, and the function only returns
+         * after all of the sentence has been written to the socket.
+         *
+         * \throw bad_word: If a word of the sentence is too long to be sent.
+         * \throw bad_socket: If the sentence could not be written to the socket.
+         * \throw socket_timeout: If sending takes longer than the operation timeout.
+         *
          * \rst
          * .. warning::
          *  This function does not deal with the reply just sends the sentence
          *  and it's done with it.
          *  To ensure no reply data gets lost, or dislocated from its sent sentence,
          *  always make sure to call read after using this function to get the device's reply.
+         *  To have multiple sentences in flight at once, use a \ref pipeline.
          * \endrst
          *
          * \param snt The sentence to send
@@ -139,6 +165,44 @@ namespace mikrotik::api {
          */
         void send(const sentence& snt);
 
+        /**
+         * \brief Sends a \ref prepared_sentence through the open connection
+         *
+         * Sends the encoded words of the prepared sentence, with the values
+         * currently bound to its slots. Nothing is encoded again except for the
+         * length of the slots, which is computed when binding.
+         *
+         * \throw bad_socket: If the sentence could not be written to the socket.
+         * \throw socket_timeout: If sending takes longer than the operation timeout.
+         *
+         * \param snt The prepared sentence to send
+         *
+         * \since v1.2.0
+         */
+        void send(const prepared_sentence& snt);
+
+        /**
+         * \brief Sends a command encoded at compile time
+         *
+         * The command is sent as is with a single write, without
+         * encoding or allocating anything.
+         *
+         * \tparam Len The length of the command word
+         * \param cmd The command to send
+         *
+         * \throw bad_socket: If the command could not be written to the socket.
+         * \throw socket_timeout: If sending takes longer than the operation timeout.
+         *
+         * \sa static_command
+         *
+         * \since v1.2.0
+         */
+        template<std::size_t Len>
+        void
+        send(const static_command<Len>& cmd) {
+            send_encoded(cmd.encoded());
+        }
+
         /**
          * \brief Reads the reply sentence from the connection
          *
@@ -176,6 +240,119 @@ namespace mikrotik::api {
          */
         mikrotik::api::reply read();
 
+        /**
+         * \brief Reads the reply sentence from the connection without copying it
+         *
+         * Does the same as read(), but the returned \ref reply_view does not own
+         * the words of the reply: they point into the receive buffer of
+         * the connection. This way no memory is allocated for the words of the reply.
+         *
+         * The returned reference, and all the views it contains, remain valid
+         * until the next call to read() or read_view() on this object, after
+         * which they must not be used. If the data is required for longer,
+         * copy it out, or use read().
+         *
+         * \code
+         * api.send("interface"_cmd / "print");
+         * for (;;) {
+         *     const auto& rep = api.read_view();
+         *     if (rep.reply_type != rep.re)
+         *         break;
+         *     for (std::string_view attr : rep.attributes) {
+         *         // use attr before the next read
+         *     }
+         * }
+         * \endcode
+         *
+         * \return The reply from the MikroTik device, valid until the next read
+         *
+         * \throw bad_socket: If the data could not be read from the socket.
+         * \throw socket_timeout: If reading takes longer than the operation timeout.
+         *
+         * \since v1.2.0
+         */
+        const reply_view& read_view();
+
+        /**
+         * \brief Reads the reply sentence from the connection into a \ref pmr::reply
+         *
+         * Does the same as read(), but the attributes of the reply are allocated
+         * using the allocator of the given reply. The previous attributes of
+         * the reply are cleared first.
+         *
+         * \param rep The reply to read into
+         *
+         * \throw bad_socket: If the data could not be read from the socket.
+         * \throw socket_timeout: If reading takes longer than the operation timeout.
+         *
+         * \since v1.2.0
+         */
+        void read(pmr::reply& rep);
+
+        /**
+         * \brief Reads the reply sentence from the connection using the memory resource of the handler
+         *
+         * Does the same as read(), but the attributes of the returned reply are
+         * allocated from the memory resource set by set_memory_resource().
+         *
+         * \return The reply from the MikroTik device
+         *
+         * \throw bad_socket: If the data could not be read from the socket.
+         * \throw socket_timeout: If reading takes longer than the operation timeout.
+         *
+         * \since v1.2.0
+         */
+        pmr::reply read_pmr();
+
+        /**
+         * \brief Sets the memory resource replies are allocated from
+         *
+         * The memory resource is used by read_pmr(). The handler's own buffers,
+         * which live as long as the connection, are not allocated from it,
+         * so the resource may be released between reads, when no replies
+         * allocated from it are alive anymore.
+         *
+         * \param resource The memory resource to use, must outlive its use by the handler
+         *
+         * \since v1.2.0
+         */
+        void set_memory_resource(std::pmr::memory_resource* resource) noexcept;
+
+        /**
+         * \brief Returns the memory resource replies are allocated from
+         *
+         * \return The memory resource set by set_memory_resource(),
+         *  or the default memory resource if none was set
+         *
+         * \since v1.2.0
+         */
+        std::pmr::memory_resource* memory_resource() const noexcept;
+
+        /**
+         * \brief Sends a command, and returns its rows as a lazy input range
+         *
+         * Instead of reading all `!re` replies into memory, the returned
+         * \ref row_stream reads them one by one during iteration, into the same
+         * buffer, so printing tables of any size takes constant memory.
+         *
+         * \code
+         * for (const auto& row : api.stream("ip"_cmd / "route" / "print")) {
+         *     // row is a reply_view, valid until the next row is read
+         * }
+         * \endcode
+         *
+         * While the stream is alive, the connection must not be used for anything else.
+         *
+         * \param snt The command to send
+         * \return The stream of the `!re` replies of the command
+         *
+         * \throw bad_word: If a word of the sentence is too long to be sent.
+         * \throw bad_socket: If the sentence could not be sent.
+         *
+         * \since v1.2.0
+         */
+        row_stream stream(const sentence& snt);
+
         /**
          * \brief Disconnects from the MikroTik device
          *
@@ -218,16 +395,46 @@ namespace mikrotik::api {
          * \throw bad_socket: If an error arises from the resident socket
          * implementation: cannot create socket, cannot connect, or cannot send/read
          * data.
+         * \throw socket_timeout: If connecting or logging in takes longer than
+         * allowed by limits.
          *
          * \param address The IPv4 address of the MikroTik device to connect to.
          * \param user The username to log in as
          * \param pass The password of the provided user
+         * \param port The port of the API service on the device. Available
+         *  since v1.2.0.
+         * \param limits The time limits of connecting, logging in, and every later
+         *  send and read. Available since v1.2.0.
          *
          * \since v1.0.0
          */
         explicit api_handler(ip_address address = "192.168.88.1",
                              std::string_view user = "admin",
-                             std::string_view pass = "");
+                             std::string_view pass = "",
+                             std::uint16_t port = 8728,
+                             const timeouts& limits = {});
+
+        /**
+         * \brief Changes the time limits of sending and reading
+         *
+         * Only the operation limit is used after the constructor.
+         *
+         * \param limits The new time limits
+         *
+         * \throw bad_socket: If the socket cannot be switched to the required mode.
+         *
+         * \since v1.2.0
+         */
+        void set_timeouts(const timeouts& limits);
+
+        /**
+         * \brief The time limits of the operations
+         *
+         * \return The time limits currently used
+         *
+         * \since v1.2.0
+         */
+        const timeouts& get_timeouts() const noexcept;
 
         /**
          * \brief Destructor that terminates connection
@@ -254,18 +461,39 @@ namespace mikrotik::api {
         virtual ~api_handler() noexcept;
 
     private:
-        std::string read_word();
-        void send_word(std::string_view word);
+        friend struct connection_pool;
+        friend struct pipeline;
+        friend struct row_stream;
+        friend struct shared_connection;
+        friend struct impl::connector;
 
-        std::int32_t read_len();
+        // adopts a connected and logged in socket
+        api_handler(impl::socket::handle sock, protocol&& proto, const timeouts& limits);
+
+        void send(const sentence& snt, std::string_view api_attr);
+        void send(const prepared_sentence& snt, std::string_view api_attr);
+        void send_encoded(std::string_view bytes);
+        void flush();
+        void fill();
+        void start(std::string_view operation, std::chrono::milliseconds limit);
+        void wait(short events);
 
         impl::socket::handle _sock;
+        protocol _proto;
+        std::pmr::memory_resource* _resource = std::pmr::get_default_resource();
+
+        // deadline of the current operation
+        timeouts _timeouts;
+        bool _logging_in = false;
+        std::string_view _operation;
+        std::chrono::milliseconds _limit{0};
+        std::chrono::steady_clock::time_point _deadline;
 
         // socket handling
         void initialize_sockets() const;
         void mk_socket();
-        void connect_to_device(const ip_address& address);
-        sockaddr mk_addr(const ip_address& address) const;
+        void connect_to_device(const ip_address& address, std::uint16_t port);
+        sockaddr mk_addr(const ip_address& address, std::uint16_t port) const;
         void login(std::string_view usr, std::string_view passwd);
     };
 }
@@ -0,0 +1,205 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+#if !defined(__cpp_impl_coroutine) && !defined(__cpp_coroutines)
+#    error "mikrotik/api/async_generator.hpp requires C++20 coroutines"
+#endif
+
+// stdlib
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace mikrotik::api {
+    /**
+     * \brief A coroutine producing a sequence of values asynchronously
+     *
+     * Like \ref task, but instead of a single result, it `co_yield`s values one at
+     * a time, and between values, it may suspend waiting for something else, like
+     * data from the network. The consumer awaits next() to get the next value, or
+     * an empty optional if the sequence is over.
+     *
+     * \code
+     * auto rows = api.rows("interface"_cmd / "print");
+     * while (auto row = co_await rows.next()) {
+     *     // use *row
+     * }
+     * \endcode
+     *
+     * An exception exiting the coroutine is rethrown from the `co_await` of
+     * the next() call that would have returned the next value.
+     *
+     * Like a task, it's lazy, it only runs when the next value is requested,
+     * and destroying the generator destroys the coroutine.
+     *
+     * \tparam T The type of the values produced
+     *
+     * \since v1.2.0
+     */
+    template<class T>
+    struct async_generator {
+        /**
+         * \brief The promise type of the coroutine
+         *
+         * \since v1.2.0
+         */
+        struct promise_type {
+            struct yield_awaiter {
+                bool await_ready() noexcept {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> self) noexcept {
+                    return self.promise().consumer;
+                }
+
+                void await_resume() noexcept { }
+            };
+
+            async_generator get_return_object() noexcept {
+                return async_generator{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() noexcept {
+                return {};
+            }
+
+            yield_awaiter final_suspend() noexcept {
+                return {};
+            }
+
+            yield_awaiter yield_value(std::remove_reference_t<T>& val) noexcept {
+                current = std::addressof(val);
+                return {};
+            }
+
+            yield_awaiter yield_value(std::remove_reference_t<T>&& val) noexcept {
+                current = std::addressof(val);
+                return {};
+            }
+
+            void return_void() noexcept { }
+
+            void unhandled_exception() noexcept {
+                error = std::current_exception();
+            }
+
+            std::remove_reference_t<T>* current = nullptr;
+            std::exception_ptr error;
+            std::coroutine_handle<> consumer;
+        };
+
+        /**
+         * \brief Moves the ownership of the coroutine into a new generator
+         *
+         * \param other The generator to take the coroutine from
+         *
+         * \since v1.2.0
+         */
+        async_generator(async_generator&& other) noexcept
+             : _coro(std::exchange(other._coro, {})) { }
+
+        /**
+         * \brief Moves the ownership of the coroutine into this generator
+         *
+         * \param other The generator to take the coroutine from
+         * \return This generator
+         *
+         * \since v1.2.0
+         */
+        async_generator& operator=(async_generator&& other) noexcept {
+            if (this != &other) {
+                if (_coro)
+                    _coro.destroy();
+                _coro = std::exchange(other._coro, {});
+            }
+            return *this;
+        }
+
+        /**
+         * \brief Destroys the coroutine
+         *
+         * \since v1.2.0
+         */
+        ~async_generator() {
+            if (_coro)
+                _coro.destroy();
+        }
+
+        /**
+         * \brief Resumes the coroutine to produce the next value
+         *
+         * \return An awaitable resulting in the next value, or an empty
+         *  optional if the coroutine finished
+         *
+         * \since v1.2.0
+         */
+        auto next() noexcept {
+            struct awaiter {
+                std::coroutine_handle<promise_type> coro;
+
+                bool await_ready() noexcept {
+                    return !coro || coro.done();
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> cont) noexcept {
+                    coro.promise().consumer = cont;
+                    coro.promise().current = nullptr;
+                    return coro;
+                }
+
+                std::optional<std::remove_cv_t<std::remove_reference_t<T>>> await_resume() {
+                    if (!coro)
+                        return std::nullopt;
+                    auto& prom = coro.promise();
+                    if (prom.error)
+                        std::rethrow_exception(std::exchange(prom.error, {}));
+                    if (coro.done() || prom.current == nullptr)
+                        return std::nullopt;
+                    return std::move(*prom.current);
+                }
+            };
+            return awaiter{_coro};
+        }
+
+    private:
+        explicit async_generator(std::coroutine_handle<promise_type> coro) noexcept
+             : _coro(coro) { }
+
+        std::coroutine_handle<promise_type> _coro;
+    };
+}
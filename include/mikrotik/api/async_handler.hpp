@@ -0,0 +1,205 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+#if !defined(__cpp_impl_coroutine) && !defined(__cpp_coroutines)
+#    error "mikrotik/api/async_handler.hpp requires C++20 coroutines"
+#endif
+
+// stdlib
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// project
+#include "async_generator.hpp"
+#include "event_loop.hpp"
+#include "impl/sockets.hpp"
+#include "ip_address.hpp"
+#include "protocol.hpp"
+#include "reply.hpp"
+#include "reply_view.hpp"
+#include "sentence.hpp"
+#include "task.hpp"
+#include "timeouts.hpp"
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    /**
+     * \brief The coroutine counterpart of \ref api_handler
+     *
+     * Connects to, logs into, and executes commands on a device without
+     * ever blocking the calling thread: all operations are coroutines, which
+     * suspend while the socket is not ready and let the \ref event_loop run
+     * other coroutines in the meantime. This way a single thread can talk to
+     * many devices at the same time.
+     *
+     * Every sentence is sent with a unique `.tag`, and replies with a foreign
+     * tag are dropped, so a command abandoned midway, for example by destroying
+     * its rows() generator early, does not confuse the commands executed after it.
+     * Commands of the same handler must not be executed concurrently, however;
+     * for that, use more handlers.
+     *
+     * \code
+     * mt::task<void> print_interfaces(mt::event_loop& loop, mt::ip_address ip) {
+     *     mt::async_handler api(loop);
+     *     co_await api.connect(ip, "admin", "");
+     *
+     *     auto rows = api.rows("interface"_cmd / "print");
+     *     while (auto row = co_await rows.next()) {
+     *         // use *row
+     *     }
+     * }
+     *
+     * mt::event_loop loop;
+     * loop.spawn(print_interfaces(loop, "192.168.88.1"_ip));
+     * loop.run();
+     * \endcode
+     *
+     * Only available if the library was built with coroutine support.
+     *
+     * \since v1.2.0
+     */
+    struct MIKROTIK_API_EXPORT async_handler {
+        /**
+         * \brief Creates an unconnected handler
+         *
+         * \param loop The event loop to wait in for the socket
+         *
+         * \since v1.2.0
+         */
+        explicit async_handler(event_loop& loop) noexcept;
+
+        async_handler(const async_handler&) = delete;
+        async_handler& operator=(const async_handler&) = delete;
+
+        /**
+         * \brief Closes the connection, if any
+         *
+         * \since v1.2.0
+         */
+        ~async_handler() noexcept;
+
+        /**
+         * \brief Connects to and logs into the device
+         *
+         * \param address The IP address of the device
+         * \param user The user to log in as
+         * \param pass The password of the user
+         * \param port The port of the API service on the device
+         * \param limits The time limits of connecting, logging in, and of every
+         *  send and read on the connection. Zero limits wait forever
+         * \return The task to `co_await`
+         *
+         * \throw bad_socket: If the connection could not be established, or the
+         *  login failed.
+         * \throw socket_timeout: If connecting or logging in took longer than allowed.
+         *
+         * \since v1.2.0
+         */
+        task<void> connect(ip_address address,
+                           std::string user,
+                           std::string pass,
+                           std::uint16_t port = 8728,
+                           const timeouts& limits = {});
+
+        /**
+         * \brief Executes a command, and collects all its replies
+         *
+         * \param snt The sentence to send
+         * \return The task resulting in all replies to the sentence, the last
+         *  being its `!done` reply
+         *
+         * \throw bad_command: If the device replied with a `!trap`.
+         * \throw bad_socket: If the connection failed, or the device replied
+         *  with a `!fatal`.
+         * \throw socket_timeout: If sending the sentence, or reading a reply took
+         *  longer than the operation limit.
+         *
+         * \since v1.2.0
+         */
+        task<std::vector<reply>> execute(sentence snt);
+
+        /**
+         * \brief Executes a command, and produces its `!re` replies one by one
+         *
+         * The replies are read lazily: the next one is only read from the
+         * socket, when the previous one was consumed. The generator finishes
+         * on the `!done` reply of the command.
+         *
+         * \param snt The sentence to send
+         * \return The generator of the `!re` replies
+         *
+         * \throw bad_command: If the device replied with a `!trap`.
+         * \throw bad_socket: If the connection failed, or the device replied
+         *  with a `!fatal`.
+         * \throw socket_timeout: If sending the sentence, or reading a reply took
+         *  longer than the operation limit.
+         *
+         * \since v1.2.0
+         */
+        async_generator<reply> rows(sentence snt);
+
+        /**
+         * \brief Closes the connection
+         *
+         * \return The return value of the underlying socket close call, 0 on success
+         *
+         * \since v1.2.0
+         */
+        int disconnect() noexcept;
+
+    private:
+        task<std::uint32_t> send(const sentence& snt);
+        task<void> flush();
+        task<protocol::event> receive();
+        task<const reply_view*> read_view(std::uint32_t tag);
+        void start(std::string_view operation, std::chrono::milliseconds limit);
+        event_loop::clock::time_point deadline() const noexcept;
+
+        event_loop& _loop;
+        impl::socket::handle _sock = INVALID_SOCKET;
+        std::uint32_t _next_tag = 1;
+        protocol _proto;
+
+        // deadline of the current operation
+        timeouts _timeouts;
+        bool _logging_in = false;
+        std::string_view _operation;
+        std::chrono::milliseconds _limit{0};
+        event_loop::clock::time_point _deadline;
+    };
+}
@@ -0,0 +1,216 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// project
+#include "reply.hpp"
+#include "reply_view.hpp"
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    /**
+     * \brief An index of the attributes of a reply sentence
+     *
+     * Splits the attribute words of a reply into their name and value
+     * once, and indexes them by name in a flat hash table, so
+     * looking up an attribute by its name does not require scanning and
+     * splitting all words of the reply again.
+     *
+     * Both attribute words (`=<name>=<value>`) and API attribute words
+     * (`.<name>=<value>`) are indexed: the former by `<name>`, the latter by
+     * `.<name>`, as in `.tag`. Other words are ignored.
+     *
+     * The map does not own any strings: names and values are views into the
+     * words of the reply it was created from. It must not outlive that reply,
+     * or in case of a \ref reply_view, the next read on the connection.
+     * The map can be reused for multiple replies through assign(), in which case
+     * it does not allocate after its storage has grown big enough.
+     *
+     * \code
+     * mt::attribute_map attrs;
+     * for (;;) {
+     *     const auto& rep = api.read_view();
+     *     if (rep.reply_type != rep.re)
+     *         break;
+     *     attrs.assign(rep);
+     *     auto rx = attrs.get("rx-byte"); // std::optional<std::string_view>
+     * }
+     * \endcode
+     *
+     * \since v1.2.0
+     */
+    struct MIKROTIK_API_EXPORT attribute_map {
+        /**
+         * \brief A pre-hashed attribute name
+         *
+         * Lookups with a key skip hashing the name, which is useful for names
+         * that are looked up in every row of a big reply. Keys can be created
+         * at compile time.
+         *
+         * \since v1.2.0
+         */
+        struct key {
+            /**
+             * \brief Creates a key by hashing the given name
+             *
+             * \param name The attribute name, without the leading equals sign
+             *
+             * \since v1.2.0
+             */
+            constexpr key(std::string_view name) noexcept
+                 : name(name),
+                   hash(hash_of(name)) { }
+            /**
+             * \copydoc key(std::string_view)
+             */
+            constexpr key(const char* name) noexcept
+                 : key(std::string_view{name}) { }
+
+            std::string_view name; ///< The name of the attribute
+            std::uint32_t hash;    ///< The hash of the name
+
+            /**
+             * \brief The hash function used by the map
+             *
+             * \param str The string to hash
+             * \return The 32 bit FNV-1a hash of the string
+             *
+             * \since v1.2.0
+             */
+            static constexpr std::uint32_t hash_of(std::string_view str) noexcept {
+                std::uint32_t hash = 2166136261u;
+                for (char c : str) {
+                    hash ^= static_cast<unsigned char>(c);
+                    hash *= 16777619u;
+                }
+                return hash;
+            }
+        };
+
+        /**
+         * \brief Creates the empty map
+         *
+         * \since v1.2.0
+         */
+        attribute_map() = default;
+        /**
+         * \brief Creates a map indexing the attributes of the reply
+         *
+         * \param rep The reply to index
+         *
+         * \since v1.2.0
+         */
+        explicit attribute_map(const reply& rep);
+        /**
+         * \copydoc attribute_map(const reply&)
+         */
+        explicit attribute_map(const reply_view& rep);
+        /**
+         * \brief Not allowed, the map would refer to the words of a destroyed reply
+         */
+        explicit attribute_map(reply&&) = delete;
+
+        /**
+         * \brief Replaces the contents of the map with the attributes of the reply
+         *
+         * Reuses the storage of the map, so after indexing a few rows, no memory
+         * is allocated.
+         *
+         * \param rep The reply to index
+         *
+         * \since v1.2.0
+         */
+        void assign(const reply& rep);
+        /**
+         * \copydoc assign(const reply&)
+         */
+        void assign(const reply_view& rep);
+        /**
+         * \brief Not allowed, the map would refer to the words of a destroyed reply
+         */
+        void assign(reply&&) = delete;
+
+        /**
+         * \brief Looks up the value of an attribute
+         *
+         * \param name The name of the attribute to look up, or a prehashed key.
+         * \return The value of the attribute, or an empty optional if the
+         *  reply does not contain the attribute.
+         *
+         * \since v1.2.0
+         */
+        std::optional<std::string_view> get(key name) const noexcept;
+
+        /**
+         * \brief Checks if the reply contains the given attribute
+         *
+         * \param name The name of the attribute to look for, or a prehashed key.
+         * \return Whether the attribute exists in the reply
+         *
+         * \since v1.2.0
+         */
+        bool contains(key name) const noexcept;
+
+        /**
+         * \brief The amount of attributes indexed
+         *
+         * \return The amount of attributes in the map
+         *
+         * \since v1.2.0
+         */
+        std::size_t size() const noexcept;
+
+    private:
+        struct entry {
+            std::string_view name;
+            std::string_view value;
+            std::uint32_t hash;
+        };
+
+        template<class It>
+        void index(It beg, It end);
+        void add(std::string_view word);
+        const entry* find(key name) const noexcept;
+
+        std::vector<entry> _entries;
+        std::vector<std::uint32_t> _slots;// index into _entries + 1, 0 is empty
+    };
+}
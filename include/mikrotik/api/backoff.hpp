@@ -0,0 +1,81 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <chrono>
+#include <cstddef>
+#include <random>
+
+// project
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    /**
+     * \brief Exponential backoff with full jitter between retries
+     *
+     * The delay before the `n`th retry, counting from zero, is chosen uniformly
+     * at random between zero and `initial * multiplier^n`, but at most `max`.
+     * The randomness spreads out the clients that lost their connections at the
+     * same time, for example because the device rebooted, so they do not all try
+     * to reconnect at once.
+     *
+     * \since v1.2.0
+     */
+    struct MIKROTIK_API_EXPORT backoff {
+        /// The upper bound of the delay before the first retry
+        std::chrono::milliseconds initial{200};
+
+        /// The upper bound of the delay before any retry
+        std::chrono::milliseconds max{std::chrono::seconds(30)};
+
+        /// The growth of the upper bound after each retry
+        double multiplier = 2.0;
+
+        /// The amount of tries, including the first one, before giving up.
+        /// Zero means trying forever
+        std::size_t attempts = 5;
+
+        /**
+         * \brief Chooses the delay before a retry
+         *
+         * \param retry The index of the retry, zero for the first retry
+         * \param rng The random number generator to use
+         * \return The time to wait before the retry
+         *
+         * \since v1.2.0
+         */
+        std::chrono::milliseconds delay(std::size_t retry, std::mt19937& rng) const;
+    };
+}
@@ -0,0 +1,156 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// project
+#include "api_handler.hpp"
+#include "ip_address.hpp"
+#include "timeouts.hpp"
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    /**
+     * \brief A device to connect to, and the credentials to log in with
+     *
+     * \since v1.2.0
+     */
+    struct endpoint {
+        ip_address address;          ///< The IPv4 address of the device
+        std::string user = "admin";  ///< The username to log in as
+        std::string pass;            ///< The password of the user
+        std::uint16_t port = 8728;   ///< The port of the API service on the device
+    };
+
+    /**
+     * \brief The settings of \ref bootstrap
+     *
+     * \since v1.2.0
+     */
+    struct bootstrap_options {
+        /// The maximum amount of devices being connected to, or logged into, at once
+        std::size_t max_in_flight = 256;
+
+        /// The time limits of connecting and logging in, and the limits the connections
+        /// are created with. A device not answering in time fails with \ref socket_timeout
+        timeouts limits{std::chrono::seconds(10), std::chrono::seconds(10), {}};
+    };
+
+    /**
+     * \brief The result of connecting to a device
+     *
+     * \since v1.2.0
+     */
+    struct bootstrap_result {
+        std::unique_ptr<api_handler> api; ///< The logged in connection, or null on failure
+        std::exception_ptr error;         ///< The reason of the failure, or null on success
+    };
+
+    /**
+     * \brief The callback called when a device is connected to, or failed
+     *
+     * Receives the index of the device in the list given to \ref bootstrap, and its result.
+     *
+     * \since v1.2.0
+     */
+    using bootstrap_callback = std::function<void(std::size_t index, bootstrap_result&& result)>;
+
+    /**
+     * \brief Connects and logs into many devices at once
+     *
+     * Creating \ref api_handler "api_handlers" one after the other takes the sum of
+     * the round trips of all devices, for large fleets, minutes. This connects to the
+     * devices and logs into them concurrently on the calling thread, waiting for all
+     * sockets at once with epoll on Linux, or poll everywhere else, so the whole takes
+     * about as long as the slowest device, as long as no more than
+     * \ref bootstrap_options::max_in_flight devices are given.
+     * Further devices are started as the earlier ones complete.
+     *
+     * The callback is called on the calling thread as each device completes, in the
+     * order of completion.
+     *
+     * \code
+     * std::vector<mt::endpoint> fleet;
+     * for (const auto& ip : routers)
+     *     fleet.push_back({ip, "admin", ""});
+     *
+     * mt::bootstrap(fleet, [&](std::size_t idx, mt::bootstrap_result&& res) {
+     *     if (res.api)
+     *         handlers[idx] = std::move(res.api);
+     *     else
+     *         log_failure(fleet[idx], res.error);
+     * });
+     * \endcode
+     *
+     * \param devices The devices to connect to
+     * \param done The callback to call with the result of each device
+     * \param opts The settings of the connecting
+     *
+     * \throw bad_socket: If waiting for the sockets failed. Failures of single devices
+     *  are passed to the callback.
+     * \throw Any exception thrown by the callback, after closing the connections in progress.
+     *
+     * \since v1.2.0
+     */
+    MIKROTIK_API_EXPORT
+    void bootstrap(const std::vector<endpoint>& devices,
+                   const bootstrap_callback& done,
+                   const bootstrap_options& opts = {});
+
+    /**
+     * \brief Connects and logs into many devices at once, and waits for all of them
+     *
+     * Does the same as the callback version, but collects the results.
+     *
+     * \param devices The devices to connect to
+     * \param opts The settings of the connecting
+     * \return The result of each device, at the same index as the device
+     *
+     * \throw bad_socket: If waiting for the sockets failed.
+     *
+     * \since v1.2.0
+     */
+    MIKROTIK_API_EXPORT
+    std::vector<bootstrap_result> bootstrap(const std::vector<endpoint>& devices,
+                                            const bootstrap_options& opts = {});
+}
@@ -0,0 +1,228 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// project
+#include "ip_address.hpp"
+#include "reply.hpp"
+#include "sentence.hpp"
+#include "timeouts.hpp"
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    /**
+     * \brief Talks to many devices at once from a few threads
+     *
+     * An \ref api_handler blocks the calling thread during every operation,
+     * so talking to thousands of devices requires thousands of threads, or
+     * happens one device at a time. A connection manager instead keeps every
+     * connection non-blocking, and drives them as state machines
+     * (connecting, logging in, sending, and reading) as their socket operations
+     * complete. If the library was built with io_uring support, and the kernel
+     * supports it, the operations of all connections of a thread are submitted to
+     * an io_uring in batches, otherwise they are performed when epoll on Linux, or
+     * poll everywhere else reports their sockets ready.
+     *
+     * Connections are added with add(), and commands are queued on them with
+     * execute(). Nothing happens until run() is called, which connects and logs
+     * into all new connections, executes all queued commands, and returns when
+     * all of them have completed. Commands of the same connection are executed
+     * in the order they were queued, commands of different connections concurrently.
+     *
+     * \code
+     * mt::connection_manager mgr(4); // use 4 threads
+     * for (const auto& ip : routers) {
+     *     auto conn = mgr.add(ip, "admin", "");
+     *     mgr.execute(conn, "system"_cmd / "resource" / "print",
+     *                 [](std::vector<mt::reply>&& replies, std::exception_ptr err) {
+     *                     // handle the replies, or the error
+     *                 });
+     * }
+     * mgr.run();
+     * \endcode
+     *
+     * The connections are divided between the threads, each thread owning its
+     * connections exclusively. The completion callbacks of a connection are called
+     * on the thread owning it, so callbacks of different connections may be called
+     * concurrently. A callback may queue further commands on its own connection, but
+     * otherwise the manager must not be used during run().
+     *
+     * Connections are kept alive between calls to run(), so later commands do not need to
+     * connect and log in again.
+     *
+     * Every connection may be given \ref timeouts when added. A connection exceeding
+     * a limit fails with \ref socket_timeout, while the other connections carry on.
+     * Without limits, a device which stops answering holds up run() forever.
+     *
+     * \since v1.2.0
+     */
+    struct MIKROTIK_API_EXPORT connection_manager {
+        /**
+         * \brief The identifier of a connection in the manager
+         *
+         * \since v1.2.0
+         */
+        using connection_id = std::size_t;
+
+        /**
+         * \brief The callback called when a command completes
+         *
+         * On success, it receives all replies to the command, the last being
+         * the `!done` reply, and an empty exception pointer. A `!trap` reply
+         * does not count as failure, it is just part of the replies.
+         * If the connection failed before the command completed, it receives the
+         * replies read so far, and a pointer to a \ref bad_socket exception, or to a
+         * \ref socket_timeout if the connection exceeded one of its limits.
+         *
+         * \since v1.2.0
+         */
+        using completion = std::function<void(std::vector<reply>&& replies, std::exception_ptr error)>;
+
+        /**
+         * \brief The way the threads wait for the socket operations
+         *
+         * \since v1.2.0
+         */
+        enum class backend {
+            automatic, ///< io_uring if built with it and supported by the kernel, otherwise poll
+            poll       ///< Performs the operations when epoll, or poll reports their sockets ready
+        };
+
+        /**
+         * \brief Creates an empty connection manager
+         *
+         * \param threads The amount of threads to drive connections on during run().
+         *  The calling thread of run() counts as one of them.
+         * \param io The backend of the threads
+         *
+         * \since v1.2.0
+         */
+        explicit connection_manager(std::size_t threads = 1, backend io = backend::automatic);
+
+        connection_manager(const connection_manager&) = delete;
+        connection_manager& operator=(const connection_manager&) = delete;
+
+        /**
+         * \brief Closes all connections
+         *
+         * \since v1.2.0
+         */
+        ~connection_manager() noexcept;
+
+        /**
+         * \brief Adds a new connection to a device
+         *
+         * The connection is established during the next run().
+         *
+         * \param address The IP address of the device
+         * \param user The user to log in as
+         * \param pass The password of the user
+         * \param port The port of the API service on the device
+         * \param limits The time limits of connecting, logging in, and of sending each
+         *  sentence and reading each reply sentence
+         * \return The identifier of the connection
+         *
+         * \since v1.2.0
+         */
+        connection_id add(ip_address address,
+                          std::string user = "admin",
+                          std::string pass = "",
+                          std::uint16_t port = 8728,
+                          const timeouts& limits = {});
+
+        /**
+         * \brief Queues a command on a connection
+         *
+         * The command is sent during the next run(), after all commands queued
+         * earlier on the same connection have completed. If the connection has
+         * failed, the command fails during the next run() without being sent.
+         *
+         * \param conn The connection to execute the command on
+         * \param snt The sentence to send
+         * \param done The callback to call with the result of the command
+         *
+         * \since v1.2.0
+         */
+        void execute(connection_id conn, sentence snt, completion done);
+
+        /**
+         * \brief Drives all connections until all queued commands complete
+         *
+         * \throw bad_socket: If waiting on the sockets failed.
+         * \throw Any exception thrown by a completion callback, after all threads stopped.
+         *
+         * \since v1.2.0
+         */
+        void run();
+
+        /**
+         * \brief Returns the amount of connections added
+         *
+         * \return The amount of connections in the manager
+         *
+         * \since v1.2.0
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * \brief Checks whether a connection has failed
+         *
+         * A failed connection stays failed, to retry, add a new connection.
+         *
+         * \param conn The connection to check
+         * \return Whether the connection has failed
+         *
+         * \since v1.2.0
+         */
+        bool failed(connection_id conn) const noexcept;
+
+    private:
+        struct connection;
+        struct shard;
+
+        void run_shard(shard& shrd);
+
+        std::vector<std::unique_ptr<connection>> _conns;
+        std::vector<std::unique_ptr<shard>> _shards;
+    };
+}
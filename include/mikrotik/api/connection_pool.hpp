@@ -0,0 +1,280 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+// project
+#include "api_handler.hpp"
+#include "ip_address.hpp"
+#include "timeouts.hpp"
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    /**
+     * \brief The settings of a \ref connection_pool
+     *
+     * \since v1.2.0
+     */
+    struct pool_options {
+        /// The amount of idle connections kept ready for every device leased from
+        /// recently, by maintain()
+        std::size_t warm_spares = 0;
+
+        /// The maximum amount of connections to a device, leased and idle together.
+        /// If all of them are leased, leasing waits until one is returned. Zero
+        /// means no limit
+        std::size_t max_per_device = 0;
+
+        /// Connections idle for longer than this are checked with a keep-alive
+        /// command before being leased
+        std::chrono::milliseconds validate_after = std::chrono::seconds(30);
+
+        /// The time allowed for the keep-alive command to complete
+        std::chrono::milliseconds keep_alive_timeout = std::chrono::seconds(5);
+
+        /// Connections of devices not leased from for this long are closed by
+        /// maintain(), and these devices get no spares
+        std::chrono::milliseconds idle_timeout = std::chrono::minutes(5);
+
+        /// If not zero, a background thread calls maintain() this often
+        std::chrono::milliseconds maintenance_interval{0};
+
+        /// The time limits of the connections of the pool
+        timeouts limits;
+    };
+
+    /**
+     * \brief Keeps logged in connections to devices for reuse
+     *
+     * Creating an \ref api_handler costs a TCP handshake and a login round trip.
+     * A connection pool keeps the connections after use, keyed by the device and
+     * credentials, so the next use of the same device gets an already logged in
+     * connection.
+     *
+     * Connections are leased with acquire(), and returned to the pool when the
+     * \ref lease is destroyed. A connection is not returned, but closed, if the
+     * lease was discarded, if it is destroyed by an exception, if not all of the
+     * sent sentences were written, or if not all of their replies were read, so the
+     * next holder never reads replies to someone else's sentences. Connections idle
+     * for longer than
+     * \ref pool_options::validate_after are checked with a `/system/identity/print`
+     * command before being leased again, and replaced if they are broken.
+     *
+     * \code
+     * mt::connection_pool pool;
+     * {
+     *     auto api = pool.acquire("10.0.0.1", "admin", "");
+     *     api->send("system"_cmd / "resource" / "print");
+     *     auto rep = api->read();
+     * } // returned to the pool
+     * auto again = pool.acquire("10.0.0.1", "admin", ""); // no connecting or logging in
+     * \endcode
+     *
+     * maintain() closes the connections of devices not used for long, checks
+     * long idle connections, and connects warm spares to recently used devices.
+     * It can be called periodically, or from a background thread of the pool,
+     * see \ref pool_options::maintenance_interval.
+     *
+     * The pool may be used from any amount of threads at once, while a lease is
+     * only to be used by one of them at a time. The pool must outlive its leases.
+     *
+     * \since v1.2.0
+     */
+    struct MIKROTIK_API_EXPORT connection_pool {
+    private:
+        struct device;
+
+    public:
+        /**
+         * \brief A connection leased from the pool
+         *
+         * Behaves like a pointer to the \ref api_handler. Returns the connection to
+         * the pool when destroyed.
+         *
+         * \since v1.2.0
+         */
+        struct MIKROTIK_API_EXPORT lease {
+            lease(lease&& mv) noexcept;
+            lease& operator=(lease&& mv) noexcept;
+            lease(const lease&) = delete;
+            lease& operator=(const lease&) = delete;
+
+            /**
+             * \brief Returns the connection to the pool
+             *
+             * \since v1.2.0
+             */
+            ~lease() noexcept;
+
+            /**
+             * \brief The leased connection
+             *
+             * \return The logged in connection
+             *
+             * \since v1.2.0
+             */
+            api_handler& operator*() const noexcept;
+
+            /// \copydoc operator*()
+            api_handler* operator->() const noexcept;
+
+            /**
+             * \brief Closes the connection instead of returning it to the pool
+             *
+             * To be called if the connection was broken, or left in a state which
+             * should not be passed on, like with unread replies.
+             * The lease is empty afterwards.
+             *
+             * \since v1.2.0
+             */
+            void discard() noexcept;
+
+        private:
+            friend connection_pool;
+            lease(connection_pool& pool, device& dev, std::unique_ptr<api_handler> api) noexcept;
+
+            void release() noexcept;
+
+            connection_pool* _pool;
+            device* _dev;
+            std::unique_ptr<api_handler> _api;
+            int _exceptions;
+        };
+
+        /**
+         * \brief Creates an empty pool
+         *
+         * \param opts The settings of the pool
+         *
+         * \since v1.2.0
+         */
+        explicit connection_pool(pool_options opts = {});
+
+        connection_pool(const connection_pool&) = delete;
+        connection_pool& operator=(const connection_pool&) = delete;
+
+        /**
+         * \brief Stops the background thread and closes the idle connections
+         *
+         * \since v1.2.0
+         */
+        ~connection_pool() noexcept;
+
+        /**
+         * \brief Leases a logged in connection to a device
+         *
+         * Returns the most recently returned idle connection of the device, checking
+         * it first if it has been idle for long. If there is none, a new connection is
+         * created, or if the device has \ref pool_options::max_per_device connections
+         * already, waits until one is returned.
+         *
+         * \param address The IPv4 address of the device
+         * \param user The username to log in as
+         * \param pass The password of the user
+         * \param port The port of the API service on the device
+         * \return The leased connection
+         *
+         * \throw bad_socket: If a new connection could not be created.
+         * \throw socket_timeout: If connecting or logging in took longer than allowed.
+         *
+         * \since v1.2.0
+         */
+        lease acquire(ip_address address,
+                      std::string_view user = "admin",
+                      std::string_view pass = "",
+                      std::uint16_t port = 8728);
+
+        /**
+         * \brief Closes and checks idle connections, and connects warm spares
+         *
+         * Closes the idle connections of devices not leased from for
+         * \ref pool_options::idle_timeout, and forgets those devices once none of
+         * their connections are leased. Checks the connections idle for longer
+         * than \ref pool_options::validate_after, and connects new ones to recently
+         * used devices until they have \ref pool_options::warm_spares idle connections.
+         * Connections that fail are dropped silently.
+         *
+         * \since v1.2.0
+         */
+        void maintain();
+
+        /**
+         * \brief The amount of idle connections in the pool
+         *
+         * \return The amount of connections ready to be leased
+         *
+         * \since v1.2.0
+         */
+        std::size_t idle() const;
+
+        /**
+         * \brief The amount of connections leased
+         *
+         * \return The amount of leases alive
+         *
+         * \since v1.2.0
+         */
+        std::size_t leased() const;
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        std::unique_ptr<api_handler> connect(const device& dev) const;
+        bool alive(api_handler& api) const noexcept;
+        static bool dirty(const api_handler& api) noexcept;
+        void give_back(device& dev, std::unique_ptr<api_handler> api) noexcept;
+        void forget(device& dev) noexcept;
+        void run_maintenance() noexcept;
+
+        pool_options _opts;
+        mutable std::mutex _mutex;
+        std::condition_variable _returned;
+        std::unordered_map<std::string, std::unique_ptr<device>> _devices;
+
+        bool _stopping = false;
+        std::condition_variable _stop;
+        std::thread _maintenance;
+    };
+}
@@ -0,0 +1,282 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+#if !defined(__cpp_impl_coroutine) && !defined(__cpp_coroutines)
+#    error "mikrotik/api/event_loop.hpp requires C++20 coroutines"
+#endif
+
+// stdlib
+#include <chrono>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// project
+#include "impl/sockets.hpp"
+#include "task.hpp"
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    namespace impl {
+        template<class T>
+        task<void>
+        store_result(task<T> t, std::optional<T>& result, bool& done) {
+            result.emplace(co_await std::move(t));
+            done = true;
+        }
+
+        inline task<void>
+        store_result(task<void> t, bool& done) {
+            co_await std::move(t);
+            done = true;
+        }
+    }
+
+    /**
+     * \brief A single threaded scheduler for the coroutine interface
+     *
+     * Runs coroutines, and resumes them when the sockets they are waiting
+     * on become ready. All coroutines of an event loop are run on the
+     * thread calling run(), one at a time, so they need no synchronization
+     * between each other.
+     *
+     * \code
+     * mt::event_loop loop;
+     * for (const auto& ip : routers) {
+     *     loop.spawn(poll_router(loop, ip)); // mt::task<void> poll_router(mt::event_loop&, mt::ip_address)
+     * }
+     * loop.run(); // returns when all routers were polled
+     * \endcode
+     *
+     * \since v1.2.0
+     */
+    struct MIKROTIK_API_EXPORT event_loop {
+        /// The clock of the deadlines of waiting for sockets
+        using clock = std::chrono::steady_clock;
+
+        /**
+         * \brief An awaitable suspending the coroutine until a socket is ready
+         *
+         * Awaiting it results in whether the socket became ready, or false if the
+         * deadline passed first.
+         *
+         * \since v1.2.0
+         */
+        struct io_awaiter {
+            event_loop& loop;           ///< The loop to wait in
+            impl::socket::handle sock;  ///< The socket to wait for
+            short events;               ///< The poll events to wait for
+            clock::time_point deadline; ///< The time to stop waiting at
+            bool ready = true;          ///< Whether the socket became ready in time
+
+            /// \cond
+            bool await_ready() noexcept {
+                return false;
+            }
+            void await_suspend(std::coroutine_handle<> coro) {
+                loop._waiters.push_back({sock, events, deadline, &ready, coro});
+            }
+            bool await_resume() noexcept {
+                return ready;
+            }
+            /// \endcond
+        };
+
+        /**
+         * \brief Creates an empty event loop
+         *
+         * On WinSock this initializes the socket library.
+         *
+         * \since v1.2.0
+         */
+        event_loop();
+
+        event_loop(const event_loop&) = delete;
+        event_loop& operator=(const event_loop&) = delete;
+
+        /**
+         * \brief Destroys all coroutines not yet finished
+         *
+         * \since v1.2.0
+         */
+        ~event_loop() noexcept;
+
+        /**
+         * \brief Schedules a task to run on the loop
+         *
+         * The task is owned by the loop, and will start running during the next call
+         * to run(). If the task exits with an exception, it will be rethrown
+         * from the run() call it happened during.
+         *
+         * \param t The task to run
+         *
+         * \since v1.2.0
+         */
+        void spawn(task<void> t);
+
+        /**
+         * \brief Runs the loop until all tasks finish
+         *
+         * \throw Any exception that escapes a spawned task.
+         * \throw bad_socket: If waiting on the sockets failed.
+         *
+         * \since v1.2.0
+         */
+        void run();
+
+        /**
+         * \brief Runs the loop until the given task finishes
+         *
+         * Other tasks spawned on the loop run in the meantime, but
+         * the loop returns as soon as the given task finishes, leaving
+         * unfinished tasks suspended until the next call to run().
+         *
+         * \tparam T The result type of the task
+         * \param t The task to run
+         * \return The result of the task
+         *
+         * \throw Any exception that escapes the given, or another spawned task.
+         * \throw std::logic_error: If the task is waiting for something that
+         *  cannot happen anymore, because no other task, or socket is left to wait on.
+         *
+         * \since v1.2.0
+         */
+        template<class T>
+        T run(task<T> t);
+
+        /**
+         * \brief Suspends the calling coroutine until the socket is readable
+         *
+         * \param sock The socket to wait for
+         * \param deadline The time to stop waiting at, if the socket is not readable
+         *  by then. Waits forever by default
+         * \return The awaitable to `co_await`, resulting in whether the socket
+         *  became readable before the deadline
+         *
+         * \since v1.2.0
+         */
+        io_awaiter readable(impl::socket::handle sock,
+                            clock::time_point deadline = clock::time_point::max()) noexcept {
+            return {*this, sock, POLLIN, deadline};
+        }
+
+        /**
+         * \brief Suspends the calling coroutine until the socket is writable
+         *
+         * \param sock The socket to wait for
+         * \param deadline The time to stop waiting at, if the socket is not writable
+         *  by then. Waits forever by default
+         * \return The awaitable to `co_await`, resulting in whether the socket
+         *  became writable before the deadline
+         *
+         * \since v1.2.0
+         */
+        io_awaiter writable(impl::socket::handle sock,
+                            clock::time_point deadline = clock::time_point::max()) noexcept {
+            return {*this, sock, POLLOUT, deadline};
+        }
+
+        /**
+         * \brief Suspends the calling coroutine to let other coroutines run
+         *
+         * \return The awaitable to `co_await`
+         *
+         * \since v1.2.0
+         */
+        auto yield() noexcept {
+            struct awaiter {
+                event_loop& loop;
+
+                bool await_ready() noexcept {
+                    return false;
+                }
+                void await_suspend(std::coroutine_handle<> coro) {
+                    loop.post(coro);
+                }
+                void await_resume() noexcept { }
+            };
+            return awaiter{*this};
+        }
+
+        /**
+         * \brief Schedules a suspended coroutine to be resumed by the loop
+         *
+         * \param coro The coroutine to resume
+         *
+         * \since v1.2.0
+         */
+        void post(std::coroutine_handle<> coro);
+
+    private:
+        struct waiter {
+            impl::socket::handle sock;
+            short events;
+            clock::time_point deadline;
+            bool* ready;
+            std::coroutine_handle<> coro;
+        };
+
+        struct detached;
+        static detached detach(event_loop& loop, task<void> t);
+
+        void run_until(const bool* done);
+        bool run_once();
+
+        std::deque<std::coroutine_handle<>> _ready;
+        std::vector<waiter> _waiters;
+        std::vector<pollfd> _fds;
+        std::vector<std::coroutine_handle<>> _roots;
+        std::exception_ptr _error;
+    };
+
+    template<class T>
+    T
+    event_loop::run(task<T> t) {
+        bool done = false;
+        if constexpr (std::is_void_v<T>) {
+            spawn(impl::store_result(std::move(t), done));
+            run_until(&done);
+        } else {
+            std::optional<T> result;
+            spawn(impl::store_result(std::move(t), result, done));
+            run_until(&done);
+            return std::move(*result);
+        }
+    }
+}
@@ -0,0 +1,81 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <exception>
+#include <string>
+#include <string_view>
+
+// project
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    /**
+     * \brief Exception describing a command the device refused to execute
+     *
+     * Thrown by the interfaces that do not return the `!trap` reply sentences
+     * themselves, like row-by-row reading of a reply, if the device replies
+     * with a `!trap`. Contains the message sent by the device in the `message`
+     * attribute of the `!trap`.
+     *
+     * \since v1.2.0
+     */
+    struct MIKROTIK_API_EXPORT bad_command : std::exception {
+        /**
+         * Creates a bad_command exception with the message sent by the device.
+         *
+         * \param message The reason of the failure as sent by the device
+         *
+         * \since v1.2.0
+         */
+        explicit bad_command(std::string_view message = "unknown error");
+
+        /**
+         * \copydoc bad_ip_format::what()
+         */
+        const char* what() const noexcept override;
+
+        /**
+         * Returns the message sent by the device
+         * \return The reason of the failure as sent by the device
+         * \since v1.2.0
+         */
+        const std::string& message() const noexcept;
+
+    private:
+        std::string _message;
+        std::string _what;
+    };
+}
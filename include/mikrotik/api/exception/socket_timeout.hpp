@@ -0,0 +1,87 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <chrono>
+#include <string>
+#include <string_view>
+
+// project
+#include "bad_socket.hpp"
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    /**
+     * \brief Exception describing an operation exceeding its time limit
+     *
+     * Thrown by \ref api_handler if connecting, logging in, sending, or
+     * reading takes longer than allowed by its \ref timeouts. It is a
+     * \ref bad_socket, so code handling broken connections handles timeouts
+     * too, but can be caught separately to tell a dead or stalled device
+     * apart from other failures.
+     *
+     * \since v1.2.0
+     */
+    struct MIKROTIK_API_EXPORT socket_timeout : bad_socket {
+        /**
+         * Creates a socket_timeout exception for the operation which took
+         * too long.
+         *
+         * \param operation The operation which timed out
+         * \param limit The time limit of the operation
+         *
+         * \since v1.2.0
+         */
+        socket_timeout(std::string_view operation, std::chrono::milliseconds limit);
+
+        /**
+         * Returns the operation which took too long
+         * \return The description of the operation
+         * \since v1.2.0
+         */
+        const std::string& operation() const noexcept;
+
+        /**
+         * Returns the time limit exceeded
+         * \return The time limit of the operation
+         * \since v1.2.0
+         */
+        std::chrono::milliseconds limit() const noexcept;
+
+    private:
+        std::string _operation;
+        std::chrono::milliseconds _limit;
+    };
+}
@@ -0,0 +1,218 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// project
+#include "backoff.hpp"
+#include "ip_address.hpp"
+#include "reply.hpp"
+#include "sentence.hpp"
+#include "shared_connection.hpp"
+#include "timeouts.hpp"
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    /**
+     * \brief The settings of a \ref hedged_handler
+     *
+     * \since v1.2.0
+     */
+    struct hedging_options {
+        /// The percentile of the recent latencies of a command after which a duplicate
+        /// is sent on the other connection
+        double hedge_percentile = 0.95;
+
+        /// The delay before sending a duplicate, while a command has fewer than
+        /// `min_samples` recorded latencies
+        std::chrono::milliseconds initial_hedge_delay{100};
+
+        /// The amount of recorded latencies required before using their percentile
+        std::size_t min_samples = 20;
+
+        /// The amount of the most recent latencies recorded per command
+        std::size_t window = 256;
+
+        /// The most duplicates sent per idempotent sentence executed, in the long run.
+        /// Bursts of up to 10 duplicates are allowed above that
+        double hedge_ratio = 0.1;
+
+        /// The delays between retrying failed idempotent sentences, and the amount of
+        /// tries of commands not in `attempts`
+        backoff retry{std::chrono::milliseconds(10), std::chrono::seconds(1), 2.0, 2};
+
+        /// The amount of tries of idempotent commands, overriding `retry.attempts`, keyed by
+        /// the command word, like `/interface/print`
+        std::map<std::string, std::size_t, std::less<>> attempts;
+
+        /// The time limits of connecting and logging in
+        timeouts limits;
+    };
+
+    /**
+     * \brief Cuts the tail latency of reading commands by sending them twice
+     *
+     * Devices under load answer most commands quickly, but some of them very late,
+     * and anything waiting for many of them waits for the slowest. A hedged handler
+     * keeps two \ref shared_connection "shared_connections" to the device. Idempotent
+     * sentences, as classified by \ref is_idempotent, are sent on one of them, and if
+     * they are not answered by the time 95% of the recent ones of the same command
+     * were, a duplicate is sent on the other connection; whichever is answered first
+     * is returned, the late answer is dropped. So only about 5% of the reads are sent
+     * twice, and the duplicates are further limited by
+     * \ref hedging_options::hedge_ratio.
+     *
+     * Idempotent sentences failing with a \ref bad_socket are retried on new
+     * connections, as many times as allowed for their command. Mutating sentences
+     * are sent once, on one connection, and neither duplicated nor retried.
+     *
+     * \code
+     * mt::hedging_options opts;
+     * opts.attempts["/interface/print"] = 3;
+     * mt::hedged_handler api("10.0.0.1", "admin", "", 8728, opts);
+     * auto replies = api.execute("interface"_cmd / "print");
+     * \endcode
+     *
+     * A hedged handler must not be used from more than one thread at once.
+     *
+     * \since v1.2.0
+     */
+    struct MIKROTIK_API_EXPORT hedged_handler {
+        /**
+         * \brief Connects to the device twice, and logs in on both connections
+         *
+         * \param address The IPv4 address of the MikroTik device to connect to
+         * \param user The username to log in as
+         * \param pass The password of the provided user
+         * \param port The port of the API service on the device
+         * \param opts The settings of hedging and retrying
+         *
+         * \throw bad_socket: If connecting or logging in failed.
+         *
+         * \since v1.2.0
+         */
+        explicit hedged_handler(ip_address address,
+                                std::string_view user = "admin",
+                                std::string_view pass = "",
+                                std::uint16_t port = 8728,
+                                const hedging_options& opts = {});
+
+        hedged_handler(const hedged_handler&) = delete;
+        hedged_handler& operator=(const hedged_handler&) = delete;
+
+        /**
+         * \brief Closes the connections
+         *
+         * \since v1.2.0
+         */
+        ~hedged_handler() noexcept;
+
+        /**
+         * \brief Sends a sentence, and waits for all of its replies
+         *
+         * \param snt The sentence to send
+         * \return All replies to the sentence, the last being the `!done` reply
+         *
+         * \throw bad_socket: If a mutating sentence failed, or an idempotent one
+         *  failed as many times as allowed.
+         *
+         * \since v1.2.0
+         */
+        std::vector<reply> execute(const sentence& snt);
+
+        /**
+         * \brief Returns how long the sentence would wait before being duplicated
+         *
+         * \param snt The sentence to check, only its command word matters
+         * \return The current hedging delay of the command
+         *
+         * \since v1.2.0
+         */
+        std::chrono::microseconds hedge_delay(const sentence& snt) const;
+
+        /**
+         * \brief Returns the amount of duplicates sent so far
+         *
+         * \return The amount of sentences sent on both connections
+         *
+         * \since v1.2.0
+         */
+        std::size_t hedges() const noexcept;
+
+        /**
+         * \brief Returns the amount of retries so far
+         *
+         * \return The amount of times a failed sentence was sent again
+         *
+         * \since v1.2.0
+         */
+        std::size_t retries() const noexcept;
+
+    private:
+        struct race;
+        struct command_stats;
+
+        shared_connection& connection(std::size_t idx);
+        command_stats& stats_of(std::string_view command);
+        std::vector<reply> hedge(const sentence& snt, command_stats& stats);
+        std::chrono::microseconds delay_of(const command_stats& stats) const;
+        std::size_t pick() noexcept;
+        bool take_hedge() noexcept;
+
+        ip_address _address;
+        std::string _user;
+        std::string _pass;
+        std::uint16_t _port;
+        hedging_options _opts;
+        std::unique_ptr<shared_connection> _conns[2];
+        std::unordered_map<std::string, std::unique_ptr<command_stats>> _stats;
+        std::size_t _next = 0;
+        double _hedge_tokens;
+        std::size_t _hedges = 0;
+        std::size_t _retries = 0;
+        std::mt19937 _rng;
+    };
+}
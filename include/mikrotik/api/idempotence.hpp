@@ -0,0 +1,71 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// project
+#include "sentence.hpp"
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    /**
+     * \brief Checks whether a sentence only reads the state of the device
+     *
+     * A sentence is idempotent if sending it again has no further effect on the
+     * device, so it can safely be resent if the connection broke before its reply
+     * arrived, even if the device has already executed it. These are the sentences
+     * that read state, and complete on their own:
+     *
+     *  - `print`, except with the `follow`, `follow-only` or `interval` attributes,
+     *    which keep sending replies until cancelled,
+     *  - `get` and `getall`,
+     *  - `monitor`, and commands like `monitor-traffic`, with the `once` attribute.
+     *
+     * Every other sentence, like `add`, `set`, `remove`, or scripts, is
+     * considered mutating.
+     *
+     * \code
+     * mt::is_idempotent("interface"_cmd / "print");              // true
+     * mt::is_idempotent(("interface"_cmd / "monitor-traffic")
+     *                        [{"interface", "ether1"}, {"once", ""}]); // true
+     * mt::is_idempotent("interface"_cmd / "set");                // false
+     * \endcode
+     *
+     * \param snt The sentence to classify
+     * \return Whether the sentence is idempotent
+     *
+     * \since v1.2.0
+     */
+    MIKROTIK_API_EXPORT
+    bool is_idempotent(const sentence& snt) noexcept;
+}
@@ -0,0 +1,167 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace mikrotik::api::impl {
+    /// The most bytes a length prefix takes up
+    inline constexpr const std::size_t max_length_size = 5;
+    /// The length of the longest word a length prefix can describe
+    inline constexpr const std::size_t max_word_length = 0xFFFF'FFFF;
+    /// Returned by decode_length() for prefixes starting with a reserved control byte
+    inline constexpr const std::size_t bad_length = static_cast<std::size_t>(-1);
+
+    // the size of the prefix by the top 5 bits of its first byte, 0 marks the
+    // reserved control bytes 0xF8-0xFF
+    inline constexpr const std::uint8_t length_sizes[32] = {
+           1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+           2, 2, 2, 2, 2, 2, 2, 2,
+           3, 3, 3, 3,
+           4, 4,
+           5,
+           0};
+    // the bits of the prefix belonging to the length, by prefix size
+    inline constexpr const std::uint32_t length_masks[6] = {0, 0x7F, 0x3FFF, 0x1F'FFFF, 0xFFF'FFFF, 0xFFFF'FFFF};
+    // the size marker bits of the first byte, by prefix size
+    inline constexpr const std::uint8_t length_marks[6] = {0x00, 0x00, 0x80, 0xC0, 0xE0, 0xF0};
+
+    /**
+     * \brief The size of the length prefix of a word
+     *
+     * \param len The length of the word
+     * \return The amount of bytes the prefix takes up, or 0 if the word is
+     *  longer than max_word_length
+     *
+     * \since v1.2.0
+     */
+    constexpr std::size_t
+    length_size(std::size_t len) noexcept {
+        if (len > max_word_length)
+            return 0;
+        return std::size_t{1}
+               + (len >= 0x80)
+               + (len >= 0x4000)
+               + (len >= 0x20'0000)
+               + (len >= 0x1000'0000);
+    }
+
+    /**
+     * \brief Writes the length prefix of a word
+     *
+     * Lengths below 0x1000'0000 are written in 1-4 bytes, with the size
+     * marked in the high bits of the first byte. Longer lengths are written
+     * as 0xF0 followed by the length in 4 bytes.
+     *
+     * \param len The length of the word
+     * \param out The buffer to write to, must have room for max_length_size bytes,
+     *  even for shorter prefixes
+     * \return The size of the prefix, or 0 if the word is longer than
+     *  max_word_length, in which case nothing is written
+     *
+     * \since v1.2.0
+     */
+    constexpr std::size_t
+    encode_length(std::size_t len, char* out) noexcept {
+        auto size = length_size(len);
+        if (size == 0)
+            return 0;
+
+        // the 5 byte form does not store any of the length in its first byte,
+        // the others are written as 4 big-endian bytes with the marker in
+        // the top byte, shifted so the prefix starts at out
+        auto value = static_cast<std::uint32_t>(len);
+        if (size == max_length_size) {
+            *out++ = static_cast<char>(length_marks[size]);
+        } else {
+            value = (value << (32 - 8 * size)) | (std::uint32_t{length_marks[size]} << 24);
+        }
+        out[0] = static_cast<char>(value >> 24);
+        out[1] = static_cast<char>(value >> 16);
+        out[2] = static_cast<char>(value >> 8);
+        out[3] = static_cast<char>(value);
+        return size;
+    }
+
+    /**
+     * \brief The size of the length prefix starting with the given byte
+     *
+     * \param first The first byte of the prefix
+     * \return The amount of bytes the prefix takes up, or 0 if the byte is
+     *  a reserved control byte
+     *
+     * \since v1.2.0
+     */
+    constexpr std::size_t
+    decoded_size(char first) noexcept {
+        return length_sizes[static_cast<std::uint8_t>(first) >> 3];
+    }
+
+    /**
+     * \brief Reads the length prefix at the beginning of the data
+     *
+     * \param data The received bytes starting with a length prefix
+     * \param len Set to the decoded length, if the whole prefix is available
+     * \return The size of the prefix, or 0 if data does not contain all of it
+     *  yet, or bad_length if it starts with a reserved control byte
+     *
+     * \since v1.2.0
+     */
+    constexpr std::size_t
+    decode_length(std::string_view data, std::size_t& len) noexcept {
+        if (data.empty())
+            return 0;
+        auto size = decoded_size(data[0]);
+        if (size == 0)
+            return bad_length;
+        if (data.size() < size)
+            return 0;
+
+        // the length is big-endian, so shift in the bytes as they come, always
+        // 5 of them if available, then drop the ones after the prefix, and the
+        // size marker bits
+        auto read = data.size() < max_length_size ? size : max_length_size;
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < read; ++i) {
+            value = (value << 8) | static_cast<std::uint8_t>(data[i]);
+        }
+        value >>= 8 * (read - size);
+        value &= length_masks[size];
+        len = static_cast<std::size_t>(value);
+        return size;
+    }
+}
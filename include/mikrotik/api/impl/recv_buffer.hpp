@@ -0,0 +1,163 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace mikrotik::api::impl {
+    /**
+     * \brief A growable receive slab for buffering socket input
+     *
+     * Stores the bytes read from the socket, but not yet processed by the
+     * protocol decoding. Reads are done into the free space at the end of the
+     * buffer in as big chunks as possible, so multiple words, or even multiple
+     * sentences are available for decoding after a single call to ``recv``.
+     *
+     * Consumed bytes are only reclaimed when more space is required, by moving
+     * the unprocessed bytes to the front of the slab. If that is still not enough,
+     * the slab grows to fit the request.
+     *
+     * \since v1.2.0
+     */
+    struct recv_buffer {
+        /**
+         * \brief Creates a buffer with the given initial capacity
+         *
+         * \param capacity The amount of bytes the slab is allocated with
+         *
+         * \since v1.2.0
+         */
+        explicit recv_buffer(std::size_t capacity = 16 * 1024)
+             : _buf(capacity) { }
+
+        /**
+         * \brief The bytes received but not consumed yet
+         *
+         * \return A view of the buffered, unprocessed bytes
+         *
+         * \since v1.2.0
+         */
+        std::string_view data() const noexcept {
+            return {_buf.data() + _beg, _end - _beg};
+        }
+
+        /**
+         * \brief The amount of bytes received but not consumed yet
+         *
+         * \return The size of data()
+         *
+         * \since v1.2.0
+         */
+        std::size_t size() const noexcept {
+            return _end - _beg;
+        }
+
+        /**
+         * \brief Marks the first `n` buffered bytes as processed
+         *
+         * \param n The amount of bytes to drop from the front of data()
+         *
+         * \since v1.2.0
+         */
+        void consume(std::size_t n) noexcept {
+            _beg += n;
+            if (_beg == _end)
+                _beg = _end = 0;
+        }
+
+        /**
+         * \brief Makes room for at least `min_space` bytes to be written
+         *
+         * Compacts, and if required grows, the slab so that at least
+         * `min_space` bytes may be written after the buffered data.
+         * The returned pointer and space() remain valid until the next
+         * call to prepare() or commit().
+         *
+         * \param min_space The minimum amount of free bytes required
+         * \return The position the next received bytes should be written to
+         *
+         * \since v1.2.0
+         */
+        char* prepare(std::size_t min_space) {
+            if (_buf.size() - _end < min_space) {
+                auto len = size();
+                if (_beg != 0) {
+                    std::memmove(_buf.data(), _buf.data() + _beg, len);
+                    _beg = 0;
+                    _end = len;
+                }
+                if (_buf.size() - _end < min_space) {
+                    auto cap = std::max<std::size_t>(_buf.size() * 2, 64);
+                    while (cap - _end < min_space)
+                        cap *= 2;
+                    _buf.resize(cap);
+                }
+            }
+            return _buf.data() + _end;
+        }
+
+        /**
+         * \brief The amount of free bytes after the buffered data
+         *
+         * \return The amount of bytes that may be written to the pointer
+         *  returned by prepare()
+         *
+         * \since v1.2.0
+         */
+        std::size_t space() const noexcept {
+            return _buf.size() - _end;
+        }
+
+        /**
+         * \brief Marks `n` freshly written bytes as received
+         *
+         * \param n The amount of bytes written to the pointer returned by prepare()
+         *
+         * \since v1.2.0
+         */
+        void commit(std::size_t n) noexcept {
+            _end += n;
+        }
+
+    private:
+        std::vector<char> _buf;
+        std::size_t _beg = 0;
+        std::size_t _end = 0;
+    };
+}
@@ -0,0 +1,247 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory_resource>
+#include <type_traits>
+
+namespace mikrotik::api::impl {
+    /**
+     * \brief A growable array of trivial values with inline storage
+     *
+     * Stores up to `N` elements inside the object itself, and only allocates
+     * from its memory resource when more are needed. Elements are copied around
+     * as raw bytes, so only trivially copyable types may be stored.
+     *
+     * Copies use the same memory resource as the original, and moving the
+     * buffer moves the resource along with the storage allocated from it.
+     *
+     * \tparam T The type of the stored elements
+     * \tparam N The amount of elements stored without allocating
+     *
+     * \since v1.2.0
+     */
+    template<class T, std::size_t N>
+    struct small_buffer {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "small_buffer only stores trivially copyable types");
+
+        small_buffer() noexcept = default;
+
+        explicit small_buffer(std::pmr::memory_resource* resource) noexcept
+             : _resource(resource) { }
+
+        small_buffer(const small_buffer& cp)
+             : small_buffer(cp._resource) {
+            append(cp.data(), cp.size());
+        }
+
+        small_buffer(small_buffer&& mv) noexcept
+             : small_buffer(mv._resource) {
+            steal(mv);
+        }
+
+        small_buffer&
+        operator=(const small_buffer& cp) {
+            if (this != &cp) {
+                _size = 0;
+                append(cp.data(), cp.size());
+            }
+            return *this;
+        }
+
+        small_buffer&
+        operator=(small_buffer&& mv) noexcept {
+            if (this != &mv) {
+                release();
+                _resource = mv._resource;
+                steal(mv);
+            }
+            return *this;
+        }
+
+        ~small_buffer() noexcept {
+            release();
+        }
+
+        /**
+         * \brief The stored elements
+         *
+         * \return Pointer to the first element
+         *
+         * \since v1.2.0
+         */
+        T* data() noexcept {
+            return _heap ? _heap : _inline;
+        }
+
+        /// \copydoc data()
+        const T* data() const noexcept {
+            return _heap ? _heap : _inline;
+        }
+
+        /**
+         * \brief The amount of stored elements
+         *
+         * \return The amount of elements in data()
+         *
+         * \since v1.2.0
+         */
+        std::size_t size() const noexcept {
+            return _size;
+        }
+
+        /**
+         * \brief Whether the elements are stored inline
+         *
+         * \return False, if the buffer had to allocate storage
+         *
+         * \since v1.2.0
+         */
+        bool is_inline() const noexcept {
+            return _heap == nullptr;
+        }
+
+        /**
+         * \brief The memory resource used when the inline storage is not enough
+         *
+         * \return The memory resource of the buffer
+         *
+         * \since v1.2.0
+         */
+        std::pmr::memory_resource* resource() const noexcept {
+            return _resource;
+        }
+
+        /**
+         * \brief Grows the buffer by `n` uninitialized elements
+         *
+         * \param n The amount of elements to add
+         * \return Pointer to the first added element
+         *
+         * \since v1.2.0
+         */
+        T* grow(std::size_t n) {
+            reserve(_size + n);
+            auto ret = data() + _size;
+            _size += n;
+            return ret;
+        }
+
+        /**
+         * \brief Appends `n` elements to the end of the buffer
+         *
+         * \param src The elements to copy
+         * \param n The amount of elements to copy
+         *
+         * \since v1.2.0
+         */
+        void append(const T* src, std::size_t n) {
+            if (n != 0)
+                std::memcpy(grow(n), src, n * sizeof(T));
+        }
+
+        /**
+         * \brief Appends an element to the end of the buffer
+         *
+         * \param val The element to append
+         *
+         * \since v1.2.0
+         */
+        void push_back(const T& val) {
+            *grow(1) = val;
+        }
+
+        /**
+         * \brief Drops the last elements after the first `n`
+         *
+         * \param n The amount of elements to keep
+         *
+         * \since v1.2.0
+         */
+        void shrink(std::size_t n) noexcept {
+            _size = std::min(_size, n);
+        }
+
+        /**
+         * \brief Makes sure that `cap` elements fit without reallocating
+         *
+         * \param cap The minimum capacity required
+         *
+         * \since v1.2.0
+         */
+        void reserve(std::size_t cap) {
+            if (cap <= _cap)
+                return;
+            auto new_cap = std::max(cap, _cap * 2);
+            auto mem = static_cast<T*>(_resource->allocate(new_cap * sizeof(T), alignof(T)));
+            if (_size != 0)
+                std::memcpy(mem, data(), _size * sizeof(T));
+            release();
+            _heap = mem;
+            _cap = new_cap;
+        }
+
+    private:
+        void release() noexcept {
+            if (_heap)
+                _resource->deallocate(_heap, _cap * sizeof(T), alignof(T));
+            _heap = nullptr;
+            _cap = N;
+        }
+
+        void steal(small_buffer& mv) noexcept {
+            if (mv._heap) {
+                _heap = mv._heap;
+                _cap = mv._cap;
+                mv._heap = nullptr;
+                mv._cap = N;
+            } else if (mv._size != 0) {
+                std::memcpy(_inline, mv._inline, mv._size * sizeof(T));
+            }
+            _size = mv._size;
+            mv._size = 0;
+        }
+
+        std::pmr::memory_resource* _resource = std::pmr::get_default_resource();
+        T* _heap = nullptr;
+        std::size_t _size = 0;
+        std::size_t _cap = N;
+        T _inline[N];
+    };
+}
@@ -48,12 +48,16 @@
 #else// Assume POSIX sockets otherwise
 #    include <arpa/inet.h>
 #    include <netdb.h>
+#    include <poll.h>
 #    include <sys/socket.h>
 #    include <sys/types.h>
 #    include <unistd.h>
 
 #endif
 
+// stdlib
+#include <cstddef>
+
 namespace mikrotik::api::impl::socket {
 #ifdef _WIN32
     using handle = decltype(INVALID_SOCKET);
@@ -62,4 +66,14 @@ namespace mikrotik::api::impl::socket {
 #    define INVALID_SOCKET -1
 #    define SOCKET_ERROR -1
 #endif
+
+    /**
+     * \brief A piece of memory to be sent as part of a gathered write
+     *
+     * \since v1.2.0
+     */
+    struct buffer {
+        const char* data; ///< The beginning of the bytes to send
+        std::size_t size; ///< The amount of bytes to send
+    };
 }
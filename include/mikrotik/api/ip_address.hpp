@@ -34,6 +34,7 @@
 #pragma once
 
 // stdlib
+#include <charconv>
 #include <cstdint>
 #include <string_view>
 #include <array>
@@ -100,6 +101,22 @@ namespace mikrotik::api {
          */
         std::string render(int port = 0) const;
 
+        /**
+         * \brief Writes the stored ip address into a character buffer
+         *
+         * Writes the address in the form `<a>.<b>.<c>.<d>` like render()
+         * does, but without allocating. Works like `std::to_chars`: if the
+         * address does not fit into `[first, last)`, the returned error
+         * is `std::errc::value_too_large`. At most 15 characters are written.
+         *
+         * \param first The beginning of the buffer to write to
+         * \param last The end of the buffer to write to
+         * \return The end of the written characters and the error, if any
+         *
+         * \since v1.2.0
+         */
+        std::to_chars_result to_chars(char* first, char* last) const noexcept;
+
         std::array<std::uint8_t, 4> _bytes; ///< The four bytes of the IPv4 address
     };
 }
@@ -0,0 +1,198 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+// project
+#include "api_handler.hpp"
+#include "prepared_sentence.hpp"
+#include "reply.hpp"
+#include "sentence.hpp"
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    /**
+     * \brief Allows multiple sentences in flight on one connection
+     *
+     * The MikroTik API allows tagging sentences with the `.tag` API attribute
+     * word, in which case the device tags every reply sentence it sends as a
+     * response to it with the same tag. This way more sentences can be sent
+     * before reading their replies, and the replies can still be matched to their
+     * respective sentences.
+     *
+     * A pipeline wraps an \ref api_handler, and does all of this: submit()
+     * sends the sentence with a newly generated tag and returns that tag. Then
+     * read() returns the next reply to the sentence with the given tag. Replies
+     * to other sentences read in the meantime are stored until they are asked for.
+     *
+     * \code
+     * mt::pipeline pipe(api);
+     * auto ident = pipe.submit("system"_cmd / "identity" / "print");
+     * auto res = pipe.submit("system"_cmd / "resource" / "print");
+     *
+     * auto res_replies = pipe.collect(res);     // the order of reading does not
+     * auto ident_replies = pipe.collect(ident); // need to match the order of sending
+     * \endcode
+     *
+     * The replies returned do not contain the `.tag` word.
+     *
+     * \rst
+     * .. warning::
+     *  While a pipeline is in use, do not use the api_handler directly to
+     *  send or read sentences, as the replies it reads will not be seen by the pipeline.
+     * \endrst
+     *
+     * \since v1.2.0
+     */
+    struct MIKROTIK_API_EXPORT pipeline {
+        /**
+         * \brief The type of the tags used to identify sentences in flight
+         *
+         * \since v1.2.0
+         */
+        using tag_type = std::uint32_t;
+
+        /**
+         * \brief Creates a pipeline over an already connected api_handler
+         *
+         * The api_handler must outlive the pipeline.
+         *
+         * \param api The connection to send and read sentences through
+         *
+         * \since v1.2.0
+         */
+        explicit pipeline(api_handler& api);
+
+        /**
+         * \brief Sends a sentence without waiting for its replies
+         *
+         * Sends the sentence with a `.tag` API attribute word appended to it.
+         * The sentence must not contain a `.tag` word already.
+         *
+         * \param snt The sentence to send
+         * \return The tag identifying the sentence, to be passed to read()
+         *
+         * \throw bad_socket: If the sentence could not be sent. The sentence is not
+         *  in flight then.
+         *
+         * \since v1.2.0
+         */
+        tag_type submit(const sentence& snt);
+
+        /**
+         * \brief Sends a prepared sentence without waiting for its replies
+         *
+         * Sends the sentence with the values currently bound to its slots,
+         * and a `.tag` API attribute word appended to it.
+         *
+         * \param snt The prepared sentence to send
+         * \return The tag identifying the sentence, to be passed to read()
+         *
+         * \throw bad_socket: If the sentence could not be sent. The sentence is not
+         *  in flight then.
+         *
+         * \since v1.2.0
+         */
+        tag_type submit(const prepared_sentence& snt);
+
+        /**
+         * \brief Reads the next reply to a sentence submitted earlier
+         *
+         * If a reply to the sentence with the given tag has already been
+         * read, it is returned immediately, otherwise replies are read
+         * from the connection until one arrives for the given sentence.
+         * Replies to other sentences read meanwhile are stored for later.
+         *
+         * After the `!done` reply was returned for a tag, the tag is forgotten
+         * and must not be read anymore.
+         *
+         * A `!fatal` reply is not tagged by the device: as it terminates the
+         * connection, it is returned to whichever tag is being read, and all
+         * outstanding sentences are forgotten. Other untagged replies are skipped.
+         *
+         * \param tag The tag returned by submit() for the sentence
+         * \return The next reply to the sentence
+         *
+         * \throw bad_socket: If the data could not be read, or the given tag
+         *  is not in flight.
+         *
+         * \since v1.2.0
+         */
+        reply read(tag_type tag);
+
+        /**
+         * \brief Reads all replies to a sentence submitted earlier
+         *
+         * Reads replies to the sentence with the given tag until its `!done`
+         * reply, or a `!fatal` reply arrives.
+         *
+         * \param tag The tag returned by submit() for the sentence
+         * \return All replies of the sentence, the last being `!done` or `!fatal`
+         *
+         * \throw bad_socket: If the data could not be read, or the given tag
+         *  is not in flight.
+         *
+         * \since v1.2.0
+         */
+        std::vector<reply> collect(tag_type tag);
+
+        /**
+         * \brief The amount of sentences whose replies were not yet all read
+         *
+         * \return The amount of sentences in flight
+         *
+         * \since v1.2.0
+         */
+        std::size_t in_flight() const noexcept;
+
+    private:
+        struct request {
+            std::deque<reply> replies;
+        };
+
+        template<class Sentence>
+        tag_type submit_tagged(const Sentence& snt);
+        std::optional<reply> read_one();
+
+        api_handler& _api;
+        tag_type _next_tag = 1;
+        std::unordered_map<tag_type, request> _requests;
+    };
+}
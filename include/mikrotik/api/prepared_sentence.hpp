@@ -0,0 +1,167 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// project
+#include "impl/length_codec.hpp"
+#include "impl/sockets.hpp"
+#include "sentence.hpp"
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    /**
+     * \brief A sentence encoded once, with attribute values to fill in before sending
+     *
+     * When the same kind of sentence is sent many times with only some
+     * attribute values changing, building a new \ref sentence every time
+     * formats and encodes all of its words again. A prepared sentence instead
+     * encodes the constant words once, and keeps a slot for every changing
+     * attribute. Binding a value only updates the bytes of its slot, and
+     * sending writes the encoded bytes as they are.
+     *
+     * \code
+     * mt::prepared_sentence add(("ip"_cmd / "firewall" / "address-list" / "add")[{"list", "blocked"}],
+     *                           {"address", "comment"});
+     * for (const auto& [address, comment] : entries) {
+     *     add.bind("address", address)
+     *        .bind("comment", comment);
+     *     api.send(add);
+     *     api.read();
+     * }
+     * \endcode
+     *
+     * The slots are sent as attribute words after the words of the constant sentence.
+     * A slot that was never bound is sent with an empty value. The storage of a slot
+     * is reused, so after the first few values binding does not allocate.
+     *
+     * \since v1.2.0
+     */
+    struct MIKROTIK_API_EXPORT prepared_sentence {
+        /**
+         * \brief Encodes a sentence, and adds attribute slots to it
+         *
+         * \param constant The words that are the same every time
+         * \param slots The names of the attributes to fill in before sending
+         *
+         * \throw bad_word: If a word of the sentence is too long to be sent.
+         *
+         * \since v1.2.0
+         */
+        prepared_sentence(const sentence& constant, std::initializer_list<std::string_view> slots);
+
+        /**
+         * \brief Returns the index of a slot
+         *
+         * Binding by index saves looking up the name every time.
+         *
+         * \param name The name of the attribute of the slot
+         * \return The index of the slot
+         *
+         * \throw bad_word: If there is no slot with the given name.
+         *
+         * \since v1.2.0
+         */
+        std::size_t slot(std::string_view name) const;
+
+        /**
+         * \brief Sets the value of a slot
+         *
+         * \param slot The index of the slot
+         * \param value The value of the attribute
+         * \return This prepared sentence
+         *
+         * \throw bad_word: If the word becomes too long to be sent.
+         * \throw std::out_of_range: If there is no slot with the given index.
+         *
+         * \since v1.2.0
+         */
+        prepared_sentence& bind(std::size_t slot, std::string_view value);
+
+        /**
+         * \brief Sets the value of a slot
+         *
+         * \param name The name of the attribute of the slot
+         * \param value The value of the attribute
+         * \return This prepared sentence
+         *
+         * \throw bad_word: If there is no slot with the given name, or the
+         *  word becomes too long to be sent.
+         *
+         * \since v1.2.0
+         */
+        prepared_sentence& bind(std::string_view name, std::string_view value);
+
+        /**
+         * \brief Returns the amount of slots
+         *
+         * \return The amount of slots
+         *
+         * \since v1.2.0
+         */
+        std::size_t slots() const noexcept;
+
+        /**
+         * \brief Returns the current words of the sentence
+         *
+         * Creates a regular sentence with the values bound currently.
+         *
+         * \return The sentence that would be sent
+         *
+         * \since v1.2.0
+         */
+        sentence to_sentence() const;
+
+    private:
+        friend struct protocol;
+
+        struct slot_data {
+            std::size_t name_size;
+            std::string word;
+            char prefix[impl::max_length_size];
+            std::size_t prefix_size;
+        };
+
+        void gather(std::vector<impl::socket::buffer>& out) const;
+
+        sentence _constant;
+        std::vector<slot_data> _slots;
+    };
+}
@@ -0,0 +1,356 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// project
+#include "impl/recv_buffer.hpp"
+#include "impl/sockets.hpp"
+#include "reply_view.hpp"
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    struct sentence;
+    struct prepared_sentence;
+
+    /**
+     * \brief The MikroTik API protocol without any I/O
+     *
+     * Implements the framing of words and sentences, the classification of the
+     * reply sentences, and the login handshake as a state machine, which never
+     * touches a socket. The bytes received from the device, however they were
+     * received, are fed into it, and it produces events; and sentences sent through
+     * it become buffers which are to be written to the device by the caller.
+     * This way the protocol can be driven by any event loop, io_uring, or by
+     * nothing at all in tests, fuzzers and benchmarks.
+     *
+     * \ref api_handler is a blocking driver over a protocol.
+     *
+     * \code
+     * mt::protocol proto;
+     * proto.login("admin", "");
+     * auto out = proto.next_output();
+     * writev_all(sock, out.bufs, out.count);
+     * proto.consume_output(out.size());
+     *
+     * for (;;) {
+     *     auto ev = proto.next_event();
+     *     if (ev == mt::protocol::need_input) {
+     *         auto buf = proto.prepare_input(proto.needed());
+     *         proto.commit_input(recv(sock, buf, proto.input_space(), 0));
+     *     } else if (ev == mt::protocol::logged_in) {
+     *         break;
+     *     }
+     * }
+     * \endcode
+     *
+     * \since v1.2.0
+     */
+    struct MIKROTIK_API_EXPORT protocol {
+        /**
+         * \brief The events produced from the received bytes
+         *
+         * \since v1.2.0
+         */
+        enum event {
+            need_input, ///< More bytes are required to continue, see needed()
+            logged_in,  ///< The device accepted the login
+            received    ///< A reply sentence was received, see view()
+        };
+
+        /**
+         * \brief The buffers waiting to be written to the device
+         *
+         * A gather list to be written with a single vectored write, like
+         * `sendmsg`, or `writev`. The buffers point into the sentences sent, so
+         * their bytes are never copied on the way to the socket.
+         *
+         * \since v1.2.0
+         */
+        struct output {
+            const impl::socket::buffer* bufs; ///< The first buffer to write
+            std::size_t count;                ///< The amount of buffers to write
+
+            /**
+             * \brief Whether there is nothing to write
+             *
+             * \return True, if there are no buffers
+             *
+             * \since v1.2.0
+             */
+            bool empty() const noexcept {
+                return count == 0;
+            }
+
+            /**
+             * \brief The amount of bytes to write
+             *
+             * \return The total size of the buffers
+             *
+             * \since v1.2.0
+             */
+            std::size_t size() const noexcept {
+                std::size_t ret = 0;
+                for (std::size_t i = 0; i < count; ++i) {
+                    ret += bufs[i].size;
+                }
+                return ret;
+            }
+        };
+
+        /**
+         * \brief Starts the login handshake
+         *
+         * Queues the `/login` sentence with the credentials for sending. Unlike other
+         * sentences, it is stored in the protocol until it is written. The reply to
+         * it is not reported as received, but next_event() returns logged_in if the
+         * device accepted the login.
+         *
+         * \param user The username to log in as
+         * \param pass The password of the user
+         *
+         * \since v1.2.0
+         */
+        void login(std::string_view user, std::string_view pass);
+
+        /**
+         * \brief Whether the login handshake finished successfully
+         *
+         * \return True, if the device accepted the login
+         *
+         * \since v1.2.0
+         */
+        bool is_logged_in() const noexcept;
+
+        /**
+         * \brief Queues a sentence for sending
+         *
+         * The words of the sentence are not copied, the buffers of next_output()
+         * point into it, so it must not be changed or destroyed until all of its
+         * bytes are consumed with consume_output(). The API attribute word is
+         * copied, however.
+         *
+         * \param snt The sentence to send
+         * \param api_attr An API attribute word, like `.tag=1`, to append to the
+         *  sentence, or empty
+         *
+         * \throw bad_word: If the API attribute word is too long to be sent.
+         *
+         * \since v1.2.0
+         */
+        void send(const sentence& snt, std::string_view api_attr = {});
+
+        /// \copydoc send(const sentence&, std::string_view)
+        void send(const prepared_sentence& snt, std::string_view api_attr = {});
+
+        /**
+         * \brief Queues already encoded bytes for sending
+         *
+         * The bytes must be one or more complete sentences, like a
+         * \ref static_command is. They are not copied, so they must stay valid
+         * until they are consumed with consume_output().
+         *
+         * \param bytes The encoded sentences
+         *
+         * \since v1.2.0
+         */
+        void send_encoded(std::string_view bytes);
+
+        /**
+         * \brief The buffers waiting to be written to the device
+         *
+         * \return The gather list of the queued bytes, valid until the next call
+         *  to a non-const member function. Empty, if there is nothing to write
+         *
+         * \since v1.2.0
+         */
+        output next_output() const noexcept;
+
+        /**
+         * \brief Marks the first `n` bytes of next_output() as written
+         *
+         * After a short write, the buffer written partially is adjusted to start
+         * at the first byte not yet written.
+         *
+         * \param n The amount of bytes written to the device
+         *
+         * \since v1.2.0
+         */
+        void consume_output(std::size_t n) noexcept;
+
+        /**
+         * \brief Drops the buffers not written yet
+         *
+         * For when writing to the device failed, so the sentences queued may be
+         * destroyed before they are written. A sentence written partially leaves
+         * the connection unusable.
+         *
+         * \since v1.2.0
+         */
+        void discard_output() noexcept;
+
+        /**
+         * \brief Copies bytes received from the device into the protocol
+         *
+         * \param bytes The received bytes
+         *
+         * \since v1.2.0
+         */
+        void feed(std::string_view bytes);
+
+        /**
+         * \brief Makes room for receiving bytes directly into the protocol
+         *
+         * Allows receiving without copying: read at most input_space() bytes to
+         * the returned position, then call commit_input() with the amount read.
+         *
+         * \param min_space The minimum amount of bytes to make room for
+         * \return The position to write the received bytes to
+         *
+         * \since v1.2.0
+         */
+        char* prepare_input(std::size_t min_space);
+
+        /**
+         * \brief The amount of bytes that may be written after prepare_input()
+         *
+         * \return The free space at the position returned by prepare_input()
+         *
+         * \since v1.2.0
+         */
+        std::size_t input_space() const noexcept;
+
+        /**
+         * \brief Marks `n` bytes written after prepare_input() as received
+         *
+         * \param n The amount of bytes received
+         *
+         * \since v1.2.0
+         */
+        void commit_input(std::size_t n) noexcept;
+
+        /**
+         * \brief The amount of bytes still missing after need_input was returned
+         *
+         * At least this many bytes must be received before next_event() can
+         * return anything but need_input again. It is only a lower bound, receiving
+         * more is always fine.
+         *
+         * \return The minimum amount of bytes to receive
+         *
+         * \since v1.2.0
+         */
+        std::size_t needed() const noexcept;
+
+        /**
+         * \brief Decodes the next event from the received bytes
+         *
+         * The reply sentence returned by view() after the previous event is
+         * released, so the received bytes of that are invalidated.
+         *
+         * \return The decoded event, or need_input if the received bytes do not
+         *  contain a complete sentence
+         *
+         * \throw bad_socket: If the received bytes are not valid API sentences, or
+         *  if the device rejected the login.
+         *
+         * \since v1.2.0
+         */
+        event next_event();
+
+        /**
+         * \brief The reply sentence received
+         *
+         * The attributes are views into the received bytes of the protocol.
+         *
+         * \return The reply sentence the last received event reported, valid until
+         *  the next call to next_event()
+         *
+         * \since v1.2.0
+         */
+        const reply_view& view() const noexcept;
+
+        /**
+         * \brief The amount of sentences whose replies were not all received
+         *
+         * Counts the sentences queued since login, including the ones not written
+         * yet, whose `!done` reply was not returned by next_event() yet. A `!fatal`
+         * reply ends the connection, and with it every sentence.
+         *
+         * \return The amount of sentences still expecting replies
+         *
+         * \since v1.2.0
+         */
+        std::size_t outstanding() const noexcept;
+
+        /**
+         * \brief The amount of bytes received, but not returned by next_event() yet
+         *
+         * \return The size of the received bytes after the sentence in view()
+         *
+         * \since v1.2.0
+         */
+        std::size_t buffered_input() const noexcept;
+
+    private:
+        std::string& next_trailer();
+
+        impl::recv_buffer _input;
+        std::vector<std::string_view> _words;
+        reply_view _view;
+        std::size_t _view_size = 0;
+        std::size_t _need = 1;
+        std::size_t _outstanding = 0;
+
+        std::vector<impl::socket::buffer> _output;
+        std::size_t _written = 0;
+        // the api attribute words and terminators of the queued sentences. strings
+        // in a deque are never moved, and they are reused once everything is written
+        std::deque<std::string> _trailers;
+        std::size_t _trailers_used = 0;
+
+        enum class state {
+            anonymous,
+            logging_in,
+            ready
+        };
+        state _state = state::anonymous;
+    };
+}
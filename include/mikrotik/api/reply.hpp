@@ -34,6 +34,7 @@
 #pragma once
 
 // stdlib
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -122,4 +123,97 @@ namespace mikrotik::api {
         type reply_type; ///< The type of the reply sentence received
         std::vector<std::string> attributes; ///< Content attributes of the received sentence
     };
+
+    namespace pmr {
+        /**
+         * \brief A reply sentence allocated from a memory resource
+         *
+         * The same as a \ref mikrotik::api::reply, except its attributes are
+         * allocated from a `std::pmr::memory_resource`. With a
+         * `std::pmr::monotonic_buffer_resource` the replies of a whole
+         * polling cycle may be released at once, without touching the
+         * global heap.
+         *
+         * \code
+         * std::pmr::monotonic_buffer_resource pool;
+         * for (;;) {
+         *     mt::pmr::reply rep(&pool);
+         *     api.send(cmd);
+         *     for (api.read(rep); rep.reply_type == rep.re; api.read(rep)) {
+         *         process(rep);
+         *     }
+         *     pool.release();
+         * }
+         * \endcode
+         *
+         * Use api_handler::read(pmr::reply&) or api_handler::read_pmr() to read one.
+         *
+         * \since v1.2.0
+         */
+        struct reply {
+            using type = api::reply::type; ///< The reply sentence's type, see reply::type
+            using allocator_type = std::pmr::polymorphic_allocator<char>; ///< The allocator of the attributes
+
+            static constexpr const type done = api::reply::done;   ///< \copydoc api::reply::done
+            static constexpr const type trap = api::reply::trap;   ///< \copydoc api::reply::trap
+            static constexpr const type fatal = api::reply::fatal; ///< \copydoc api::reply::fatal
+            static constexpr const type re = api::reply::re;       ///< \copydoc api::reply::re
+
+            /**
+             * \brief Creates an empty reply allocating from the default memory resource
+             *
+             * \since v1.2.0
+             */
+            reply() noexcept = default;
+
+            /**
+             * \brief Creates an empty reply allocating from the given allocator
+             *
+             * \param alloc The allocator, or the memory resource, to use for the attributes
+             *
+             * \since v1.2.0
+             */
+            explicit reply(allocator_type alloc) noexcept
+                 : attributes(alloc) { }
+
+            reply(const reply&) = default;
+            reply(reply&&) noexcept = default;
+
+            /**
+             * \brief Copies a reply, allocating the copy from the given allocator
+             *
+             * Used by allocator-aware containers, like `std::pmr::vector<pmr::reply>`,
+             * to construct their elements from their own memory resource.
+             *
+             * \param other The reply to copy
+             * \param alloc The allocator, or the memory resource, to use for the attributes
+             *
+             * \since v1.2.0
+             */
+            reply(const reply& other, allocator_type alloc)
+                 : reply_type(other.reply_type),
+                   attributes(other.attributes, alloc) { }
+
+            /**
+             * \brief Moves a reply, allocating the result from the given allocator
+             *
+             * The attributes are only moved if `alloc` uses the same memory resource
+             * as `other`, otherwise they are copied.
+             *
+             * \param other The reply to move from
+             * \param alloc The allocator, or the memory resource, to use for the attributes
+             *
+             * \since v1.2.0
+             */
+            reply(reply&& other, allocator_type alloc)
+                 : reply_type(other.reply_type),
+                   attributes(std::move(other.attributes), alloc) { }
+
+            reply& operator=(const reply&) = default;
+            reply& operator=(reply&&) = default;
+
+            type reply_type = done; ///< The type of the reply sentence received
+            std::pmr::vector<std::pmr::string> attributes; ///< Content attributes of the received sentence
+        };
+    }
 }
@@ -0,0 +1,67 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <string_view>
+#include <vector>
+
+// project
+#include "reply.hpp"
+
+namespace mikrotik::api {
+    /**
+     * \brief A non-owning reply sentence from the MikroTik device
+     *
+     * The same as a \ref reply, except its attributes are views into
+     * the receive buffer of the connection it was read from. This makes reading
+     * replies free of allocations, but the views are only valid until
+     * the next sentence is read from the same connection.
+     *
+     * Use api_handler::read_view() to read one.
+     *
+     * \since v1.2.0
+     */
+    struct reply_view {
+        using type = reply::type; ///< The reply sentence's type, see reply::type
+
+        static constexpr const type done = reply::done;   ///< \copydoc reply::done
+        static constexpr const type trap = reply::trap;   ///< \copydoc reply::trap
+        static constexpr const type fatal = reply::fatal; ///< \copydoc reply::fatal
+        static constexpr const type re = reply::re;       ///< \copydoc reply::re
+
+        type reply_type = done; ///< The type of the reply sentence received
+        std::vector<std::string_view> attributes; ///< Content attributes of the received sentence
+    };
+}
@@ -0,0 +1,185 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// project
+#include "api_handler.hpp"
+#include "backoff.hpp"
+#include "ip_address.hpp"
+#include "reply.hpp"
+#include "sentence.hpp"
+#include "timeouts.hpp"
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    /**
+     * \brief The settings of a \ref resilient_handler
+     *
+     * \since v1.2.0
+     */
+    struct resilient_options {
+        /// The delays between reconnecting, and the amount of tries per call
+        backoff retry;
+
+        /// The time limits of the connections. The operation limit is what turns a
+        /// silently dead connection into a \ref socket_timeout, and so into a reconnect
+        timeouts limits{std::chrono::seconds(5), std::chrono::seconds(10), std::chrono::seconds(30)};
+    };
+
+    /**
+     * \brief A connection to a device that survives the device rebooting
+     *
+     * An \ref api_handler whose connection broke, because the device rebooted, or
+     * the link flapped, can not be used anymore. A resilient handler notices the
+     * failure, connects and logs in again, and, if the sentence in flight was
+     * idempotent, as classified by \ref is_idempotent, sends it again on the new
+     * connection. Mutating sentences are not resent, as the device may have executed
+     * them already: the \ref bad_socket is thrown, and the next call reconnects.
+     *
+     * The reconnects wait according to \ref resilient_options::retry, starting with
+     * the first one, so clients losing their connections at the same time do not
+     * all reconnect at the same moment. Connecting is deferred to the first use, so
+     * creating the handler succeeds even if the device is down.
+     *
+     * \code
+     * mt::resilient_handler api("10.0.0.1", "admin", "");
+     * for (;;) {
+     *     auto replies = api.execute("interface"_cmd / "print");
+     *     // ...
+     * }
+     * \endcode
+     *
+     * \since v1.2.0
+     */
+    struct MIKROTIK_API_EXPORT resilient_handler {
+        /**
+         * \brief Creates a handler for the device, without connecting to it
+         *
+         * \param address The IPv4 address of the MikroTik device to connect to
+         * \param user The username to log in as
+         * \param pass The password of the provided user
+         * \param port The port of the API service on the device
+         * \param opts The settings of reconnecting
+         *
+         * \since v1.2.0
+         */
+        explicit resilient_handler(ip_address address,
+                                   std::string_view user = "admin",
+                                   std::string_view pass = "",
+                                   std::uint16_t port = 8728,
+                                   const resilient_options& opts = {});
+
+        /**
+         * \brief Sends a sentence, and reads all of its replies
+         *
+         * If the connection is broken, it is reestablished first. If it breaks while
+         * the sentence is in flight, the sentence is sent again on a new connection
+         * if it is idempotent. Every failed try counts towards
+         * \ref backoff::attempts.
+         *
+         * \param snt The sentence to send
+         * \return All replies to the sentence, the last being the `!done` reply
+         *
+         * \throw bad_socket: If connecting failed as many times as allowed, or the
+         *  connection broke while a mutating sentence was in flight.
+         *
+         * \since v1.2.0
+         */
+        std::vector<reply> execute(const sentence& snt);
+
+        /**
+         * \brief Returns the current connection, connecting if there is none
+         *
+         * Sentences sent directly on the returned handler are not resent. If using it
+         * throws a \ref bad_socket, call reset() so the next use reconnects.
+         *
+         * \return The logged in connection
+         *
+         * \throw bad_socket: If connecting failed as many times as allowed.
+         *
+         * \since v1.2.0
+         */
+        api_handler& connection();
+
+        /**
+         * \brief Closes the current connection
+         *
+         * The next use connects again.
+         *
+         * \since v1.2.0
+         */
+        void reset() noexcept;
+
+        /**
+         * \brief Checks whether there is a connection that is not known to be broken
+         *
+         * \return Whether the handler holds a connection
+         *
+         * \since v1.2.0
+         */
+        bool is_connected() const noexcept;
+
+        /**
+         * \brief Returns how many times a broken connection has been replaced
+         *
+         * \return The amount of successful connections, not counting the first one
+         *
+         * \since v1.2.0
+         */
+        std::size_t reconnects() const noexcept;
+
+    private:
+        void connect();
+
+        ip_address _address;
+        std::string _user;
+        std::string _pass;
+        std::uint16_t _port;
+        resilient_options _opts;
+        std::unique_ptr<api_handler> _api;
+        std::size_t _connects = 0;
+        std::size_t _failures = 0;
+        std::mt19937 _rng;
+    };
+}
@@ -0,0 +1,248 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <cstddef>
+#include <iterator>
+
+// project
+#include "reply_view.hpp"
+#include "sentence.hpp"
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    struct api_handler;
+
+    /**
+     * \brief The `!re` replies of a command as an input range
+     *
+     * Returned by api_handler::stream(). Iterating over the stream reads
+     * the rows of the command one at a time, as they are needed, and every
+     * row is read into the same buffer of the connection, so even tables with
+     * millions of rows are processed in constant memory.
+     *
+     * \code
+     * for (const auto& row : api.stream("interface"_cmd / "print")) {
+     *     mt::attribute_map attrs(row);
+     *     // use attrs.get("name") etc.
+     * }
+     * \endcode
+     *
+     * The stream ends on the `!done` reply of the command. If the device replies
+     * with `!trap`, the rest of the replies is read, then \ref bad_command is thrown.
+     *
+     * As the stream reuses the buffer, the current row, and all the views it
+     * contains, are only valid until the iterator is incremented. It's an input
+     * range: it can only be iterated once.
+     *
+     * The command is sent with a `.tag`, which is not part of the rows. If the stream
+     * is destroyed before it ended, the command is cancelled with `/cancel`, and the
+     * remaining replies are read and discarded, so the connection can be used for the
+     * next command. This also ends commands that would never end on their own, like
+     * a `print` with `=follow=`.
+     *
+     * \since v1.2.0
+     */
+    struct MIKROTIK_API_EXPORT row_stream {
+        /**
+         * \brief The input iterator of a row stream
+         *
+         * \since v1.2.0
+         */
+        struct MIKROTIK_API_EXPORT iterator {
+            using iterator_category = std::input_iterator_tag; ///< Input iterator
+            using value_type = reply_view;                     ///< A row
+            using difference_type = std::ptrdiff_t;            ///< Required by iterator traits
+            using pointer = const reply_view*;                 ///< Pointer to the current row
+            using reference = const reply_view&;               ///< Reference to the current row
+
+            /**
+             * \brief Creates an end iterator
+             *
+             * \since v1.2.0
+             */
+            iterator() noexcept = default;
+
+            /**
+             * \brief Returns the current row
+             *
+             * \return The current row, valid until the iterator is incremented
+             *
+             * \since v1.2.0
+             */
+            reference operator*() const noexcept;
+
+            /**
+             * \brief Accesses the current row
+             *
+             * \return Pointer to the current row
+             *
+             * \since v1.2.0
+             */
+            pointer operator->() const noexcept;
+
+            /**
+             * \brief Reads the next row
+             *
+             * \return This iterator
+             *
+             * \throw bad_command: If the device replied with a `!trap`.
+             * \throw bad_socket: If the data could not be read, or the device
+             *  replied with a `!fatal`.
+             *
+             * \since v1.2.0
+             */
+            iterator& operator++();
+
+            /**
+             * \brief Reads the next row
+             *
+             * \throw bad_command: If the device replied with a `!trap`.
+             * \throw bad_socket: If the data could not be read, or the device
+             *  replied with a `!fatal`.
+             *
+             * \since v1.2.0
+             */
+            void operator++(int);
+
+            /**
+             * \brief Checks whether both iterators are at the same position
+             *
+             * Two iterators are equal if both are end iterators, or both iterate
+             * the same unfinished stream.
+             *
+             * \param other The iterator to compare to
+             * \return Whether the iterators are equal
+             *
+             * \since v1.2.0
+             */
+            bool operator==(const iterator& other) const noexcept;
+
+            /**
+             * \brief Checks whether the iterators are at different positions
+             *
+             * \param other The iterator to compare to
+             * \return Whether the iterators are not equal
+             *
+             * \since v1.2.0
+             */
+            bool operator!=(const iterator& other) const noexcept;
+
+        private:
+            friend struct row_stream;
+            explicit iterator(row_stream* stream) noexcept;
+
+            row_stream* _stream = nullptr;
+        };
+
+        /**
+         * \brief Sends a command, and creates the stream of its replies
+         *
+         * Prefer api_handler::stream().
+         *
+         * \param api The connection to send the command on, must outlive the stream
+         * \param snt The command to send
+         *
+         * \throw bad_word: If a word of the sentence is too long to be sent.
+         * \throw bad_socket: If the sentence could not be sent.
+         *
+         * \since v1.2.0
+         */
+        row_stream(api_handler& api, const sentence& snt);
+
+        row_stream(const row_stream&) = delete;
+        row_stream& operator=(const row_stream&) = delete;
+
+        /**
+         * \brief Moves the unread replies into a new stream
+         *
+         * \param other The stream to take over
+         *
+         * \since v1.2.0
+         */
+        row_stream(row_stream&& other) noexcept;
+
+        row_stream& operator=(row_stream&&) = delete;
+
+        /**
+         * \brief Cancels the command, and discards its remaining replies, if any
+         *
+         * Errors while sending `/cancel` or reading are ignored.
+         *
+         * \since v1.2.0
+         */
+        ~row_stream() noexcept;
+
+        /**
+         * \brief Reads the first row, and returns an iterator to it
+         *
+         * Must only be called once.
+         *
+         * \return The iterator to the first row, or the end iterator if there are none
+         *
+         * \throw bad_command: If the device replied with a `!trap`.
+         * \throw bad_socket: If the data could not be read, or the device
+         *  replied with a `!fatal`.
+         *
+         * \since v1.2.0
+         */
+        iterator begin();
+
+        /**
+         * \brief Returns the end iterator
+         *
+         * \return The end iterator
+         *
+         * \since v1.2.0
+         */
+        iterator end() noexcept;
+
+        /**
+         * \brief Checks whether all replies of the command were read
+         *
+         * \return Whether the `!done` reply was read
+         *
+         * \since v1.2.0
+         */
+        bool done() const noexcept;
+
+    private:
+        void advance();
+
+        api_handler* _api;
+        reply_view _row;
+        bool _done = false;
+    };
+}
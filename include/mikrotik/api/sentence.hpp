@@ -34,9 +34,16 @@
 #pragma once
 
 // stdlib
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
 #include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory_resource>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -46,6 +53,8 @@
 // project
 #include <mikrotik_api_export.h>
 #include "attribute.hpp"
+#include "impl/small_buffer.hpp"
+#include "ip_address.hpp"
 #include "query.hpp"
 
 namespace mikrotik::api {
@@ -70,9 +79,159 @@ namespace mikrotik::api {
      * \endrst
      * For the \ref command, \ref attribute, and \ref query grammars see their documentation.
      *
+     * The words are stored in a single buffer already encoded as they are
+     * sent to the device, with their length prefixes. Typical commands fit
+     * into the storage inside the sentence object, so building them does not
+     * allocate.
+     *
      * \since v1.0.0
      */
     struct MIKROTIK_API_EXPORT sentence {
+        /**
+         * \brief Whether values of type `T` can be written by add_attribute() and add_query()
+         *
+         * \since v1.2.0
+         */
+        template<class T>
+        static constexpr const bool is_typed_value = (std::is_integral_v<T> && !std::is_same_v<T, char>)
+                                                     || std::is_same_v<T, ip_address>;
+
+        /**
+         * \brief A view of the words stored in a sentence
+         *
+         * Behaves like a read-only random access container of `std::string_view`
+         * elements. The views point into the sentence, so they are only valid
+         * until the sentence is changed or destroyed.
+         *
+         * \since v1.2.0
+         */
+        struct MIKROTIK_API_EXPORT word_list {
+            /**
+             * \brief Iterates over the words of the sentence
+             *
+             * \since v1.2.0
+             */
+            struct const_iterator {
+                using iterator_category = std::random_access_iterator_tag;
+                using value_type = std::string_view;
+                using difference_type = std::ptrdiff_t;
+                using pointer = void;
+                using reference = std::string_view;
+
+                std::string_view operator*() const noexcept;
+                std::string_view operator[](difference_type n) const noexcept;
+
+                const_iterator& operator++() noexcept;
+                const_iterator operator++(int) noexcept;
+                const_iterator& operator--() noexcept;
+                const_iterator operator--(int) noexcept;
+                const_iterator& operator+=(difference_type n) noexcept;
+                const_iterator& operator-=(difference_type n) noexcept;
+
+                friend const_iterator
+                operator+(const_iterator it, difference_type n) noexcept { return it += n; }
+                friend const_iterator
+                operator+(difference_type n, const_iterator it) noexcept { return it += n; }
+                friend const_iterator
+                operator-(const_iterator it, difference_type n) noexcept { return it -= n; }
+                friend difference_type
+                operator-(const const_iterator& lhs, const const_iterator& rhs) noexcept {
+                    return static_cast<difference_type>(lhs._idx) - static_cast<difference_type>(rhs._idx);
+                }
+
+                friend bool
+                operator==(const const_iterator& lhs, const const_iterator& rhs) noexcept { return lhs._idx == rhs._idx; }
+                friend bool
+                operator!=(const const_iterator& lhs, const const_iterator& rhs) noexcept { return lhs._idx != rhs._idx; }
+                friend bool
+                operator<(const const_iterator& lhs, const const_iterator& rhs) noexcept { return lhs._idx < rhs._idx; }
+                friend bool
+                operator>(const const_iterator& lhs, const const_iterator& rhs) noexcept { return lhs._idx > rhs._idx; }
+                friend bool
+                operator<=(const const_iterator& lhs, const const_iterator& rhs) noexcept { return lhs._idx <= rhs._idx; }
+                friend bool
+                operator>=(const const_iterator& lhs, const const_iterator& rhs) noexcept { return lhs._idx >= rhs._idx; }
+
+            private:
+                friend word_list;
+                const_iterator(const sentence* snt, std::size_t idx) noexcept
+                     : _snt(snt), _idx(idx) { }
+
+                const sentence* _snt;
+                std::size_t _idx;
+            };
+
+            using value_type = std::string_view;
+            using size_type = std::size_t;
+            using iterator = const_iterator;
+
+            const_iterator begin() const noexcept;
+            const_iterator end() const noexcept;
+
+            /**
+             * \brief Returns the amount of words
+             *
+             * \since v1.2.0
+             */
+            std::size_t size() const noexcept;
+
+            /**
+             * \brief Checks whether there are no words
+             *
+             * \since v1.2.0
+             */
+            bool empty() const noexcept;
+
+            /**
+             * \brief Returns the word at the given index
+             *
+             * \param idx The index of the word, must be less than size()
+             * \return The word
+             *
+             * \since v1.2.0
+             */
+            std::string_view operator[](std::size_t idx) const noexcept;
+
+            /**
+             * \brief Returns the first word, the command
+             *
+             * \since v1.2.0
+             */
+            std::string_view front() const noexcept;
+
+            /**
+             * \brief Returns the last word
+             *
+             * \since v1.2.0
+             */
+            std::string_view back() const noexcept;
+
+            /**
+             * \brief Copies the words into strings
+             *
+             * \return The words as a vector of owning strings
+             *
+             * \since v1.2.0
+             */
+            operator std::vector<std::string>() const;
+
+            /**
+             * \brief Compares the words of two sentences
+             *
+             * \since v1.2.0
+             */
+            bool operator==(const word_list& other) const noexcept;
+            /// \copydoc operator==
+            bool operator!=(const word_list& other) const noexcept;
+
+        private:
+            friend sentence;
+            explicit word_list(const sentence* snt) noexcept
+                 : _snt(snt) { }
+
+            const sentence* _snt;
+        };
+
         /**
          * \brief Constructs the empty sentence
          *
@@ -82,6 +241,19 @@ namespace mikrotik::api {
          * \since v1.1.0
          */
         sentence() = default;
+        /**
+         * \brief Constructs the empty sentence using a memory resource
+         *
+         * Words that do not fit into the storage inside the sentence are
+         * allocated from the given memory resource, instead of the default one.
+         * Copies of the sentence, including the ones made by the DSL,
+         * use the same memory resource.
+         *
+         * \param resource The memory resource to allocate from, must outlive the sentence
+         *
+         * \since v1.2.0
+         */
+        explicit sentence(std::pmr::memory_resource* resource) noexcept;
         /**
          * \brief Constructs a sentence from a command
          *
@@ -184,18 +356,167 @@ namespace mikrotik::api {
          * \since v1.0.0
          */
         void add_word(std::string_view word);
+        /**
+         * \brief Adds an attribute word to the sentence
+         *
+         * Writes `=<name>=<value>` directly into the storage of the sentence,
+         * without creating an \ref attribute first. Other overloads write
+         * integral, boolean, and \ref ip_address values without formatting
+         * them into a string beforehand.
+         *
+         * \code
+         * auto snt = ("interface"_cmd / "vlan" / "add");
+         * snt.add_attribute("name", name)
+         *    .add_attribute("vlan-id", 42)
+         *    .add_attribute("disabled", false);
+         * \endcode
+         *
+         * \param name The name of the attribute
+         * \param value The value of the attribute, may be empty
+         * \return The modified sentence
+         *
+         * \throw bad_word: If the word is too long to be sent.
+         *
+         * \since v1.2.0
+         */
+        sentence& add_attribute(std::string_view name, std::string_view value = {});
+        /**
+         * \brief Adds an attribute word with a typed value to the sentence
+         *
+         * The value is written directly into the storage of the sentence, without
+         * formatting it into a string first. Numbers are written in decimal,
+         * `bool` values are written as `yes` or `no`, as RouterOS expects them,
+         * and an \ref ip_address is written in its dotted form.
+         *
+         * \tparam T The type of the value, an integral type, `bool`, or \ref ip_address
+         * \param name The name of the attribute
+         * \param value The value of the attribute
+         * \return The modified sentence
+         *
+         * \since v1.2.0
+         */
+        template<class T, std::enable_if_t<is_typed_value<T>, int> = 0>
+        sentence&
+        add_attribute(std::string_view name, const T& value) {
+            char buf[typed_value_size<T>];
+            add_parts({"=", name, "=", to_chars(buf, value)});
+            return *this;
+        }
+
+        /**
+         * \brief Adds a query word to the sentence
+         *
+         * Writes `?<name>` directly into the storage of the sentence,
+         * without creating a \ref query first.
+         *
+         * \param name The name of the query, or a query operator like `#|`
+         * \return The modified sentence
+         *
+         * \throw bad_word: If the word is too long to be sent.
+         *
+         * \since v1.2.0
+         */
+        sentence& add_query(std::string_view name);
+        /**
+         * \brief Adds a query word with a value to the sentence
+         *
+         * Writes `?<name>=<value>` directly into the storage of the sentence.
+         * Like add_attribute(), values of integral, boolean, and \ref ip_address
+         * types are written without formatting them into a string first.
+         *
+         * \param name The name of the query, including its operator, if any
+         * \param value The value to compare to
+         * \return The modified sentence
+         *
+         * \throw bad_word: If the word is too long to be sent.
+         *
+         * \since v1.2.0
+         */
+        sentence& add_query(std::string_view name, std::string_view value);
+        /**
+         * \copydoc add_query(std::string_view, std::string_view)
+         */
+        template<class T, std::enable_if_t<is_typed_value<T>, int> = 0>
+        sentence&
+        add_query(std::string_view name, const T& value) {
+            char buf[typed_value_size<T>];
+            add_parts({"?", name, "=", to_chars(buf, value)});
+            return *this;
+        }
+
         /**
          * \brief Returns the current words of the sentence
          *
-         * \return The words stored by the sentence
+         * \rst
+         * .. note::
+         *  Before v1.2.0 this returned a ``const std::vector<std::string>&``.
+         *  The returned list converts to that type implicitly.
+         * \endrst
+         *
+         * \return A view of the words stored by the sentence
          */
-        const std::vector<std::string>& words() const;
+        word_list words() const noexcept;
+
+        /**
+         * \brief Returns the words encoded for sending
+         *
+         * The words of the sentence with their length prefixes, without the
+         * terminating empty word.
+         *
+         * \return The encoded words
+         *
+         * \since v1.2.0
+         */
+        std::string_view encoded() const noexcept;
+
+        /**
+         * \brief Returns the memory resource used by the sentence
+         *
+         * \return The memory resource words are allocated from, if they do not
+         *  fit inside the sentence
+         *
+         * \since v1.2.0
+         */
+        std::pmr::memory_resource* memory_resource() const noexcept;
+
     private:
-        std::vector<std::string> _words;
+        struct word_pos {
+            std::uint32_t begin;
+            std::uint32_t size;
+        };
+
+        std::string_view word(std::size_t idx) const noexcept;
+        void add_parts(std::initializer_list<std::string_view> parts);
+        // large enough for the sign and every digit of T, or for a dotted ip_address
+        template<class T>
+        static constexpr const std::size_t typed_value_size =
+               std::is_integral_v<T> ? static_cast<std::size_t>(std::numeric_limits<T>::digits10) + 3 : 16;
+
+        template<class T, std::size_t N>
+        static std::string_view to_chars(char (&buf)[N], const T& value) noexcept;
+
+        impl::small_buffer<char, 192> _bytes;
+        impl::small_buffer<word_pos, 8> _words;
     };
 
     template<class It>
-    sentence::sentence(It beg, It end)
-         : _words(beg, end) {
+    sentence::sentence(It beg, It end) {
+        for (; beg != end; ++beg) {
+            add_word(*beg);
+        }
+    }
+
+    template<class T, std::size_t N>
+    std::string_view
+    sentence::to_chars(char (&buf)[N], const T& value) noexcept {
+        if constexpr (std::is_same_v<T, bool>) {
+            return value ? "yes" : "no";
+        } else if constexpr (std::is_same_v<T, ip_address>) {
+            auto [end, _] = value.to_chars(buf, buf + sizeof(buf));
+            return {buf, static_cast<std::size_t>(end - buf)};
+        } else {
+            auto [end, _] = std::to_chars(buf, buf + sizeof(buf), value);
+            return {buf, static_cast<std::size_t>(end - buf)};
+        }
     }
 }
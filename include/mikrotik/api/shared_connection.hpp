@@ -0,0 +1,206 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// project
+#include "ip_address.hpp"
+#include "reply.hpp"
+#include "sentence.hpp"
+#include "timeouts.hpp"
+#include <mikrotik_api_export.h>
+
+namespace mikrotik::api {
+    /**
+     * \brief A connection to a device shared between many threads
+     *
+     * An \ref api_handler must not be used from more than one thread at once, so
+     * threads talking to the same device each need their own connection, each
+     * occupying an API session on the device. A shared connection is a single
+     * logged in connection, which any amount of threads may submit sentences
+     * to concurrently.
+     *
+     * Submitting a sentence pushes it to a lock-free queue and returns, without
+     * touching the socket. A dedicated I/O thread owns the connection: it takes the
+     * sentences from the queue, tags them with `.tag` and sends them without
+     * waiting for the replies of the earlier ones, and routes the replies back to
+     * their sentences. When the `!done` reply of a sentence arrives, its future
+     * becomes ready, or its callback is called.
+     *
+     * \code
+     * mt::shared_connection conn("10.0.0.1", "admin", "");
+     * // from any thread
+     * auto replies = conn.submit("system"_cmd / "resource" / "print").get();
+     * conn.submit("interface"_cmd / "print",
+     *             [](std::vector<mt::reply>&& replies, std::exception_ptr err) {
+     *                 // called on the I/O thread
+     *             });
+     * \endcode
+     *
+     * If the connection fails, every sentence in flight, and every sentence submitted
+     * later, fails with a \ref bad_socket. A failed connection stays failed, to retry,
+     * create a new one. With an operation limit, a connection that neither sends
+     * nor receives a sentence for that long while sentences are in flight fails
+     * with a \ref socket_timeout, so no sentence waits forever for a silent device.
+     *
+     * \since v1.2.0
+     */
+    struct MIKROTIK_API_EXPORT shared_connection {
+        /**
+         * \brief The callback called when a sentence completes
+         *
+         * On success, it receives all replies to the sentence, the last being
+         * the `!done` reply, and an empty exception pointer. A `!trap` reply
+         * does not count as failure, it is just part of the replies.
+         * If the connection failed before the sentence completed, it receives the
+         * replies read so far, and a pointer to a \ref bad_socket exception.
+         *
+         * The replies do not contain the `.tag` word. The callback is called on the
+         * I/O thread, so it should return quickly. It should not throw: as there is
+         * nobody on the I/O thread to handle them, exceptions escaping the callback
+         * are caught and ignored.
+         *
+         * \since v1.2.0
+         */
+        using completion = std::function<void(std::vector<reply>&& replies, std::exception_ptr error)>;
+
+        /**
+         * \brief Connects and logs into the device, and starts the I/O thread
+         *
+         * Connecting and logging in is done on the calling thread, just like
+         * by an \ref api_handler.
+         *
+         * \param address The IPv4 address of the MikroTik device to connect to
+         * \param user The username to log in as
+         * \param pass The password of the provided user
+         * \param port The port of the API service on the device
+         * \param limits The time limits of connecting and logging in, and the operation
+         *  limit the I/O thread waits for the next sentence to be sent, or the next
+         *  reply to arrive, while sentences are in flight. A zero operation limit
+         *  waits forever
+         *
+         * \throw bad_socket: If connecting or logging in failed.
+         * \throw socket_timeout: If connecting or logging in took longer than allowed.
+         *
+         * \since v1.2.0
+         */
+        explicit shared_connection(ip_address address,
+                                   std::string_view user = "admin",
+                                   std::string_view pass = "",
+                                   std::uint16_t port = 8728,
+                                   const timeouts& limits = {});
+
+        shared_connection(const shared_connection&) = delete;
+        shared_connection& operator=(const shared_connection&) = delete;
+
+        /**
+         * \brief Stops the I/O thread and closes the connection
+         *
+         * Sentences still in flight fail with a \ref bad_socket.
+         *
+         * \since v1.2.0
+         */
+        ~shared_connection() noexcept;
+
+        /**
+         * \brief Submits a sentence for sending
+         *
+         * May be called from any thread.
+         * The sentence must not contain a `.tag` word already.
+         *
+         * \param snt The sentence to send
+         * \return A future of all replies to the sentence, the last being the `!done`
+         *  reply. If the connection failed, it holds a \ref bad_socket instead
+         *
+         * \since v1.2.0
+         */
+        std::future<std::vector<reply>> submit(sentence snt);
+
+        /**
+         * \brief Submits a sentence for sending, and calls a callback with its replies
+         *
+         * May be called from any thread.
+         * The sentence must not contain a `.tag` word already.
+         *
+         * \param snt The sentence to send
+         * \param done The callback to call with the result of the sentence
+         *
+         * \throw std::invalid_argument: If the callback is empty.
+         *
+         * \since v1.2.0
+         */
+        void submit(sentence snt, completion done);
+
+        /**
+         * \brief Checks whether the connection has failed
+         *
+         * \return Whether the connection has failed
+         *
+         * \since v1.2.0
+         */
+        bool failed() const noexcept;
+
+        /**
+         * \brief Returns the amount of sentences submitted, but not completed yet
+         *
+         * \return The amount of sentences in the queue or in flight
+         *
+         * \since v1.2.0
+         */
+        std::size_t pending() const noexcept;
+
+    private:
+        struct request;
+        struct state;
+
+        void enqueue(request* req);
+        void run() noexcept;
+        void start(request* req);
+        void flush();
+        void receive();
+        void dispatch();
+        void fail(std::exception_ptr error) noexcept;
+
+        std::unique_ptr<state> _state;
+    };
+}
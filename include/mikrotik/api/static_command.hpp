@@ -0,0 +1,261 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// project
+#include "attribute.hpp"
+#include "command.hpp"
+#include "impl/length_codec.hpp"
+#include "query.hpp"
+#include "sentence.hpp"
+
+namespace mikrotik::api {
+    namespace impl {
+        template<std::size_t N>
+        constexpr void
+        static_append(std::array<char, N>& out, std::size_t& pos, const char* str, std::size_t len) noexcept {
+            for (std::size_t i = 0; i < len; ++i) {
+                out[pos++] = str[i];
+            }
+        }
+
+        // encode_length writes 4 bytes even for shorter prefixes, which do not fit
+        // in front of one byte words, so the prefix is copied over from a full buffer
+        template<std::size_t N>
+        constexpr std::size_t
+        static_prefix(std::array<char, N>& out, std::size_t len) noexcept {
+            char prefix[max_length_size]{};
+            std::size_t pos = 0;
+            static_append(out, pos, prefix, encode_length(len, prefix));
+            return pos;
+        }
+    }
+
+    /**
+     * \brief A command word encoded at compile time
+     *
+     * Contains the complete sentence of a command without attributes:
+     * the length prefix, the command word, and the terminating empty word,
+     * exactly as it is sent to the device. Creating one with command_path(),
+     * or the `_ct` literal in C++20, happens at compile time, and sending it with
+     * api_handler::send() is a single write without allocating or encoding anything.
+     *
+     * \code
+     * constexpr auto print = mt::command_path("interface", "print"); // -> /interface/print
+     *
+     * api.send(print);
+     * api.send(print[{".proplist", "name"}]); // works with the sentence DSL
+     * \endcode
+     *
+     * Adding attributes or queries turns it into a regular \ref sentence, and
+     * it's converted to \ref command and \ref sentence implicitly when needed.
+     *
+     * \tparam Len The length of the command word
+     *
+     * \since v1.2.0
+     */
+    template<std::size_t Len>
+    struct static_command {
+        static_assert(Len < 0x10000000, "command word too long");
+
+        /// \brief The size of the encoded sentence in bytes
+        static constexpr const std::size_t size = impl::length_size(Len) + Len + 1;
+
+        std::array<char, size> bytes{}; ///< The encoded sentence
+
+        /**
+         * \brief Returns the command word
+         *
+         * \return The command word, including the leading forward slash
+         *
+         * \since v1.2.0
+         */
+        constexpr std::string_view
+        word() const noexcept {
+            return {bytes.data() + impl::length_size(Len), Len};
+        }
+
+        /**
+         * \brief Returns the encoded sentence
+         *
+         * \return The bytes to send to the device
+         *
+         * \since v1.2.0
+         */
+        constexpr std::string_view
+        encoded() const noexcept {
+            return {bytes.data(), size};
+        }
+
+        /**
+         * \brief Converts to a runtime command
+         *
+         * \return The command with the same word
+         *
+         * \since v1.2.0
+         */
+        operator command() const {
+            return command(word().substr(1));
+        }
+
+        /**
+         * \brief Converts to a sentence
+         *
+         * \return The sentence containing only the command word
+         *
+         * \since v1.2.0
+         */
+        operator sentence() const {
+            sentence ret;
+            ret.add_word(word());
+            return ret;
+        }
+
+        /**
+         * \brief Creates a sentence from the command with an attribute
+         *
+         * \param attr The attribute to add
+         * \return The new sentence
+         *
+         * \since v1.2.0
+         */
+        sentence
+        operator[](const attribute& attr) const {
+            sentence ret;
+            ret.add_word(word());
+            ret.add_word(attr.value);
+            return ret;
+        }
+
+        /**
+         * \brief Creates a sentence from the command with a query
+         *
+         * \param q The query to add
+         * \return The new sentence
+         *
+         * \since v1.2.0
+         */
+        sentence
+        operator()(const query& q) const {
+            sentence ret;
+            ret.add_word(word());
+            ret.add_word(q.value);
+            return ret;
+        }
+    };
+
+    /**
+     * \brief Creates a command from its path at compile time
+     *
+     * Joins the parts with forward slashes, and prepends one to the
+     * result, like the `_cmd` DSL does, but all of it, including the
+     * encoding, can happen at compile time.
+     *
+     * \code
+     * constexpr auto cmd = mt::command_path("system", "resource", "print"); // -> /system/resource/print
+     * \endcode
+     *
+     * \param parts The string literals making up the path of the command
+     * \return The encoded command
+     *
+     * \since v1.2.0
+     */
+    template<std::size_t... Ns>
+    constexpr static_command<(Ns + ...)>
+    command_path(const char (&... parts)[Ns]) noexcept {
+        constexpr const std::size_t len = (Ns + ...);
+
+        static_command<len> ret{};
+        auto pos = impl::static_prefix(ret.bytes, len);
+        ((ret.bytes[pos++] = '/', impl::static_append(ret.bytes, pos, parts, Ns - 1)), ...);
+        ret.bytes[pos] = '\0';
+        return ret;
+    }
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+    namespace impl {
+        template<std::size_t N>
+        struct fixed_string {
+            constexpr fixed_string(const char (&str)[N]) noexcept {
+                for (std::size_t i = 0; i < N; ++i) {
+                    chars[i] = str[i];
+                }
+            }
+
+            char chars[N]{};
+        };
+    }
+
+    inline namespace literals {
+        /**
+         * \brief Creates a command from a string literal at compile time
+         *
+         * The compile time counterpart of the `_cmd` literal: the forward slash is
+         * prepended if the literal does not start with one already.
+         *
+         * \code
+         * constexpr auto a = "interface/print"_ct;  // -> /interface/print
+         * constexpr auto b = "/interface/print"_ct; // -> /interface/print
+         * \endcode
+         *
+         * Only available in C++20.
+         *
+         * \tparam Str The string literal
+         * \return The encoded command
+         *
+         * \since v1.2.0
+         */
+        template<impl::fixed_string Str>
+        constexpr auto
+        operator""_ct() noexcept {
+            constexpr const bool has_slash = Str.chars[0] == '/';
+            constexpr const std::size_t len = sizeof(Str.chars) - (has_slash ? 1 : 0);
+
+            static_command<len> ret{};
+            auto pos = impl::static_prefix(ret.bytes, len);
+            if (!has_slash)
+                ret.bytes[pos++] = '/';
+            impl::static_append(ret.bytes, pos, Str.chars, sizeof(Str.chars) - 1);
+            ret.bytes[pos] = '\0';
+            return ret;
+        }
+    }
+#endif
+}
@@ -0,0 +1,254 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+#if !defined(__cpp_impl_coroutine) && !defined(__cpp_coroutines)
+#    error "mikrotik/api/task.hpp requires C++20 coroutines"
+#endif
+
+// stdlib
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace mikrotik::api {
+    template<class T>
+    struct task;
+
+    namespace impl {
+        template<class T>
+        struct task_promise_base {
+            struct final_awaiter {
+                bool await_ready() noexcept {
+                    return false;
+                }
+
+                template<class Promise>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> self) noexcept {
+                    // continue whoever awaited us, if anyone
+                    if (auto cont = self.promise().continuation)
+                        return cont;
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() noexcept { }
+            };
+
+            std::suspend_always initial_suspend() noexcept {
+                return {};
+            }
+
+            final_awaiter final_suspend() noexcept {
+                return {};
+            }
+
+            void unhandled_exception() noexcept {
+                error = std::current_exception();
+            }
+
+            std::coroutine_handle<> continuation;
+            std::exception_ptr error;
+        };
+
+        template<class T>
+        struct task_promise : task_promise_base<T> {
+            task<T> get_return_object() noexcept;
+
+            template<class U>
+            void return_value(U&& val) {
+                value.emplace(std::forward<U>(val));
+            }
+
+            T result() {
+                if (this->error)
+                    std::rethrow_exception(this->error);
+                return std::move(*value);
+            }
+
+            std::optional<T> value;
+        };
+
+        template<>
+        struct task_promise<void> : task_promise_base<void> {
+            task<void> get_return_object() noexcept;
+
+            void return_void() noexcept { }
+
+            void result() {
+                if (this->error)
+                    std::rethrow_exception(this->error);
+            }
+        };
+    }
+
+    /**
+     * \brief A lazily started coroutine producing a value of type T
+     *
+     * The coroutine type returned by the asynchronous interfaces of the library.
+     * A task does not start running when created, only when it is `co_await`-ed
+     * from another coroutine, or when it's passed to an \ref event_loop.
+     * The result of the coroutine, or the exception it exited with, is
+     * returned, or rethrown, by the `co_await` expression.
+     *
+     * \code
+     * mt::task<std::string> identity(mt::async_handler& api) {
+     *     auto replies = co_await api.execute("system"_cmd / "identity" / "print");
+     *     co_return mt::attribute_map(replies.front()).get("name").value_or("");
+     * }
+     * \endcode
+     *
+     * A task can only be awaited once, and owns the coroutine: destroying the
+     * task destroys the coroutine with it.
+     *
+     * \tparam T The type of the value produced by the coroutine
+     *
+     * \since v1.2.0
+     */
+    template<class T = void>
+    struct task {
+        using promise_type = impl::task_promise<T>; ///< The promise type of the coroutine
+
+        /**
+         * \brief Creates a task owning nothing
+         *
+         * \since v1.2.0
+         */
+        task() noexcept = default;
+
+        /**
+         * \brief Moves the ownership of the coroutine into a new task
+         *
+         * \param other The task to take the coroutine from
+         *
+         * \since v1.2.0
+         */
+        task(task&& other) noexcept
+             : _coro(std::exchange(other._coro, {})) { }
+
+        /**
+         * \brief Moves the ownership of the coroutine into this task
+         *
+         * The coroutine owned by this object, if any, is destroyed.
+         *
+         * \param other The task to take the coroutine from
+         * \return This task
+         *
+         * \since v1.2.0
+         */
+        task& operator=(task&& other) noexcept {
+            if (this != &other) {
+                if (_coro)
+                    _coro.destroy();
+                _coro = std::exchange(other._coro, {});
+            }
+            return *this;
+        }
+
+        /**
+         * \brief Destroys the owned coroutine
+         *
+         * \since v1.2.0
+         */
+        ~task() {
+            if (_coro)
+                _coro.destroy();
+        }
+
+        /**
+         * \brief Starts the coroutine and waits for its result
+         *
+         * \return An awaitable whose result is the result of the coroutine
+         *
+         * \throw std::logic_error: If the task owns no coroutine, like a default
+         *  constructed, or a moved from task.
+         *
+         * \since v1.2.0
+         */
+        auto operator co_await() && noexcept {
+            struct awaiter {
+                std::coroutine_handle<promise_type> coro;
+
+                bool await_ready() noexcept {
+                    return !coro || coro.done();
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<> cont) noexcept {
+                    coro.promise().continuation = cont;
+                    return coro;
+                }
+
+                T await_resume() {
+                    // checked in release builds too, as there is no promise to read from
+                    if (!coro)
+                        throw std::logic_error("awaiting a task without a coroutine");
+                    return coro.promise().result();
+                }
+            };
+            return awaiter{_coro};
+        }
+
+        /**
+         * \brief Releases the ownership of the coroutine
+         *
+         * \return The handle of the coroutine, which must be destroyed by
+         *  the caller
+         *
+         * \since v1.2.0
+         */
+        std::coroutine_handle<promise_type> release() noexcept {
+            return std::exchange(_coro, {});
+        }
+
+    private:
+        friend promise_type;
+
+        explicit task(std::coroutine_handle<promise_type> coro) noexcept
+             : _coro(coro) { }
+
+        std::coroutine_handle<promise_type> _coro;
+    };
+
+    template<class T>
+    task<T>
+    impl::task_promise<T>::get_return_object() noexcept {
+        return task<T>{std::coroutine_handle<task_promise<T>>::from_promise(*this)};
+    }
+
+    inline task<void>
+    impl::task_promise<void>::get_return_object() noexcept {
+        return task<void>{std::coroutine_handle<task_promise<void>>::from_promise(*this)};
+    }
+}
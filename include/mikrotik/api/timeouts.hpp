@@ -0,0 +1,73 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <chrono>
+
+namespace mikrotik::api {
+    /**
+     * \brief Time limits of the operations of a connection
+     *
+     * Taken by \ref api_handler, \ref async_handler, \ref shared_connection, and
+     * the connections of a \ref connection_manager.
+     *
+     * A limit of zero, the default, means the operation may take as long as the
+     * resident socket implementation allows, which, for connecting to an unreachable
+     * address, may be minutes, and for reading from a stalled device, forever.
+     * If an operation exceeds its limit, \ref socket_timeout is thrown, and the
+     * connection can not be used anymore.
+     *
+     * \code
+     * mt::timeouts limits;
+     * limits.connect = std::chrono::seconds(2);
+     * limits.login = std::chrono::seconds(5);
+     * limits.operation = std::chrono::seconds(10);
+     * mt::api_handler api("10.0.0.1", "admin", "", 8728, limits);
+     * \endcode
+     *
+     * \since v1.2.0
+     */
+    struct timeouts {
+        /// The time allowed for establishing the connection
+        std::chrono::milliseconds connect{0};
+
+        /// The time allowed for logging in, from sending the credentials to reading
+        /// the reply. If zero, the operation limit applies to both separately
+        std::chrono::milliseconds login{0};
+
+        /// The time allowed for sending a sentence, or for reading a reply sentence
+        std::chrono::milliseconds operation{0};
+    };
+}
@@ -0,0 +1,374 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// project
+#include <mikrotik/api/impl/sockets.hpp>
+#include <mikrotik/api/ip_address.hpp>
+#include <mikrotik/api/reply.hpp>
+
+namespace mikrotik::api::mock {
+    /**
+     * \brief A row of a table served by the mock server
+     *
+     * The attribute names and values of the row, in the order they are sent.
+     *
+     * \since v1.2.0
+     */
+    using row = std::vector<std::pair<std::string, std::string>>;
+
+    /**
+     * \brief A sentence received by the mock server
+     *
+     * \since v1.2.0
+     */
+    struct request {
+        std::vector<std::string> words; ///< The words of the sentence, without the terminator
+
+        /**
+         * \brief The command word of the sentence
+         *
+         * \return The first word, or an empty string for an empty sentence
+         *
+         * \since v1.2.0
+         */
+        std::string_view command() const noexcept;
+
+        /**
+         * \brief The value of an attribute word of the sentence
+         *
+         * Looks for the `=<name>=<value>` word.
+         *
+         * \param name The name of the attribute
+         * \return The value of the attribute, if the sentence has it
+         *
+         * \since v1.2.0
+         */
+        std::optional<std::string_view> attribute(std::string_view name) const noexcept;
+
+        /**
+         * \brief The tag of the sentence
+         *
+         * \return The value of the `.tag` API attribute, if the sentence has it
+         *
+         * \since v1.2.0
+         */
+        std::optional<std::string_view> tag() const noexcept;
+    };
+
+    /**
+     * \brief A scripted command of the mock server
+     *
+     * Receives the request, and returns the replies to send for it in order.
+     * The tag of the request is added to the replies by the server.
+     *
+     * \since v1.2.0
+     */
+    using handler = std::function<std::vector<reply>(const request& req)>;
+
+    /**
+     * \brief Generates a row of a table on request
+     *
+     * Receives the index of the row, and returns its contents.
+     *
+     * \since v1.2.0
+     */
+    using generator = std::function<row(std::size_t idx)>;
+
+    /**
+     * \brief A fake RouterOS device speaking the API protocol
+     *
+     * Lets an \ref api_handler, or anything else speaking the protocol, be tested
+     * and benchmarked end to end without a router. The server listens on an
+     * ephemeral port of the loopback interface, or serves already connected sockets,
+     * such as one end of a socket pair, given to serve(). Every connection is handled
+     * on its own thread.
+     *
+     * The server understands the following commands:
+     *
+     *  - `/login` succeeds if the `=name=` and `=password=` attributes match a user
+     *    added with add_user(), the `admin` user without password by default.
+     *    Every other command fails with a `!trap` until the login succeeds.
+     *  - `/quit` replies with `!fatal` and closes the connection.
+     *  - `/cancel` ends the followed print with the `.tag` in its `=tag=` attribute,
+     *    or all of them without one, with a `!trap` and a `!done`, then replies with
+     *    `!done`. Other commands are answered completely before the next one is read,
+     *    so there is nothing else to cancel.
+     *  - `<path>/print` for tables added with table() or generate(). The rows are
+     *    filtered by the `?<name>=<value>`, `?<name>`, and `?-<name>` queries of the
+     *    command, which are and-ed together, and the attributes of the rows are limited
+     *    to the names in the `=.proplist=` attribute, if it is present. With the
+     *    `=count-only=` attribute only the amount of matching rows is sent as `=ret=`.
+     *    With the `=follow=` attribute the rows are sent, but the `!done` is not: the
+     *    print is followed until it is cancelled, like on a router whose table does not
+     *    change.
+     *  - Anything added with on(), which takes precedence over the above.
+     *
+     * Everything else is answered with a `!trap` and a `!done`, like a router answers
+     * unknown commands. Replies carry the `.tag` of their request.
+     *
+     * Network conditions can be simulated with latency() and bandwidth(). The replies
+     * to every request are sent no earlier than the latency after the request
+     * arrived, so requests pipelined on the same connection wait for it together,
+     * like they would on a real link.
+     *
+     * \code
+     * mt::mock::server srv;
+     * srv.generate("/interface", 10'000, [](std::size_t i) {
+     *        return mt::mock::row{{"name", "ether" + std::to_string(i)}};
+     *    })
+     *    .latency(std::chrono::milliseconds(20));
+     *
+     * mt::api_handler api(srv.address(), "admin", "", srv.port());
+     * for (const auto& row : api.stream("interface"_cmd / "print")) {
+     *     // ...
+     * }
+     * \endcode
+     *
+     * \rst
+     * .. note::
+     *
+     *  The commands, tables, and users must be set up before the first connection is made,
+     *  as they are not protected from concurrent access. latency() and bandwidth()
+     *  may be changed at any time.
+     * \endrst
+     *
+     * \since v1.2.0
+     */
+    struct server {
+        /**
+         * \brief Starts listening on an ephemeral port of 127.0.0.1
+         *
+         * \throw bad_socket: If the listening socket cannot be created.
+         *
+         * \since v1.2.0
+         */
+        server();
+
+        /**
+         * \brief Starts listening on the given port of 127.0.0.1
+         *
+         * \param port The port to listen on, or zero for an ephemeral port
+         *
+         * \throw bad_socket: If the listening socket cannot be created.
+         *
+         * \since v1.2.0
+         */
+        explicit server(std::uint16_t port);
+
+        server(const server&) = delete;
+        server& operator=(const server&) = delete;
+
+        /**
+         * \brief Stops the server
+         *
+         * \since v1.2.0
+         */
+        ~server() noexcept;
+
+        /**
+         * \brief The address the server listens on
+         *
+         * \return Always 127.0.0.1
+         *
+         * \since v1.2.0
+         */
+        ip_address address() const;
+
+        /**
+         * \brief The port the server listens on
+         *
+         * \return The port of the listening socket
+         *
+         * \since v1.2.0
+         */
+        std::uint16_t port() const noexcept;
+
+        /**
+         * \brief Adds a user who may log in
+         *
+         * \param name The name of the user
+         * \param pass The password of the user
+         * \return The server itself
+         *
+         * \since v1.2.0
+         */
+        server& add_user(std::string name, std::string pass);
+
+        /**
+         * \brief Serves a table from the given rows
+         *
+         * \param path The path of the table, such as `/interface`
+         * \param rows The rows of the table
+         * \return The server itself
+         *
+         * \since v1.2.0
+         */
+        server& table(std::string path, std::vector<row> rows);
+
+        /**
+         * \brief Serves a table of generated rows
+         *
+         * The rows are generated while they are sent, so tables of any size
+         * can be served without keeping them in memory.
+         *
+         * \param path The path of the table, such as `/interface`
+         * \param count The amount of rows in the table
+         * \param gen The generator of the rows
+         * \return The server itself
+         *
+         * \since v1.2.0
+         */
+        server& generate(std::string path, std::size_t count, generator gen);
+
+        /**
+         * \brief Scripts the replies to a command
+         *
+         * \param command The command word, such as `/system/reboot`
+         * \param fn The handler returning the replies to the command
+         * \return The server itself
+         *
+         * \since v1.2.0
+         */
+        server& on(std::string command, handler fn);
+
+        /**
+         * \brief Delays every reply
+         *
+         * \param delay The time between receiving a request and sending its replies
+         * \return The server itself
+         *
+         * \since v1.2.0
+         */
+        server& latency(std::chrono::microseconds delay) noexcept;
+
+        /**
+         * \brief Limits the rate of sending replies on every connection
+         *
+         * \param bytes_per_second The maximum amount of bytes sent per second on
+         *  a connection, or zero for no limit
+         * \return The server itself
+         *
+         * \since v1.2.0
+         */
+        server& bandwidth(std::size_t bytes_per_second) noexcept;
+
+        /**
+         * \brief Serves an already connected socket
+         *
+         * The server takes ownership of the socket, and closes it when the
+         * connection ends, or the server is stopped.
+         *
+         * \param sock The socket to serve
+         *
+         * \since v1.2.0
+         */
+        void serve(impl::socket::handle sock);
+
+        /**
+         * \brief The amount of connections served so far
+         *
+         * \return The amount of accepted and served sockets
+         *
+         * \since v1.2.0
+         */
+        std::size_t connections() const noexcept;
+
+        /**
+         * \brief The amount of requests answered so far
+         *
+         * \return The amount of sentences answered on all connections
+         *
+         * \since v1.2.0
+         */
+        std::size_t requests() const noexcept;
+
+        /**
+         * \brief Stops accepting connections, and closes all open ones
+         *
+         * Blocks until all threads of the server have finished.
+         *
+         * \since v1.2.0
+         */
+        void stop() noexcept;
+
+    private:
+        struct connection;
+        struct table_data {
+            std::size_t count;
+            generator gen;
+        };
+
+        void accept_loop();
+        void handle(impl::socket::handle sock);
+        void answer(connection& conn, const request& req);
+        void print(connection& conn, const request& req, const table_data& table);
+        void cancel(connection& conn, const request& req);
+        void flush(connection& conn);
+
+        impl::socket::handle _listener;
+        std::uint16_t _port = 0;
+        std::atomic<bool> _stopping{false};
+        std::atomic<std::int64_t> _latency{0};
+        std::atomic<std::size_t> _bandwidth{0};
+        std::atomic<std::size_t> _connections{0};
+        std::atomic<std::size_t> _requests{0};
+
+        std::map<std::string, std::string, std::less<>> _users;
+        std::map<std::string, table_data, std::less<>> _tables;
+        std::map<std::string, handler, std::less<>> _handlers;
+
+        std::mutex _mtx;
+        std::condition_variable _finished;
+        std::vector<impl::socket::handle> _open;
+        std::size_t _active = 0;
+        std::thread _acceptor;
+    };
+}
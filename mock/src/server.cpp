@@ -0,0 +1,565 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+// stdlib
+#include <algorithm>
+#include <exception>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <vector>
+
+// project
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/impl/length_codec.hpp>
+#include <mikrotik/api/mock/server.hpp>
+
+#ifdef _WIN32
+#    define MOCK_SHUT_RDWR SD_BOTH
+#    define MOCK_NOSIGNAL 0
+#    define MOCK_POLL WSAPoll
+#    define MOCK_CLOSE closesocket
+using mock_socklen = int;
+using mock_size = int;
+#else
+#    include <netinet/tcp.h>
+
+#    define MOCK_SHUT_RDWR SHUT_RDWR
+#    ifdef MSG_NOSIGNAL
+#        define MOCK_NOSIGNAL MSG_NOSIGNAL
+#    else
+#        define MOCK_NOSIGNAL 0
+#    endif
+#    define MOCK_POLL ::poll
+#    define MOCK_CLOSE ::close
+using mock_socklen = socklen_t;
+using mock_size = std::size_t;
+#endif
+
+namespace sock = mikrotik::api::impl::socket;
+namespace mock = mikrotik::api::mock;
+using clock_type = std::chrono::steady_clock;
+
+namespace {
+    // the replies of a print are sent once this much of them is waiting
+    constexpr const std::size_t flush_size = 64 * 1024;
+
+    std::string_view
+    type_word(mikrotik::api::reply::type type) noexcept {
+        switch (type) {
+        case mikrotik::api::reply::trap: return "!trap";
+        case mikrotik::api::reply::fatal: return "!fatal";
+        case mikrotik::api::reply::re: return "!re";
+        default: return "!done";
+        }
+    }
+
+    // appends a word made up of the given parts
+    void
+    append_word(std::string& out, std::initializer_list<std::string_view> parts) {
+        std::size_t size = 0;
+        for (auto part : parts) {
+            size += part.size();
+        }
+
+        auto pos = out.size();
+        out.resize(pos + mikrotik::api::impl::max_length_size);
+        out.resize(pos + mikrotik::api::impl::encode_length(size, out.data() + pos));
+        for (auto part : parts) {
+            out += part;
+        }
+    }
+
+    void
+    end_sentence(std::string& out, const mock::request& req) {
+        if (auto tag = req.tag())
+            append_word(out, {".tag=", *tag});
+        out += '\0';
+    }
+
+    void
+    append_reply(std::string& out, const mikrotik::api::reply& rep, const mock::request& req) {
+        append_word(out, {type_word(rep.reply_type)});
+        for (const auto& attr : rep.attributes) {
+            append_word(out, {attr});
+        }
+        end_sentence(out, req);
+    }
+
+    void
+    append_trap(std::string& out, std::string_view message, const mock::request& req) {
+        append_word(out, {"!trap"});
+        append_word(out, {"=message=", message});
+        end_sentence(out, req);
+        append_word(out, {"!done"});
+        end_sentence(out, req);
+    }
+
+    // checks a single query word, without its ? prefix, against a row
+    bool
+    matches(const mock::row& row, std::string_view query) {
+        auto find = [&row](std::string_view name) {
+            return std::find_if(row.begin(), row.end(), [name](const auto& attr) {
+                return attr.first == name;
+            });
+        };
+
+        if (query[0] == '-')
+            return find(query.substr(1)) == row.end();
+
+        auto eq = query.find('=');
+        if (eq == std::string_view::npos)
+            return find(query) != row.end();
+        auto it = find(query.substr(0, eq));
+        return it != row.end() && it->second == query.substr(eq + 1);
+    }
+
+    bool
+    in_proplist(std::string_view proplist, std::string_view name) noexcept {
+        while (!proplist.empty()) {
+            auto comma = proplist.find(',');
+            if (proplist.substr(0, comma) == name)
+                return true;
+            if (comma == std::string_view::npos)
+                break;
+            proplist.remove_prefix(comma + 1);
+        }
+        return false;
+    }
+
+    bool
+    send_all(sock::handle sck, std::string_view data) noexcept {
+        while (!data.empty()) {
+            auto sent = ::send(sck, data.data(), static_cast<mock_size>(data.size()), MOCK_NOSIGNAL);
+            if (sent <= 0)
+                return false;
+            data.remove_prefix(static_cast<std::size_t>(sent));
+        }
+        return true;
+    }
+}
+
+struct mikrotik::api::mock::server::connection {
+    sock::handle sck = INVALID_SOCKET;
+    bool logged_in = false;
+    bool closed = false;
+
+    std::string in;
+    std::string out;
+
+    // the tags of the prints followed until cancelled
+    std::vector<std::string> following;
+
+    // replies are not sent before this
+    clock_type::time_point due;
+    // the start and the amount of bytes sent in the current period of sending
+    clock_type::time_point rate_start;
+    std::size_t rate_sent = 0;
+};
+
+std::string_view
+mikrotik::api::mock::request::command() const noexcept {
+    if (words.empty())
+        return {};
+    return words.front();
+}
+
+std::optional<std::string_view>
+mikrotik::api::mock::request::attribute(std::string_view name) const noexcept {
+    for (std::string_view word : words) {
+        if (word.size() > name.size() + 1
+            && word[0] == '='
+            && word.substr(1, name.size()) == name
+            && word[name.size() + 1] == '=')
+            return word.substr(name.size() + 2);
+    }
+    return std::nullopt;
+}
+
+std::optional<std::string_view>
+mikrotik::api::mock::request::tag() const noexcept {
+    for (std::string_view word : words) {
+        if (word.substr(0, 5) == ".tag=")
+            return word.substr(5);
+    }
+    return std::nullopt;
+}
+
+mikrotik::api::mock::server::server()
+     : server(0) { }
+
+mikrotik::api::mock::server::server(std::uint16_t port)
+     : _listener{INVALID_SOCKET} {
+#ifdef _WIN32
+    WSADATA wsa;
+    if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+        throw bad_socket("mock server: initializing WinSock failed");
+#endif
+    _users.emplace("admin", "");
+
+    _listener = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (_listener == INVALID_SOCKET)
+        throw bad_socket("mock server: creating listening socket failed");
+
+    int yes = 1;
+    ::setsockopt(_listener, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&yes), sizeof(yes));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    mock_socklen len = sizeof(addr);
+    if (::bind(_listener, reinterpret_cast<sockaddr*>(&addr), len) == SOCKET_ERROR
+        || ::listen(_listener, SOMAXCONN) == SOCKET_ERROR
+        || ::getsockname(_listener, reinterpret_cast<sockaddr*>(&addr), &len) == SOCKET_ERROR) {
+        MOCK_CLOSE(_listener);
+        throw bad_socket("mock server: could not listen on 127.0.0.1");
+    }
+    _port = ntohs(addr.sin_port);
+
+    _acceptor = std::thread([this] { accept_loop(); });
+}
+
+mikrotik::api::mock::server::~server() noexcept {
+    stop();
+    MOCK_CLOSE(_listener);
+#ifdef _WIN32
+    WSACleanup();
+#endif
+}
+
+mikrotik::api::ip_address
+mikrotik::api::mock::server::address() const {
+    return "127.0.0.1";
+}
+
+std::uint16_t
+mikrotik::api::mock::server::port() const noexcept {
+    return _port;
+}
+
+mikrotik::api::mock::server&
+mikrotik::api::mock::server::add_user(std::string name, std::string pass) {
+    _users[std::move(name)] = std::move(pass);
+    return *this;
+}
+
+mikrotik::api::mock::server&
+mikrotik::api::mock::server::table(std::string path, std::vector<row> rows) {
+    auto data = std::make_shared<const std::vector<row>>(std::move(rows));
+    return generate(std::move(path), data->size(), [data](std::size_t idx) {
+        return (*data)[idx];
+    });
+}
+
+mikrotik::api::mock::server&
+mikrotik::api::mock::server::generate(std::string path, std::size_t count, generator gen) {
+    _tables[std::move(path)] = table_data{count, std::move(gen)};
+    return *this;
+}
+
+mikrotik::api::mock::server&
+mikrotik::api::mock::server::on(std::string command, handler fn) {
+    _handlers[std::move(command)] = std::move(fn);
+    return *this;
+}
+
+mikrotik::api::mock::server&
+mikrotik::api::mock::server::latency(std::chrono::microseconds delay) noexcept {
+    _latency = delay.count();
+    return *this;
+}
+
+mikrotik::api::mock::server&
+mikrotik::api::mock::server::bandwidth(std::size_t bytes_per_second) noexcept {
+    _bandwidth = bytes_per_second;
+    return *this;
+}
+
+std::size_t
+mikrotik::api::mock::server::connections() const noexcept {
+    return _connections;
+}
+
+std::size_t
+mikrotik::api::mock::server::requests() const noexcept {
+    return _requests;
+}
+
+void
+mikrotik::api::mock::server::serve(impl::socket::handle sck) {
+    std::lock_guard lck(_mtx);
+    if (_stopping) {
+        MOCK_CLOSE(sck);
+        return;
+    }
+    _open.push_back(sck);
+    ++_active;
+    ++_connections;
+    std::thread([this, sck] { handle(sck); }).detach();
+}
+
+void
+mikrotik::api::mock::server::stop() noexcept {
+    if (_stopping.exchange(true))
+        return;
+
+    if (_acceptor.joinable())
+        _acceptor.join();
+
+    std::unique_lock lck(_mtx);
+    for (auto sck : _open) {
+        ::shutdown(sck, MOCK_SHUT_RDWR);
+    }
+    _finished.wait(lck, [this] { return _active == 0; });
+}
+
+void
+mikrotik::api::mock::server::accept_loop() {
+    pollfd pfd{};
+    pfd.fd = _listener;
+    pfd.events = POLLIN;
+    while (!_stopping) {
+        pfd.revents = 0;
+        if (MOCK_POLL(&pfd, 1, 50) <= 0)
+            continue;
+
+        auto sck = ::accept(_listener, nullptr, nullptr);
+        if (sck == INVALID_SOCKET)
+            continue;
+
+        int yes = 1;
+        ::setsockopt(sck, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&yes), sizeof(yes));
+        serve(sck);
+    }
+}
+
+void
+mikrotik::api::mock::server::handle(impl::socket::handle sck) {
+    connection conn;
+    conn.sck = sck;
+    char buf[16 * 1024];
+    request req;
+
+    while (!conn.closed && !_stopping) {
+        auto got = ::recv(sck, buf, sizeof(buf), 0);
+        if (got <= 0)
+            break;
+        conn.in.append(buf, static_cast<std::size_t>(got));
+        conn.due = clock_type::now() + std::chrono::microseconds(_latency.load());
+
+        // answer every complete sentence received so far, the words of an
+        // incomplete one are kept in req until the rest of it arrives
+        std::size_t pos = 0;
+        while (!conn.closed) {
+            std::size_t len = 0;
+            auto prefix = impl::decode_length(std::string_view(conn.in).substr(pos), len);
+            if (prefix == impl::bad_length) {
+                conn.closed = true;
+                break;
+            }
+            if (prefix == 0 || conn.in.size() - pos - prefix < len)
+                break;
+
+            pos += prefix;
+            if (len != 0) {
+                req.words.emplace_back(conn.in, pos, len);
+                pos += len;
+                continue;
+            }
+
+            answer(conn, req);
+            ++_requests;
+            req.words.clear();
+        }
+        conn.in.erase(0, pos);
+    }
+
+    std::lock_guard lck(_mtx);
+    _open.erase(std::find(_open.begin(), _open.end(), sck));
+    MOCK_CLOSE(sck);
+    --_active;
+    _finished.notify_all();
+}
+
+void
+mikrotik::api::mock::server::answer(connection& conn, const request& req) {
+    auto cmd = req.command();
+    if (auto it = _handlers.find(cmd); it != _handlers.end()) {
+        try {
+            auto reps = it->second(req);
+            for (const auto& rep : reps) {
+                append_reply(conn.out, rep, req);
+            }
+            if (cmd == "/login")
+                conn.logged_in = !reps.empty() && reps.back().reply_type == reply::done;
+        } catch (const std::exception& ex) {
+            append_trap(conn.out, ex.what(), req);
+        }
+    } else if (cmd == "/login") {
+        auto name = req.attribute("name");
+        auto pass = req.attribute("password");
+        auto user = name ? _users.find(*name) : _users.end();
+        conn.logged_in = user != _users.end() && user->second == pass.value_or("");
+        if (conn.logged_in) {
+            append_word(conn.out, {"!done"});
+            end_sentence(conn.out, req);
+        } else {
+            append_trap(conn.out, "invalid user name or password (6)", req);
+        }
+    } else if (cmd == "/quit") {
+        append_word(conn.out, {"!fatal"});
+        append_word(conn.out, {"session terminated on request"});
+        end_sentence(conn.out, req);
+        flush(conn);
+        conn.closed = true;
+        return;
+    } else if (!conn.logged_in) {
+        append_trap(conn.out, "not logged in", req);
+    } else if (cmd == "/cancel") {
+        cancel(conn, req);
+    } else if (auto table = _tables.find(cmd.substr(0, cmd.rfind('/')));
+               cmd.size() > 6 && cmd.substr(cmd.size() - 6) == "/print" && table != _tables.end()) {
+        print(conn, req, table->second);
+    } else {
+        append_trap(conn.out, "no such command prefix", req);
+    }
+    flush(conn);
+}
+
+void
+mikrotik::api::mock::server::print(connection& conn, const request& req, const table_data& table) {
+    std::vector<std::string_view> queries;
+    for (std::string_view word : req.words) {
+        if (word.empty() || word[0] != '?')
+            continue;
+        word.remove_prefix(1);
+        if (word.empty() || word[0] == '<' || word[0] == '>' || word[0] == '#')
+            return append_trap(conn.out, "unsupported query", req);
+        queries.push_back(word);
+    }
+    auto proplist = req.attribute(".proplist");
+    auto count_only = req.attribute("count-only").has_value();
+    auto follow = req.attribute("follow").has_value() && !count_only;
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < table.count && !conn.closed; ++i) {
+        auto row = table.gen(i);
+        if (!std::all_of(queries.begin(), queries.end(), [&row](std::string_view query) {
+                return matches(row, query);
+            }))
+            continue;
+        ++count;
+        if (count_only)
+            continue;
+
+        append_word(conn.out, {"!re"});
+        for (const auto& [name, value] : row) {
+            if (!proplist || in_proplist(*proplist, name))
+                append_word(conn.out, {"=", name, "=", value});
+        }
+        end_sentence(conn.out, req);
+        if (conn.out.size() >= flush_size)
+            flush(conn);
+    }
+
+    if (follow) {
+        conn.following.emplace_back(req.tag().value_or(""));
+        return;
+    }
+    append_word(conn.out, {"!done"});
+    if (count_only)
+        append_word(conn.out, {"=ret=", std::to_string(count)});
+    end_sentence(conn.out, req);
+}
+
+void
+mikrotik::api::mock::server::cancel(connection& conn, const request& req) {
+    auto tag = req.attribute("tag");
+    for (auto it = conn.following.begin(); it != conn.following.end();) {
+        if (tag && *it != *tag) {
+            ++it;
+            continue;
+        }
+
+        request followed;
+        if (!it->empty())
+            followed.words.push_back(".tag=" + *it);
+        append_word(conn.out, {"!trap"});
+        append_word(conn.out, {"=category=2"});
+        append_word(conn.out, {"=message=interrupted"});
+        end_sentence(conn.out, followed);
+        append_word(conn.out, {"!done"});
+        end_sentence(conn.out, followed);
+        it = conn.following.erase(it);
+    }
+
+    append_word(conn.out, {"!done"});
+    end_sentence(conn.out, req);
+}
+
+void
+mikrotik::api::mock::server::flush(connection& conn) {
+    if (conn.out.empty() || conn.closed)
+        return;
+    std::this_thread::sleep_until(conn.due);
+
+    std::string_view data = conn.out;
+    auto bandwidth = _bandwidth.load();
+    if (bandwidth == 0) {
+        conn.closed = !send_all(conn.sck, data);
+        conn.out.clear();
+        return;
+    }
+
+    // bytes are sent in chunks of about 10ms worth, each one no earlier than
+    // the bandwidth allows since the link was last idle
+    auto sent_until = [&conn, bandwidth] {
+        auto secs = static_cast<double>(conn.rate_sent) / static_cast<double>(bandwidth);
+        return conn.rate_start + std::chrono::duration_cast<clock_type::duration>(std::chrono::duration<double>(secs));
+    };
+    if (sent_until() < clock_type::now()) {
+        conn.rate_start = clock_type::now();
+        conn.rate_sent = 0;
+    }
+
+    auto chunk = std::clamp<std::size_t>(bandwidth / 100, 512, flush_size);
+    while (!data.empty() && !conn.closed && !_stopping) {
+        auto part = data.substr(0, chunk);
+        std::this_thread::sleep_until(sent_until());
+        conn.closed = !send_all(conn.sck, part);
+        conn.rate_sent += part.size();
+        data.remove_prefix(part.size());
+    }
+    conn.out.clear();
+}
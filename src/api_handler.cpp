@@ -31,42 +31,56 @@
 // Created by bodand on 2020-06-24.
 //
 
+// stdlib
+#include <utility>
+
 // project
-#include "impl/calc_len.hpp"
 #include <mikrotik/api/impl/sockets.hpp>
 #include "impl/socket_funcs.hpp"
 #include "lib/fmt.hpp"
 #include <mikrotik/api/api_handler.hpp>
-#include <mikrotik/api/command.hpp>
 #include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/exception/socket_timeout.hpp>
 namespace sock = mikrotik::api::impl::socket;
-using namespace mikrotik::api::literals;
 
 mikrotik::api::api_handler::api_handler(ip_address address,
                                         std::string_view user,
-                                        std::string_view pass)
-     : _sock{INVALID_SOCKET} {
+                                        std::string_view pass,
+                                        std::uint16_t port,
+                                        const timeouts& limits)
+     : _sock{INVALID_SOCKET},
+       _timeouts{limits} {
     initialize_sockets();
-    mk_socket();
-    connect_to_device(address);
-    login(user, pass);
+    try {
+        mk_socket();
+        connect_to_device(address, port);
+        login(user, pass);
+    } catch (...) {
+        // the destructor does not run if the constructor throws
+        disconnect();
+        throw;
+    }
 }
 
-sockaddr
-mikrotik::api::api_handler::mk_addr(const mikrotik::api::ip_address& address) const {
-    sockaddr_in addr;
-    addr.sin_family = AF_INET;
-    if (inet_pton(AF_INET, address.render().c_str(), &addr.sin_addr.s_addr) != 1)
-        throw bad_socket(fmt::format("unable to create address structure to IP address: {}",
-                                     sock::string_error(sock::get_last_error())));
-    // ^^ Microsoft going around deprecating POSIX functions damn it:
-    // inet_addr is deprecated on MSVC
-    addr.sin_port = htons(static_cast<std::uint16_t>(8728));
-
-    sockaddr ret;
-    std::memcpy(&ret, &addr, sizeof(sockaddr));
+mikrotik::api::api_handler::api_handler(impl::socket::handle sock,
+                                        protocol&& proto,
+                                        const timeouts& limits)
+     : _sock{sock},
+       _proto{std::move(proto)},
+       _timeouts{limits} {
+    try {
+        // the socket may be non-blocking from connecting, only keep it so if required
+        set_timeouts(limits);
+    } catch (...) {
+        disconnect();
+        throw;
+    }
+}
 
-    return ret;
+sockaddr
+mikrotik::api::api_handler::mk_addr(const mikrotik::api::ip_address& address,
+                                    std::uint16_t port) const {
+    return sock::make_address(address, port);
 }
 
 int
@@ -85,41 +99,96 @@ mikrotik::api::api_handler::~api_handler() noexcept {
 }
 
 void
-mikrotik::api::api_handler::send_word(std::string_view word) {
-    auto sent = impl::calc_len(word) + word.data();
-    ::send(_sock, sent.c_str(), sent.size(), 0);
+mikrotik::api::api_handler::set_timeouts(const timeouts& limits) {
+    // with a limit the socket is non-blocking, so waiting can be done with a timeout
+    if (sock::set_nonblocking(_sock, limits.operation.count() > 0) != 0)
+        throw bad_socket(fmt::format("changing socket mode failed: {}",
+                                     sock::string_error(sock::get_last_error())));
+    _timeouts = limits;
 }
 
-std::int32_t
-mikrotik::api::api_handler::read_len() {
-    // we work as if big-endian because thankfully the Internet is big-endian
-    // and in the end we convert because that's more likely than
-    // being on a big-endian machine
+const mikrotik::api::timeouts&
+mikrotik::api::api_handler::get_timeouts() const noexcept {
+    return _timeouts;
+}
 
-    std::int32_t len = 0;
-    auto len_alias = reinterpret_cast<char*>(&len);
+void
+mikrotik::api::api_handler::start(std::string_view operation, std::chrono::milliseconds limit) {
+    // the login has a single deadline for all of its operations
+    if (_logging_in)
+        return;
+    _operation = operation;
+    _limit = limit;
+    if (limit.count() > 0)
+        _deadline = std::chrono::steady_clock::now() + limit;
+}
 
-    recv(_sock, &len_alias[0], 1, 0);
-    if ((len_alias[0] & 0xE0) == 0xE0) {// 4 bytes
-        len_alias[0] &= 0b0001'1111;    // ~0xE0
-        recv(_sock, &len_alias[1], 3, 0);
+void
+mikrotik::api::api_handler::wait(short events) {
+    int timeout = -1;
+    if (_limit.count() > 0) {
+        auto left = std::chrono::ceil<std::chrono::milliseconds>(_deadline - std::chrono::steady_clock::now());
+        if (left.count() <= 0)
+            throw socket_timeout(_operation, _limit);
+        timeout = static_cast<int>(left.count());
+    }
 
-        len = static_cast<std::int32_t>(ntohl(static_cast<unsigned long>(len)));
+    pollfd pfd{};
+    pfd.fd = _sock;
+    pfd.events = events;
+    auto ready = sock::poll(&pfd, 1, timeout);
+    if (ready == SOCKET_ERROR)
+        throw bad_socket(fmt::format("failure while {}: {}",
+                                     _operation,
+                                     sock::string_error(sock::get_last_error())));
+    if (ready == 0)
+        throw socket_timeout(_operation, _limit);
+}
 
-    } else if ((len_alias[0] & 0xC0) == 0xC0) {// 3 bytes
-        len_alias[0] &= 0b0011'1111;           // ~0xC0
-        recv(_sock, &len_alias[1], 2, 0);
+void
+mikrotik::api::api_handler::flush() {
+    start("sending a sentence", _timeouts.operation);
+    try {
+        for (auto out = _proto.next_output(); !out.empty(); out = _proto.next_output()) {
+            auto sent = sock::send(_sock, out.bufs, out.count);
+            if (sent == SOCKET_ERROR) {
+                auto err = sock::get_last_error();
+                if (sock::would_block(err)) {
+                    wait(POLLOUT);
+                    continue;
+                }
+                throw bad_socket(fmt::format("failure while sending sentence: {}",
+                                             sock::string_error(err)));
+            }
 
-        auto swapped = static_cast<std::int32_t>(ntohl(static_cast<unsigned long>(len)));
-        len >>= 8 * (((char*) &len)[0] != ((char*) &swapped)[0]);
+            // retry with the rest if the write was short
+            _proto.consume_output(static_cast<std::size_t>(sent));
+        }
+    } catch (...) {
+        // the buffers point into the sentence, which may be gone by the next send
+        _proto.discard_output();
+        throw;
+    }
+}
 
-    } else if ((len_alias[0] & 0x80) == 0x80) {// 2 bytes
-        len_alias[0] &= 0b0111'1111;           // ~0x80
-        recv(_sock, &len_alias[1], 1, 0);
+void
+mikrotik::api::api_handler::fill() {
+    // read as much as fits, so following words are likely already buffered
+    auto buf = _proto.prepare_input(_proto.needed());
+    auto read = sock::recv(_sock, buf, _proto.input_space());
 
-        len = static_cast<std::int32_t>(ntohs(static_cast<unsigned short>(len)));
+    if (read == SOCKET_ERROR) {
+        auto err = sock::get_last_error();
+        if (sock::would_block(err))
+            return wait(POLLIN);
+        throw bad_socket(fmt::format("failure while reading {} bytes: {}",
+                                     _proto.needed(),
+                                     sock::string_error(err)));
     }
-    return len;
+    if (read == 0)
+        throw bad_socket("connection closed by the device");
+
+    _proto.commit_input(static_cast<std::size_t>(read));
 }
 
 void
@@ -139,80 +208,130 @@ mikrotik::api::api_handler::mk_socket() {
 }
 
 void
-mikrotik::api::api_handler::connect_to_device(const ip_address& address) {
-    auto addr = mk_addr(address);
-    auto conn = connect(_sock, &addr, sizeof(addr));
-    if (conn == SOCKET_ERROR)
+mikrotik::api::api_handler::connect_to_device(const ip_address& address, std::uint16_t port) {
+    auto addr = mk_addr(address, port);
+    auto limit = _timeouts.connect;
+    if (limit.count() > 0 && sock::set_nonblocking(_sock, true) != 0)
+        throw bad_socket(fmt::format("making socket non-blocking failed: {}",
+                                     sock::string_error(sock::get_last_error())));
+
+    auto err = sock::connect(_sock, addr) == SOCKET_ERROR ? sock::get_last_error() : 0;
+    if (err != 0 && limit.count() > 0 && (sock::in_progress(err) || sock::would_block(err))) {
+        // the connection is being established in the background, wait for it to finish
+        pollfd pfd{};
+        pfd.fd = _sock;
+        pfd.events = POLLOUT;
+        auto ready = sock::poll(&pfd, 1, static_cast<int>(limit.count()));
+        if (ready == 0)
+            throw socket_timeout(fmt::format("connecting to {}", address.render(port)), limit);
+        err = ready == SOCKET_ERROR ? sock::get_last_error() : sock::pending_error(_sock);
+    }
+    if (err != 0)
         throw bad_socket(fmt::format("could not connect to {}: {}",
-                                     address.render(8728),
+                                     address.render(port),
+                                     sock::string_error(err)));
+
+    // with a limit on the operations the socket stays non-blocking, so waiting
+    // can be done with a timeout
+    auto nonblocking = _timeouts.operation.count() > 0 || _timeouts.login.count() > 0;
+    if (sock::set_nonblocking(_sock, nonblocking) != 0)
+        throw bad_socket(fmt::format("changing socket mode failed: {}",
                                      sock::string_error(sock::get_last_error())));
 }
 
-std::string
-mikrotik::api::api_handler::read_word() {
-    std::int32_t len = read_len();
-    std::string word;
-
-    char buff[1024];
-    while (len > 0) {
-        auto to_read = len > 1024 ? 1024 : len;
+void
+mikrotik::api::api_handler::login(std::string_view usr, std::string_view passwd) {
+    if (_timeouts.login.count() > 0) {
+        start("logging in", _timeouts.login);
+        _logging_in = true;
+    }
+    _proto.login(usr, passwd);
+    flush();
+    start("reading a reply", _timeouts.operation);
+    while (_proto.next_event() != protocol::logged_in) {
+        fill();
+    }
+    _logging_in = false;
 
-        auto read = recv(_sock, buff, to_read, 0);
+    // only the operation limit is used from now on
+    if (_timeouts.login.count() > 0)
+        set_timeouts(_timeouts);
+}
 
-        if (read == SOCKET_ERROR)
-            throw bad_socket(fmt::format("failure while reading {} bytes with {} remaining from the word: {}",
-                                         to_read,
-                                         len,
-                                         sock::string_error(sock::get_last_error())));
+void
+mikrotik::api::api_handler::send(const mikrotik::api::sentence& snt) {
+    send(snt, {});
+}
 
-        word.append(buff, static_cast<unsigned>(read));
-        len -= read;
-    }
+void
+mikrotik::api::api_handler::send(const mikrotik::api::sentence& snt, std::string_view api_attr) {
+    _proto.send(snt, api_attr);
+    flush();
+}
 
-    return word;
+void
+mikrotik::api::api_handler::send(const mikrotik::api::prepared_sentence& snt) {
+    send(snt, {});
 }
 
 void
-mikrotik::api::api_handler::login(std::string_view usr, std::string_view passwd) {
-    auto comm = "login"_cmd
-           [{"name", usr}]
-           [{"password", passwd}];
-    send(comm);
-    auto rep = read();
-    if (rep.reply_type != rep.done)
-        throw bad_socket(fmt::format("error: could not log into device: {}", rep.attributes.back()));
+mikrotik::api::api_handler::send(const mikrotik::api::prepared_sentence& snt, std::string_view api_attr) {
+    _proto.send(snt, api_attr);
+    flush();
 }
 
 void
-mikrotik::api::api_handler::send(const mikrotik::api::sentence& snt) {
-    for (const auto& word : snt.words()) {
-        send_word(word);
-    }
-    send_word("");
+mikrotik::api::api_handler::send_encoded(std::string_view bytes) {
+    _proto.send_encoded(bytes);
+    flush();
 }
 
 mikrotik::api::reply
 mikrotik::api::api_handler::read() {
+    const auto& view = read_view();
+
     reply rep;
+    rep.reply_type = view.reply_type;
+    rep.attributes.assign(view.attributes.begin(), view.attributes.end());
+    return rep;
+}
 
-    std::string word;
-    while (!(word = read_word()).empty()) {
-        if (word == "!done") {
-            rep.reply_type = reply::done;
-            continue;
-        } else if (word == "!trap") {
-            rep.reply_type = reply::trap;
-            continue;
-        } else if (word == "!fatal") {
-            rep.reply_type = reply::fatal;
-            continue;
-        } else if (word == "!re") {
-            rep.reply_type = reply::re;
-            continue;
-        }
+void
+mikrotik::api::api_handler::read(pmr::reply& rep) {
+    const auto& view = read_view();
 
-        rep.attributes.push_back(word);
-    }
+    rep.reply_type = view.reply_type;
+    rep.attributes.assign(view.attributes.begin(), view.attributes.end());
+}
 
+mikrotik::api::pmr::reply
+mikrotik::api::api_handler::read_pmr() {
+    pmr::reply rep(_resource);
+    read(rep);
     return rep;
 }
+
+void
+mikrotik::api::api_handler::set_memory_resource(std::pmr::memory_resource* resource) noexcept {
+    _resource = resource;
+}
+
+std::pmr::memory_resource*
+mikrotik::api::api_handler::memory_resource() const noexcept {
+    return _resource;
+}
+
+mikrotik::api::row_stream
+mikrotik::api::api_handler::stream(const sentence& snt) {
+    return row_stream(*this, snt);
+}
+
+const mikrotik::api::reply_view&
+mikrotik::api::api_handler::read_view() {
+    start("reading a reply", _timeouts.operation);
+    // only touch the socket if the buffered bytes do not contain a sentence
+    while (_proto.next_event() == protocol::need_input) {
+        fill();
+    }
+    return _proto.view();
+}
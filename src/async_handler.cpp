@@ -0,0 +1,277 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik/api/async_handler.hpp>
+
+// stdlib
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+// {fmt}
+#include "lib/fmt.hpp"
+
+// project
+#include "impl/socket_funcs.hpp"
+#include <mikrotik/api/attribute_map.hpp>
+#include <mikrotik/api/exception/bad_command.hpp>
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/exception/socket_timeout.hpp>
+namespace sock = mikrotik::api::impl::socket;
+
+namespace {
+    constexpr const std::string_view tag_word = ".tag=";
+
+    bool
+    is_tag(std::string_view word) noexcept {
+        return word.substr(0, tag_word.size()) == tag_word;
+    }
+
+    // the tag is only used to route the reply, so it is left out
+    mikrotik::api::reply
+    to_reply(const mikrotik::api::reply_view& view) {
+        mikrotik::api::reply rep;
+        rep.reply_type = view.reply_type;
+        rep.attributes.reserve(view.attributes.size());
+        for (auto word : view.attributes) {
+            if (!is_tag(word))
+                rep.attributes.emplace_back(word);
+        }
+        return rep;
+    }
+
+    [[noreturn]] void
+    throw_error(const mikrotik::api::reply_view& view) {
+        if (view.reply_type == view.trap) {
+            mikrotik::api::attribute_map attrs(view);
+            throw mikrotik::api::bad_command(attrs.get("message").value_or("unknown error"));
+        }
+        throw mikrotik::api::bad_socket(fmt::format("the device closed the connection: {}",
+                                                    view.attributes.empty() ? "" : view.attributes.back()));
+    }
+}
+
+mikrotik::api::async_handler::async_handler(event_loop& loop) noexcept
+     : _loop(loop) { }
+
+mikrotik::api::async_handler::~async_handler() noexcept {
+    disconnect();
+}
+
+int
+mikrotik::api::async_handler::disconnect() noexcept {
+    int ret = 0;
+    if (sock::is_valid(_sock)) {
+        ret = sock::close(_sock);
+    }
+    _sock = INVALID_SOCKET;
+    return ret;
+}
+
+mikrotik::api::task<void>
+mikrotik::api::async_handler::connect(ip_address address,
+                                      std::string user,
+                                      std::string pass,
+                                      std::uint16_t port,
+                                      const timeouts& limits) {
+    disconnect();
+    _proto = protocol{};
+    _timeouts = limits;
+    _logging_in = false;
+
+    _sock = sock::create(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (!sock::is_valid(_sock))
+        throw bad_socket(fmt::format("creating socket failed: {}",
+                                     sock::string_error(sock::get_last_error())));
+    if (sock::set_nonblocking(_sock, true) != 0)
+        throw bad_socket(fmt::format("making socket non-blocking failed: {}",
+                                     sock::string_error(sock::get_last_error())));
+
+    auto addr = sock::make_address(address, port);
+    if (::connect(_sock, &addr, sizeof(addr)) == SOCKET_ERROR) {
+        auto err = sock::get_last_error();
+        if (sock::in_progress(err)) {
+            auto limit = _timeouts.connect;
+            auto until = limit.count() > 0 ? event_loop::clock::now() + limit
+                                           : event_loop::clock::time_point::max();
+            if (!co_await _loop.writable(_sock, until))
+                throw socket_timeout(fmt::format("connecting to {}", address.render(port)), limit);
+            err = sock::pending_error(_sock);
+        }
+        if (err != 0)
+            throw bad_socket(fmt::format("could not connect to {}: {}",
+                                         address.render(port),
+                                         sock::string_error(err)));
+    }
+
+    if (_timeouts.login.count() > 0) {
+        start("logging in", _timeouts.login);
+        _logging_in = true;
+    }
+    _proto.login(user, pass);
+    co_await flush();
+    while (co_await receive() != protocol::logged_in) { }
+    _logging_in = false;
+}
+
+mikrotik::api::task<std::vector<mikrotik::api::reply>>
+mikrotik::api::async_handler::execute(sentence snt) {
+    auto tag = co_await send(snt);
+
+    std::vector<reply> replies;
+    for (;;) {
+        auto view = co_await read_view(tag);
+        if (view->reply_type == view->trap || view->reply_type == view->fatal)
+            throw_error(*view);
+
+        replies.push_back(to_reply(*view));
+        if (view->reply_type == view->done)
+            co_return replies;
+    }
+}
+
+mikrotik::api::async_generator<mikrotik::api::reply>
+mikrotik::api::async_handler::rows(sentence snt) {
+    auto tag = co_await send(snt);
+
+    for (;;) {
+        auto view = co_await read_view(tag);
+        if (view->reply_type == view->done)
+            co_return;
+        if (view->reply_type != view->re)
+            throw_error(*view);
+
+        co_yield to_reply(*view);
+    }
+}
+
+mikrotik::api::task<std::uint32_t>
+mikrotik::api::async_handler::send(const sentence& snt) {
+    auto tag = _next_tag++;
+    if (_next_tag == 0)
+        _next_tag = 1;
+
+    char word[tag_word.size() + 10];
+    std::memcpy(word, tag_word.data(), tag_word.size());
+    auto [end, _] = std::to_chars(word + tag_word.size(), word + sizeof(word), tag);
+
+    _proto.send(snt, {word, static_cast<std::size_t>(end - word)});
+    co_await flush();
+    co_return tag;
+}
+
+mikrotik::api::task<void>
+mikrotik::api::async_handler::flush() {
+    start("sending a sentence", _timeouts.operation);
+    for (auto out = _proto.next_output(); !out.empty(); out = _proto.next_output()) {
+        auto sent = sock::send(_sock, out.bufs, out.count);
+        if (sent == SOCKET_ERROR) {
+            auto err = sock::get_last_error();
+            if (!sock::would_block(err)) {
+                // the buffers point into the sentence, which may be gone by the next send
+                _proto.discard_output();
+                throw bad_socket(fmt::format("failure while sending sentence: {}",
+                                             sock::string_error(err)));
+            }
+            if (!co_await _loop.writable(_sock, deadline())) {
+                _proto.discard_output();
+                throw socket_timeout(_operation, _limit);
+            }
+            continue;
+        }
+        _proto.consume_output(static_cast<std::size_t>(sent));
+    }
+}
+
+mikrotik::api::task<mikrotik::api::protocol::event>
+mikrotik::api::async_handler::receive() {
+    start("reading a reply", _timeouts.operation);
+    protocol::event ev;
+    while ((ev = _proto.next_event()) == protocol::need_input) {
+        auto buf = _proto.prepare_input(_proto.needed());
+        auto read = sock::recv(_sock, buf, _proto.input_space());
+        if (read == SOCKET_ERROR) {
+            auto err = sock::get_last_error();
+            if (!sock::would_block(err))
+                throw bad_socket(fmt::format("failure while reading: {}",
+                                             sock::string_error(err)));
+            if (!co_await _loop.readable(_sock, deadline()))
+                throw socket_timeout(_operation, _limit);
+            continue;
+        }
+        if (read == 0)
+            throw bad_socket("connection closed by the device");
+
+        _proto.commit_input(static_cast<std::size_t>(read));
+    }
+    co_return ev;
+}
+
+mikrotik::api::task<const mikrotik::api::reply_view*>
+mikrotik::api::async_handler::read_view(std::uint32_t tag) {
+    for (;;) {
+        co_await receive();
+        const auto& view = _proto.view();
+
+        // replies to sentences abandoned earlier are dropped, except for
+        // !fatal, which is never tagged
+        auto& attrs = view.attributes;
+        auto it = std::find_if(attrs.begin(), attrs.end(), is_tag);
+        if (it == attrs.end()) {
+            if (view.reply_type == view.fatal)
+                co_return &view;
+            continue;
+        }
+
+        std::uint32_t value = 0;
+        std::from_chars(it->data() + tag_word.size(), it->data() + it->size(), value);
+        if (value == tag)
+            co_return &view;
+    }
+}
+
+void
+mikrotik::api::async_handler::start(std::string_view operation, std::chrono::milliseconds limit) {
+    // the login has a single deadline for all of its operations
+    if (_logging_in)
+        return;
+    _operation = operation;
+    _limit = limit;
+    if (limit.count() > 0)
+        _deadline = event_loop::clock::now() + limit;
+}
+
+mikrotik::api::event_loop::clock::time_point
+mikrotik::api::async_handler::deadline() const noexcept {
+    return _limit.count() > 0 ? _deadline : event_loop::clock::time_point::max();
+}
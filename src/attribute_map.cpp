@@ -0,0 +1,141 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik/api/attribute_map.hpp>
+
+// stdlib
+#include <cstring>
+
+mikrotik::api::attribute_map::attribute_map(const reply& rep) {
+    assign(rep);
+}
+
+mikrotik::api::attribute_map::attribute_map(const reply_view& rep) {
+    assign(rep);
+}
+
+void
+mikrotik::api::attribute_map::assign(const reply& rep) {
+    index(rep.attributes.begin(), rep.attributes.end());
+}
+
+void
+mikrotik::api::attribute_map::assign(const reply_view& rep) {
+    index(rep.attributes.begin(), rep.attributes.end());
+}
+
+template<class It>
+void
+mikrotik::api::attribute_map::index(It beg, It end) {
+    _entries.clear();
+    for (; beg != end; ++beg) {
+        add(*beg);
+    }
+
+    // keep the load factor at or below one half, and the size a power of two
+    // so the hash can be masked into the table
+    std::size_t size = 8;
+    while (size < 2 * _entries.size())
+        size *= 2;
+    _slots.assign(size, 0);
+
+    auto mask = size - 1;
+    for (std::uint32_t i = 0; i < _entries.size(); ++i) {
+        auto slot = _entries[i].hash & mask;
+        while (_slots[slot] != 0) {
+            if (_entries[_slots[slot] - 1].name == _entries[i].name)
+                break;// first one wins on duplicate names
+            slot = (slot + 1) & mask;
+        }
+        if (_slots[slot] == 0)
+            _slots[slot] = i + 1;
+    }
+}
+
+void
+mikrotik::api::attribute_map::add(std::string_view word) {
+    // =<name>=<value> or .<name>=<value>
+    if (word.size() < 2)
+        return;
+
+    std::size_t name_beg;
+    if (word[0] == '=') {
+        name_beg = 1;
+    } else if (word[0] == '.') {
+        name_beg = 0;
+    } else {
+        return;
+    }
+
+    // memchr is vectorized by any decent libc, so this is faster than a loop
+    auto sep = static_cast<const char*>(std::memchr(word.data() + 1, '=', word.size() - 1));
+    if (sep == nullptr)
+        return;
+
+    auto name_end = static_cast<std::size_t>(sep - word.data());
+    auto name = word.substr(name_beg, name_end - name_beg);
+    _entries.push_back({name,
+                        word.substr(name_end + 1),
+                        key::hash_of(name)});
+}
+
+const mikrotik::api::attribute_map::entry*
+mikrotik::api::attribute_map::find(key name) const noexcept {
+    if (_slots.empty())
+        return nullptr;
+
+    auto mask = _slots.size() - 1;
+    for (auto slot = name.hash & mask; _slots[slot] != 0; slot = (slot + 1) & mask) {
+        const auto& ent = _entries[_slots[slot] - 1];
+        if (ent.hash == name.hash && ent.name == name.name)
+            return &ent;
+    }
+    return nullptr;
+}
+
+std::optional<std::string_view>
+mikrotik::api::attribute_map::get(key name) const noexcept {
+    if (auto ent = find(name))
+        return ent->value;
+    return std::nullopt;
+}
+
+bool
+mikrotik::api::attribute_map::contains(key name) const noexcept {
+    return find(name) != nullptr;
+}
+
+std::size_t
+mikrotik::api::attribute_map::size() const noexcept {
+    return _entries.size();
+}
@@ -0,0 +1,283 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik/api/bootstrap.hpp>
+
+// stdlib
+#include <algorithm>
+#include <utility>
+
+// {fmt}
+#include "lib/fmt.hpp"
+
+// project
+#include "impl/poller.hpp"
+#include "impl/socket_funcs.hpp"
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/exception/socket_timeout.hpp>
+#include <mikrotik/api/protocol.hpp>
+namespace sock = mikrotik::api::impl::socket;
+
+namespace mikrotik::api::impl {
+    // a device being connected to and logged into
+    struct connector {
+        using clock = std::chrono::steady_clock;
+
+        enum class state {
+            connecting,
+            logging_in
+        };
+
+        connector(std::size_t index, const endpoint& dev)
+             : index{index},
+               dev{dev} { }
+
+        connector(const connector&) = delete;
+        connector& operator=(const connector&) = delete;
+
+        ~connector() noexcept {
+            if (sock::is_valid(sck)) {
+                sock::close(sck);
+                sock::finish();
+            }
+        }
+
+        // starts connecting, returns whether the connection was established already
+        bool connect(const timeouts& limits) {
+            if (sock::init() != 0)
+                throw bad_socket(fmt::format("initialization failed: {}",
+                                             sock::string_error(sock::get_last_error())));
+            sck = sock::create(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            if (!sock::is_valid(sck))
+                throw bad_socket(fmt::format("creating socket failed: {}",
+                                             sock::string_error(sock::get_last_error())));
+            if (sock::set_nonblocking(sck, true) != 0)
+                throw bad_socket(fmt::format("making socket non-blocking failed: {}",
+                                             sock::string_error(sock::get_last_error())));
+
+            expire(limits.connect);
+            if (sock::connect(sck, sock::make_address(dev.address, dev.port)) != SOCKET_ERROR)
+                return true;
+            auto err = sock::get_last_error();
+            if (sock::in_progress(err) || sock::would_block(err))
+                return false;
+            throw bad_socket(fmt::format("could not connect to {}: {}",
+                                         dev.address.render(dev.port),
+                                         sock::string_error(err)));
+        }
+
+        void connected() {
+            auto err = sock::pending_error(sck);
+            if (err != 0)
+                throw bad_socket(fmt::format("could not connect to {}: {}",
+                                             dev.address.render(dev.port),
+                                             sock::string_error(err)));
+        }
+
+        void login(const timeouts& limits) {
+            st = state::logging_in;
+            expire(limits.login);
+            proto.login(dev.user, dev.pass);
+            flush();
+        }
+
+        void flush() {
+            for (auto out = proto.next_output(); !out.empty(); out = proto.next_output()) {
+                auto sent = sock::send(sck, out.bufs, out.count);
+                if (sent == SOCKET_ERROR) {
+                    auto err = sock::get_last_error();
+                    if (sock::would_block(err))
+                        return;
+                    throw bad_socket(fmt::format("failure while sending sentence: {}",
+                                                 sock::string_error(err)));
+                }
+                proto.consume_output(static_cast<std::size_t>(sent));
+            }
+        }
+
+        // returns whether the login completed
+        bool receive() {
+            auto buf = proto.prepare_input(proto.needed());
+            auto read = sock::recv(sck, buf, proto.input_space());
+            if (read == SOCKET_ERROR) {
+                auto err = sock::get_last_error();
+                if (sock::would_block(err))
+                    return false;
+                throw bad_socket(fmt::format("failure while reading: {}", sock::string_error(err)));
+            }
+            if (read == 0)
+                throw bad_socket("connection closed by the device");
+            proto.commit_input(static_cast<std::size_t>(read));
+            return proto.next_event() == protocol::logged_in;
+        }
+
+        unsigned events() const noexcept {
+            if (st == state::connecting)
+                return poller::writable;
+            return proto.next_output().empty() ? poller::readable
+                                               : poller::readable | poller::writable;
+        }
+
+        [[noreturn]] void time_out() const {
+            if (st == state::connecting)
+                throw socket_timeout(fmt::format("connecting to {}", dev.address.render(dev.port)), limit);
+            throw socket_timeout("logging in", limit);
+        }
+
+        std::unique_ptr<api_handler> adopt(const timeouts& limits) {
+            auto api = std::unique_ptr<api_handler>(new api_handler(sck, std::move(proto), limits));
+            sck = INVALID_SOCKET;
+            return api;
+        }
+
+        std::size_t index;
+        const endpoint& dev;
+        socket::handle sck = INVALID_SOCKET;
+        protocol proto;
+        state st = state::connecting;
+        std::chrono::milliseconds limit{0};
+        clock::time_point deadline = clock::time_point::max();
+
+    private:
+        void expire(std::chrono::milliseconds after) noexcept {
+            limit = after;
+            deadline = after.count() > 0 ? clock::now() + after : clock::time_point::max();
+        }
+    };
+}
+
+void
+mikrotik::api::bootstrap(const std::vector<endpoint>& devices,
+                         const bootstrap_callback& done,
+                         const bootstrap_options& opts) {
+    using impl::connector;
+    using clock = connector::clock;
+
+    impl::poller poll;
+    std::vector<std::unique_ptr<connector>> active;
+    std::vector<impl::poller::event> ready;
+    auto max_in_flight = std::max<std::size_t>(opts.max_in_flight, 1);
+    std::size_t next = 0;
+
+    // removes the device from the ones in flight before reporting it, so an
+    // exception from the callback leaves nothing behind but the ones in flight,
+    // which are closed by their destructors, just like failed ones
+    auto finish = [&](connector* conn, bootstrap_result&& res) {
+        auto idx = conn->index;
+        auto it = std::find_if(active.begin(), active.end(), [conn](const auto& ptr) {
+            return ptr.get() == conn;
+        });
+        auto own = std::move(*it);
+        *it = std::move(active.back());
+        active.pop_back();
+        done(idx, std::move(res));
+    };
+    auto advance = [&](connector* conn, unsigned events) {
+        try {
+            if (conn->st == connector::state::connecting) {
+                conn->connected();
+                conn->login(opts.limits);
+            } else {
+                if (events & impl::poller::writable)
+                    conn->flush();
+                if ((events & (impl::poller::readable | impl::poller::failed)) && conn->receive()) {
+                    poll.remove(conn->sck);
+                    return finish(conn, {conn->adopt(opts.limits), nullptr});
+                }
+            }
+            poll.modify(conn->sck, conn->events(), conn);
+        } catch (const bad_socket&) {
+            poll.remove(conn->sck);
+            finish(conn, {nullptr, std::current_exception()});
+        }
+    };
+
+    while (next < devices.size() || !active.empty()) {
+        while (next < devices.size() && active.size() < max_in_flight) {
+            auto& conn = *active.emplace_back(std::make_unique<connector>(next, devices[next]));
+            ++next;
+            try {
+                if (conn.connect(opts.limits))
+                    conn.login(opts.limits);
+                poll.add(conn.sck, conn.events(), &conn);
+            } catch (const bad_socket&) {
+                finish(&conn, {nullptr, std::current_exception()});
+            }
+        }
+
+        auto deadline = clock::time_point::max();
+        for (const auto& conn : active) {
+            deadline = std::min(deadline, conn->deadline);
+        }
+        int timeout = -1;
+        if (deadline != clock::time_point::max()) {
+            auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - clock::now());
+            timeout = static_cast<int>(std::max<std::chrono::milliseconds::rep>(left.count(), 0));
+        }
+        if (active.empty())
+            continue;
+
+        poll.wait(ready, timeout);
+        for (auto [data, events] : ready) {
+            advance(static_cast<connector*>(data), events);
+        }
+
+        auto now = clock::now();
+        for (std::size_t i = 0; i < active.size();) {
+            auto conn = active[i].get();
+            if (conn->deadline > now) {
+                ++i;
+                continue;
+            }
+            try {
+                conn->time_out();
+            } catch (const socket_timeout&) {
+                poll.remove(conn->sck);
+                finish(conn, {nullptr, std::current_exception()});
+            }
+        }
+    }
+}
+
+std::vector<mikrotik::api::bootstrap_result>
+mikrotik::api::bootstrap(const std::vector<endpoint>& devices,
+                         const bootstrap_options& opts) {
+    std::vector<bootstrap_result> results(devices.size());
+    bootstrap(
+           devices,
+           [&results](std::size_t index, bootstrap_result&& result) {
+               results[index] = std::move(result);
+           },
+           opts);
+    return results;
+}
@@ -39,31 +39,16 @@
 
 std::string
 mikrotik::api::impl::calc_len(std::string_view str) {
-    auto len = str.size();
-    char* len_alias = (char*) &len;
-    char ret[sizeof(int)] = {'\0'};
+    char ret[max_length_size];
+    auto size = calc_len(str, ret);
+    return std::string(ret, size);
+}
+
+std::size_t
+mikrotik::api::impl::calc_len(std::string_view str, char* out) {
+    if (auto size = encode_length(str.size(), out))
+        return size;
 
-    if (len < 0x80) {// 1 byte
-        return std::string(1, (char) len);
-    }
-    if (len < 0x4000) {// 2 bytes
-        ret[0] = len_alias[1] | 0x80;
-        ret[1] = len_alias[0];
-        return std::string(ret, 2);
-    }
-    if (len < 0x200000) {// 3 bytes
-        ret[0] = len_alias[2] | 0xC0;
-        ret[1] = len_alias[1];
-        ret[2] = len_alias[0];
-        return std::string(ret, 3);
-    }
-    if (len < 0x10000000) {// 4 bytes
-        ret[0] = len_alias[3] | 0xE0;
-        ret[1] = len_alias[2];
-        ret[2] = len_alias[1];
-        ret[3] = len_alias[0];
-        return std::string(ret, 4);
-    }
     std::string short_str = fmt::format("{}..<{} other>..{}",
                                         str.substr(0, 4),
                                         str.size() - 8,
@@ -0,0 +1,438 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik/api/connection_manager.hpp>
+
+// stdlib
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <deque>
+#include <thread>
+#include <utility>
+
+// {fmt}
+#include "lib/fmt.hpp"
+
+// project
+#include "impl/reactor.hpp"
+#include "impl/socket_funcs.hpp"
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/exception/socket_timeout.hpp>
+#include <mikrotik/api/protocol.hpp>
+#include <mikrotik/api/reply_view.hpp>
+namespace sock = mikrotik::api::impl::socket;
+
+namespace {
+    using clock = std::chrono::steady_clock;
+}
+
+struct mikrotik::api::connection_manager::shard {
+    explicit shard(backend io)
+         : reactor{io == backend::poll ? impl::make_poll_reactor() : impl::make_reactor()} { }
+
+    // fails the connections past their deadline, and returns the time until the next
+    // deadline, to wait at most for, or -1 to wait forever
+    int expire();
+
+    std::unique_ptr<impl::reactor> reactor;
+    std::vector<connection*> conns;
+    std::vector<impl::reactor::completion> done;
+    std::exception_ptr error;
+};
+
+struct mikrotik::api::connection_manager::connection {
+    enum class state {
+        added,
+        connecting,
+        logging_in,
+        idle,
+        executing,
+        failed
+    };
+
+    struct command {
+        sentence snt;
+        completion done;
+    };
+
+    connection(ip_address address,
+               std::string user,
+               std::string pass,
+               std::uint16_t port,
+               const timeouts& limits)
+         : address{address},
+           port{port},
+           user{std::move(user)},
+           pass{std::move(pass)},
+           limits{limits} { }
+
+    connection(const connection&) = delete;
+    connection& operator=(const connection&) = delete;
+
+    ~connection() noexcept {
+        if (sock::is_valid(sck))
+            sock::close(sck);
+    }
+
+    void
+    start(shard& shrd) {
+        switch (st) {
+        case state::added: connect(shrd); break;
+        case state::idle: next(shrd); break;
+        case state::failed: abandon(shrd); break;
+        default: break;
+        }
+    }
+
+    void
+    on_complete(shard& shrd, const impl::reactor::completion& c) {
+        switch (st) {
+        case state::connecting:
+            if (c.error != 0)
+                return fail(shrd, bad_socket(fmt::format("could not connect to {}: {}",
+                                                         address.render(port),
+                                                         sock::string_error(c.error))));
+            return login(shrd);
+        case state::logging_in:
+        case state::executing:
+            if (writing)
+                return sent(shrd, c);
+            return received(shrd, c);
+        default:
+            return;
+        }
+    }
+
+    void
+    connect(shard& shrd) {
+        sck = sock::create(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (!sock::is_valid(sck))
+            return fail(shrd, bad_socket(fmt::format("creating socket failed: {}",
+                                                     sock::string_error(sock::get_last_error()))));
+        if (sock::set_nonblocking(sck, true) != 0)
+            return fail(shrd, bad_socket(fmt::format("making socket non-blocking failed: {}",
+                                                     sock::string_error(sock::get_last_error()))));
+
+        st = state::connecting;
+        expire(limits.connect);
+        shrd.reactor->connect(sck, sock::make_address(address, port), this);
+    }
+
+    void
+    login(shard& shrd) {
+        st = state::logging_in;
+        // the login has a single deadline, or the operation limit for each of its operations
+        expire(limits.login.count() > 0 ? limits.login : limits.operation);
+        proto.login(user, pass);
+        write(shrd);
+    }
+
+    void
+    next(shard& shrd) {
+        if (queue.empty()) {
+            expire(std::chrono::milliseconds{0});
+            return;
+        }
+        st = state::executing;
+        expire(limits.operation);
+        // the command stays at the front of the queue until completed, so its
+        // words can be sent from where they are
+        proto.send(queue.front().snt);
+        write(shrd);
+    }
+
+    void
+    write(shard& shrd) {
+        auto out = proto.next_output();
+        writing = true;
+        shrd.reactor->send(sck, out.bufs, out.count, this);
+    }
+
+    void
+    sent(shard& shrd, const impl::reactor::completion& c) {
+        if (c.error != 0)
+            return fail(shrd, bad_socket(fmt::format("failure while sending sentence: {}",
+                                                     sock::string_error(c.error))));
+
+        proto.consume_output(c.bytes);
+        if (!proto.next_output().empty())
+            return write(shrd);
+        writing = false;
+        if (st == state::executing || limits.login.count() == 0)
+            expire(limits.operation);
+        process(shrd);
+    }
+
+    void
+    received(shard& shrd, const impl::reactor::completion& c) {
+        if (c.error != 0)
+            return fail(shrd, bad_socket(fmt::format("failure while reading sentence: {}",
+                                                     sock::string_error(c.error))));
+        if (c.bytes == 0)
+            return fail(shrd, bad_socket("connection closed by the device"));
+
+        proto.commit_input(c.bytes);
+        process(shrd);
+    }
+
+    void
+    process(shard& shrd) {
+        try {
+            while ((st == state::logging_in || st == state::executing) && !writing) {
+                auto ev = proto.next_event();
+                if (ev == protocol::need_input) {
+                    auto buf = proto.prepare_input(proto.needed());
+                    return shrd.reactor->recv(sck, buf, proto.input_space(), this);
+                }
+                handle(shrd, ev);
+            }
+        } catch (const bad_socket&) {
+            fail(shrd, std::current_exception());
+        }
+    }
+
+    void
+    handle(shard& shrd, protocol::event ev) {
+        if (ev == protocol::logged_in) {
+            st = state::idle;
+            return next(shrd);
+        }
+
+        const auto& view = proto.view();
+        replies.push_back(to_reply(view));
+        if (view.reply_type == view.fatal)
+            return fail(shrd, bad_socket(fmt::format("the device closed the connection: {}",
+                                                     view.attributes.empty() ? "" : view.attributes.back())));
+        if (view.reply_type != view.done) {
+            // every reply sentence has the operation limit to arrive in
+            expire(limits.operation);
+            return;
+        }
+
+        auto cmd = std::move(queue.front());
+        queue.pop_front();
+        st = state::idle;
+        complete(shrd, cmd.done, nullptr);
+        next(shrd);
+    }
+
+    static reply
+    to_reply(const reply_view& view) {
+        reply rep;
+        rep.reply_type = view.reply_type;
+        rep.attributes.assign(view.attributes.begin(), view.attributes.end());
+        return rep;
+    }
+
+    void
+    expire(std::chrono::milliseconds limit) noexcept {
+        current_limit = limit;
+        deadline = limit.count() > 0 ? clock::now() + limit : clock::time_point::max();
+    }
+
+    void
+    time_out(shard& shrd) {
+        switch (st) {
+        case state::connecting:
+            return fail(shrd, socket_timeout(fmt::format("connecting to {}", address.render(port)),
+                                             current_limit));
+        case state::logging_in:
+            return fail(shrd, socket_timeout("logging in", current_limit));
+        default:
+            return fail(shrd, socket_timeout(writing ? "sending a sentence" : "reading a reply",
+                                             current_limit));
+        }
+    }
+
+    template<class Error>
+    void
+    fail(shard& shrd, const Error& err) {
+        fail(shrd, std::make_exception_ptr(err));
+    }
+
+    void
+    fail(shard& shrd, std::exception_ptr err) {
+        if (sock::is_valid(sck)) {
+            // cancels the operation in flight, if any
+            shrd.reactor->forget(sck);
+            sock::close(sck);
+        }
+        sck = INVALID_SOCKET;
+        st = state::failed;
+        writing = false;
+        expire(std::chrono::milliseconds{0});
+        error = std::move(err);
+        abandon(shrd);
+    }
+
+    void
+    abandon(shard& shrd) {
+        while (!queue.empty()) {
+            auto cmd = std::move(queue.front());
+            queue.pop_front();
+            complete(shrd, cmd.done, error);
+        }
+    }
+
+    void
+    complete(shard& shrd, completion& done, std::exception_ptr err) {
+        auto reps = std::exchange(replies, {});
+        try {
+            if (done)
+                done(std::move(reps), err);
+        } catch (...) {
+            if (!shrd.error)
+                shrd.error = std::current_exception();
+        }
+    }
+
+    ip_address address;
+    std::uint16_t port;
+    std::string user;
+    std::string pass;
+    timeouts limits;
+    clock::time_point deadline = clock::time_point::max();
+    std::chrono::milliseconds current_limit{0};
+    sock::handle sck = INVALID_SOCKET;
+    state st = state::added;
+    bool writing = false;
+    std::deque<command> queue;
+    std::vector<reply> replies;
+    std::exception_ptr error;
+    protocol proto;
+};
+
+int
+mikrotik::api::connection_manager::shard::expire() {
+    auto now = clock::now();
+    auto next = clock::time_point::max();
+    for (auto conn : conns) {
+        if (conn->deadline <= now) {
+            conn->time_out(*this);
+        } else {
+            next = std::min(next, conn->deadline);
+        }
+    }
+
+    if (next == clock::time_point::max())
+        return -1;
+    auto left = std::chrono::ceil<std::chrono::milliseconds>(next - now).count();
+    return static_cast<int>(std::min<decltype(left)>(left, INT_MAX));
+}
+
+mikrotik::api::connection_manager::connection_manager(std::size_t threads, backend io) {
+    if (sock::init() != 0)
+        throw bad_socket(fmt::format("initialization failed: {}",
+                                     sock::string_error(sock::get_last_error())));
+
+    if (threads == 0)
+        threads = 1;
+    _shards.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        _shards.push_back(std::make_unique<shard>(io));
+    }
+}
+
+mikrotik::api::connection_manager::~connection_manager() noexcept {
+    _shards.clear();
+    _conns.clear();
+    sock::finish();
+}
+
+mikrotik::api::connection_manager::connection_id
+mikrotik::api::connection_manager::add(ip_address address,
+                                       std::string user,
+                                       std::string pass,
+                                       std::uint16_t port,
+                                       const timeouts& limits) {
+    auto id = _conns.size();
+    _conns.push_back(std::make_unique<connection>(address, std::move(user), std::move(pass), port, limits));
+    _shards[id % _shards.size()]->conns.push_back(_conns.back().get());
+    return id;
+}
+
+void
+mikrotik::api::connection_manager::execute(connection_id conn, sentence snt, completion done) {
+    _conns.at(conn)->queue.push_back({std::move(snt), std::move(done)});
+}
+
+std::size_t
+mikrotik::api::connection_manager::size() const noexcept {
+    return _conns.size();
+}
+
+bool
+mikrotik::api::connection_manager::failed(connection_id conn) const noexcept {
+    return conn < _conns.size()
+           && _conns[conn]->st == connection::state::failed;
+}
+
+void
+mikrotik::api::connection_manager::run() {
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < _shards.size(); ++i) {
+        if (!_shards[i]->conns.empty())
+            threads.emplace_back([this, i] { run_shard(*_shards[i]); });
+    }
+    run_shard(*_shards[0]);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (auto& shrd : _shards) {
+        if (shrd->error)
+            std::rethrow_exception(std::exchange(shrd->error, nullptr));
+    }
+}
+
+void
+mikrotik::api::connection_manager::run_shard(shard& shrd) {
+    try {
+        for (auto conn : shrd.conns) {
+            conn->start(shrd);
+        }
+
+        // every connection with work to do has exactly one operation in flight,
+        // which is waited for until the earliest deadline of the connections
+        while (shrd.reactor->pending() > 0) {
+            shrd.reactor->wait(shrd.done, shrd.expire());
+            for (const auto& c : shrd.done) {
+                static_cast<connection*>(c.data)->on_complete(shrd, c);
+            }
+        }
+    } catch (...) {
+        if (!shrd.error)
+            shrd.error = std::current_exception();
+    }
+}
@@ -0,0 +1,397 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik/api/connection_pool.hpp>
+
+// stdlib
+#include <algorithm>
+#include <exception>
+#include <utility>
+#include <vector>
+
+// project
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/static_command.hpp>
+
+struct mikrotik::api::connection_pool::device {
+    struct idle_connection {
+        std::unique_ptr<api_handler> api;
+        clock::time_point since;
+    };
+
+    device(ip_address address, std::string_view user, std::string_view pass, std::uint16_t port)
+         : address{address},
+           user{user},
+           pass{pass},
+           port{port} { }
+
+    ip_address address;
+    std::string user;
+    std::string pass;
+    std::uint16_t port;
+
+    // the most recently returned is at the back
+    std::vector<idle_connection> idle;
+    std::size_t leased = 0;
+    std::size_t connecting = 0;
+    // acquire() calls waiting for a connection to be returned
+    std::size_t waiting = 0;
+    clock::time_point last_lease;
+
+    std::size_t size() const noexcept {
+        return idle.size() + leased + connecting;
+    }
+
+    // nothing refers to the device, so it may be removed from the pool
+    bool unused() const noexcept {
+        return size() == 0 && waiting == 0;
+    }
+};
+
+mikrotik::api::connection_pool::lease::lease(connection_pool& pool,
+                                             device& dev,
+                                             std::unique_ptr<api_handler> api) noexcept
+     : _pool{&pool},
+       _dev{&dev},
+       _api{std::move(api)},
+       _exceptions{std::uncaught_exceptions()} { }
+
+mikrotik::api::connection_pool::lease::lease(lease&& mv) noexcept
+     : _pool{mv._pool},
+       _dev{mv._dev},
+       _api{std::move(mv._api)},
+       _exceptions{mv._exceptions} { }
+
+mikrotik::api::connection_pool::lease&
+mikrotik::api::connection_pool::lease::operator=(lease&& mv) noexcept {
+    if (this != &mv) {
+        release();
+        _pool = mv._pool;
+        _dev = mv._dev;
+        _api = std::move(mv._api);
+        _exceptions = mv._exceptions;
+    }
+    return *this;
+}
+
+mikrotik::api::connection_pool::lease::~lease() noexcept {
+    release();
+}
+
+mikrotik::api::api_handler&
+mikrotik::api::connection_pool::lease::operator*() const noexcept {
+    return *_api;
+}
+
+mikrotik::api::api_handler*
+mikrotik::api::connection_pool::lease::operator->() const noexcept {
+    return _api.get();
+}
+
+void
+mikrotik::api::connection_pool::lease::discard() noexcept {
+    if (!_api)
+        return;
+    _api.reset();
+    _pool->forget(*_dev);
+}
+
+void
+mikrotik::api::connection_pool::lease::release() noexcept {
+    if (!_api)
+        return;
+    // a lease destroyed by an exception most likely saw the connection break
+    if (std::uncaught_exceptions() > _exceptions)
+        return discard();
+    _pool->give_back(*_dev, std::move(_api));
+}
+
+mikrotik::api::connection_pool::connection_pool(pool_options opts)
+     : _opts{opts} {
+    if (_opts.maintenance_interval.count() > 0)
+        _maintenance = std::thread([this] { run_maintenance(); });
+}
+
+mikrotik::api::connection_pool::~connection_pool() noexcept {
+    {
+        std::lock_guard lck(_mutex);
+        _stopping = true;
+    }
+    _stop.notify_all();
+    if (_maintenance.joinable())
+        _maintenance.join();
+}
+
+mikrotik::api::connection_pool::lease
+mikrotik::api::connection_pool::acquire(ip_address address,
+                                        std::string_view user,
+                                        std::string_view pass,
+                                        std::uint16_t port) {
+    auto key = address.render(port);
+    key += '\0';
+    key += user;
+    key += '\0';
+    key += pass;
+
+    std::unique_lock lck(_mutex);
+    auto& slot = _devices[key];
+    if (!slot)
+        slot = std::make_unique<device>(address, user, pass, port);
+    auto& dev = *slot;
+
+    for (;;) {
+        dev.last_lease = clock::now();
+        while (!dev.idle.empty()) {
+            auto conn = std::move(dev.idle.back());
+            dev.idle.pop_back();
+            if (clock::now() - conn.since <= _opts.validate_after) {
+                ++dev.leased;
+                return lease(*this, dev, std::move(conn.api));
+            }
+
+            // checked as connecting, so the limit is kept while not holding the lock
+            ++dev.connecting;
+            lck.unlock();
+            auto ok = alive(*conn.api);
+            if (!ok)
+                conn.api.reset();
+            lck.lock();
+            --dev.connecting;
+            if (ok) {
+                ++dev.leased;
+                return lease(*this, dev, std::move(conn.api));
+            }
+            _returned.notify_all();
+        }
+
+        if (_opts.max_per_device == 0 || dev.size() < _opts.max_per_device)
+            break;
+        ++dev.waiting;
+        _returned.wait(lck);
+        --dev.waiting;
+    }
+
+    ++dev.connecting;
+    lck.unlock();
+    try {
+        auto api = connect(dev);
+        lck.lock();
+        --dev.connecting;
+        ++dev.leased;
+        return lease(*this, dev, std::move(api));
+    } catch (...) {
+        if (!lck)
+            lck.lock();
+        --dev.connecting;
+        _returned.notify_all();
+        throw;
+    }
+}
+
+void
+mikrotik::api::connection_pool::maintain() {
+    struct check {
+        device* dev;
+        std::unique_ptr<api_handler> api;
+    };
+    std::vector<check> checks;
+    std::vector<std::pair<device*, std::size_t>> spares;
+
+    // idle connections are taken out of the pool while being checked, and the
+    // spares are counted as connecting while being connected, so the lock is not
+    // held during either
+    std::unique_lock lck(_mutex);
+    auto now = clock::now();
+    for (auto next = _devices.begin(); next != _devices.end();) {
+        auto entry = next++;
+        auto& dev = entry->second;
+        if (now - dev->last_lease > _opts.idle_timeout) {
+            dev->idle.clear();
+            // devices not used anymore would be kept forever otherwise
+            if (dev->unused())
+                _devices.erase(entry);
+            continue;
+        }
+
+        std::size_t checking = 0;
+        auto keep = dev->idle.begin();
+        for (auto it = dev->idle.begin(); it != dev->idle.end(); ++it) {
+            if (now - it->since > _opts.validate_after) {
+                checks.push_back({dev.get(), std::move(it->api)});
+                ++checking;
+            } else {
+                *keep++ = std::move(*it);
+            }
+        }
+        dev->idle.erase(keep, dev->idle.end());
+        dev->connecting += checking;
+
+        // the connections being checked are likely to be fine, so they count as spares
+        auto ready = dev->idle.size() + checking;
+        if (ready >= _opts.warm_spares)
+            continue;
+        auto count = _opts.warm_spares - ready;
+        if (_opts.max_per_device != 0)
+            count = std::min(count, _opts.max_per_device - std::min(_opts.max_per_device, dev->size()));
+        if (count != 0) {
+            spares.emplace_back(dev.get(), count);
+            dev->connecting += count;
+        }
+    }
+    lck.unlock();
+
+    for (auto& chk : checks) {
+        auto ok = alive(*chk.api);
+        lck.lock();
+        --chk.dev->connecting;
+        if (ok)
+            chk.dev->idle.push_back({std::move(chk.api), clock::now()});
+        lck.unlock();
+        chk.api.reset();
+    }
+
+    for (auto [dev, count] : spares) {
+        for (std::size_t i = 0; i < count; ++i) {
+            std::unique_ptr<api_handler> api;
+            try {
+                api = connect(*dev);
+            } catch (const std::exception&) {
+                // the device is not reachable now, the next maintenance tries again
+            }
+            lck.lock();
+            --dev->connecting;
+            if (api)
+                dev->idle.push_back({std::move(api), clock::now()});
+            lck.unlock();
+        }
+    }
+    _returned.notify_all();
+}
+
+std::size_t
+mikrotik::api::connection_pool::idle() const {
+    std::lock_guard lck(_mutex);
+    std::size_t ret = 0;
+    for (const auto& [key, dev] : _devices) {
+        ret += dev->idle.size();
+    }
+    return ret;
+}
+
+std::size_t
+mikrotik::api::connection_pool::leased() const {
+    std::lock_guard lck(_mutex);
+    std::size_t ret = 0;
+    for (const auto& [key, dev] : _devices) {
+        ret += dev->leased;
+    }
+    return ret;
+}
+
+std::unique_ptr<mikrotik::api::api_handler>
+mikrotik::api::connection_pool::connect(const device& dev) const {
+    return std::make_unique<api_handler>(dev.address, dev.user, dev.pass, dev.port, _opts.limits);
+}
+
+bool
+mikrotik::api::connection_pool::alive(api_handler& api) const noexcept {
+    constexpr auto keep_alive = command_path("system", "identity", "print");
+    // a stale reply would be taken as the answer to the check
+    if (dirty(api))
+        return false;
+
+    auto limits = api.get_timeouts();
+    try {
+        auto check = limits;
+        check.operation = _opts.keep_alive_timeout;
+        api.set_timeouts(check);
+
+        // any complete answer does, even a !trap
+        api.send(keep_alive);
+        for (auto type = api.read_view().reply_type;
+             type != reply_view::done;
+             type = api.read_view().reply_type) {
+            if (type == reply_view::fatal)
+                return false;
+        }
+        api.set_timeouts(limits);
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+bool
+mikrotik::api::connection_pool::dirty(const api_handler& api) noexcept {
+    // unsent bytes would be sent before the next user's sentence, and unread
+    // replies would be read as the replies to it
+    const auto& proto = api._proto;
+    return !proto.next_output().empty()
+           || proto.outstanding() != 0
+           || proto.buffered_input() != 0;
+}
+
+void
+mikrotik::api::connection_pool::give_back(device& dev, std::unique_ptr<api_handler> api) noexcept {
+    if (dirty(*api))
+        return forget(dev);
+    {
+        std::lock_guard lck(_mutex);
+        --dev.leased;
+        dev.idle.push_back({std::move(api), clock::now()});
+    }
+    _returned.notify_one();
+}
+
+void
+mikrotik::api::connection_pool::forget(device& dev) noexcept {
+    {
+        std::lock_guard lck(_mutex);
+        --dev.leased;
+    }
+    _returned.notify_one();
+}
+
+void
+mikrotik::api::connection_pool::run_maintenance() noexcept {
+    std::unique_lock lck(_mutex);
+    while (!_stop.wait_for(lck, _opts.maintenance_interval, [this] { return _stopping; })) {
+        lck.unlock();
+        try {
+            maintain();
+        } catch (...) {
+            // the next round tries again
+        }
+        lck.lock();
+    }
+}
@@ -0,0 +1,73 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include "impl/encode_sentence.hpp"
+#include "impl/calc_len.hpp"
+
+void
+mikrotik::api::impl::encode_trailer(std::string_view api_attr, std::string& trailer) {
+    trailer.resize(max_length_size);
+    auto len = api_attr.empty() ? 0 : calc_len(api_attr, trailer.data());
+    trailer.resize(len);
+    trailer += api_attr;
+    trailer += '\0';
+}
+
+void
+mikrotik::api::impl::encode_sentence(const sentence& snt,
+                                     std::string_view api_attr,
+                                     std::string& trailer,
+                                     std::vector<socket::buffer>& out) {
+    // the words are stored already encoded, only the api attribute word and
+    // the terminating empty word need length prefixes
+    encode_trailer(api_attr, trailer);
+
+    auto bytes = snt.encoded();
+    if (!bytes.empty())
+        out.push_back({bytes.data(), bytes.size()});
+    out.push_back({trailer.data(), trailer.size()});
+}
+
+std::size_t
+mikrotik::api::impl::skip_sent(socket::buffer*& bufs, std::size_t count, std::size_t sent) noexcept {
+    while (count > 0 && sent >= bufs->size) {
+        sent -= bufs->size;
+        ++bufs;
+        --count;
+    }
+    if (count > 0) {
+        bufs->data += sent;
+        bufs->size -= sent;
+    }
+    return count;
+}
@@ -0,0 +1,191 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik/api/event_loop.hpp>
+
+// stdlib
+#include <algorithm>
+#include <stdexcept>
+
+// {fmt}
+#include "lib/fmt.hpp"
+
+// project
+#include "impl/socket_funcs.hpp"
+#include <mikrotik/api/exception/bad_socket.hpp>
+namespace sock = mikrotik::api::impl::socket;
+
+struct mikrotik::api::event_loop::detached {
+    struct promise_type {
+        struct final_awaiter {
+            bool await_ready() noexcept {
+                return false;
+            }
+            void await_suspend(std::coroutine_handle<promise_type> self) noexcept {
+                auto& roots = self.promise().loop->_roots;
+                roots.erase(std::find(roots.begin(), roots.end(), self));
+                self.destroy();
+            }
+            void await_resume() noexcept { }
+        };
+
+        detached get_return_object() noexcept {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+        final_awaiter final_suspend() noexcept {
+            return {};
+        }
+        void return_void() noexcept { }
+        void unhandled_exception() noexcept {
+            // detach catches everything
+            std::terminate();
+        }
+
+        event_loop* loop = nullptr;
+    };
+
+    std::coroutine_handle<promise_type> coro;
+};
+
+mikrotik::api::event_loop::event_loop() {
+    if (sock::init() != 0)
+        throw bad_socket(fmt::format("initialization failed: {}",
+                                     sock::string_error(sock::get_last_error())));
+}
+
+mikrotik::api::event_loop::~event_loop() noexcept {
+    // destroying the outermost coroutines destroys the tasks they are awaiting
+    while (!_roots.empty()) {
+        auto root = _roots.back();
+        _roots.pop_back();
+        root.destroy();
+    }
+    sock::finish();
+}
+
+mikrotik::api::event_loop::detached
+mikrotik::api::event_loop::detach(event_loop& loop, task<void> t) {
+    try {
+        co_await std::move(t);
+    } catch (...) {
+        if (!loop._error)
+            loop._error = std::current_exception();
+    }
+}
+
+void
+mikrotik::api::event_loop::spawn(task<void> t) {
+    auto root = detach(*this, std::move(t)).coro;
+    root.promise().loop = this;
+    _roots.push_back(root);
+    post(root);
+}
+
+void
+mikrotik::api::event_loop::post(std::coroutine_handle<> coro) {
+    _ready.push_back(coro);
+}
+
+void
+mikrotik::api::event_loop::run() {
+    run_until(nullptr);
+}
+
+void
+mikrotik::api::event_loop::run_until(const bool* done) {
+    while (!(done && *done)) {
+        auto progress = run_once();
+        if (_error)
+            std::rethrow_exception(std::exchange(_error, nullptr));
+        if (!progress) {
+            if (done)
+                throw std::logic_error("the awaited task cannot finish: no tasks or sockets left to wait on");
+            break;
+        }
+    }
+}
+
+bool
+mikrotik::api::event_loop::run_once() {
+    if (!_ready.empty()) {
+        // only run what's ready now, things posted meanwhile wait for the next round
+        for (auto n = _ready.size(); n > 0 && !_error; --n) {
+            auto coro = _ready.front();
+            _ready.pop_front();
+            coro.resume();
+        }
+        return true;
+    }
+
+    if (_waiters.empty())
+        return false;
+
+    _fds.clear();
+    auto earliest = clock::time_point::max();
+    for (const auto& w : _waiters) {
+        pollfd fd{};
+        fd.fd = w.sock;
+        fd.events = w.events;
+        _fds.push_back(fd);
+        earliest = std::min(earliest, w.deadline);
+    }
+
+    int timeout = -1;
+    if (earliest != clock::time_point::max()) {
+        auto left = std::chrono::ceil<std::chrono::milliseconds>(earliest - clock::now());
+        timeout = static_cast<int>(std::max<std::chrono::milliseconds::rep>(left.count(), 0));
+    }
+    if (sock::poll(_fds.data(), _fds.size(), timeout) == SOCKET_ERROR)
+        throw bad_socket(fmt::format("waiting for sockets failed: {}",
+                                     sock::string_error(sock::get_last_error())));
+
+    // errors and hang-ups wake up the waiter too, so it can fail with the
+    // appropriate error on its next socket operation
+    auto now = clock::now();
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < _waiters.size(); ++i) {
+        if (_fds[i].revents != 0) {
+            post(_waiters[i].coro);
+        } else if (_waiters[i].deadline <= now) {
+            *_waiters[i].ready = false;
+            post(_waiters[i].coro);
+        } else {
+            _waiters[kept++] = _waiters[i];
+        }
+    }
+    _waiters.resize(kept);
+    return true;
+}
@@ -0,0 +1,235 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik/api/hedged_handler.hpp>
+
+// stdlib
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+// project
+#include "impl/latency_window.hpp"
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/idempotence.hpp>
+
+namespace {
+    // the most duplicates that may be sent in a burst
+    constexpr const double hedge_burst = 10;
+}
+
+// the recent latencies of a command
+struct mikrotik::api::hedged_handler::command_stats {
+    explicit command_stats(std::size_t window)
+         : latencies(window) { }
+
+    impl::latency_window latencies;
+};
+
+// a sentence sent on one or both connections, completed by the first answer.
+// shared with the completions, as the late one may outlive the handler
+struct mikrotik::api::hedged_handler::race {
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::size_t started = 0;
+    std::size_t failed = 0;
+    bool won = false;
+    std::vector<reply> replies;
+    std::exception_ptr error;
+
+    bool finished() const noexcept {
+        return won || failed == started;
+    }
+
+    static shared_connection::completion
+    entry(const std::shared_ptr<race>& rc) {
+        return [rc](std::vector<reply>&& replies, std::exception_ptr error) {
+            std::lock_guard<std::mutex> lck(rc->mtx);
+            if (error) {
+                ++rc->failed;
+                rc->error = std::move(error);
+            } else if (!rc->won) {
+                rc->won = true;
+                rc->replies = std::move(replies);
+            }
+            rc->cv.notify_all();
+        };
+    }
+};
+
+mikrotik::api::hedged_handler::hedged_handler(ip_address address,
+                                              std::string_view user,
+                                              std::string_view pass,
+                                              std::uint16_t port,
+                                              const hedging_options& opts)
+     : _address(std::move(address)),
+       _user(user),
+       _pass(pass),
+       _port(port),
+       _opts(opts),
+       _hedge_tokens(hedge_burst),
+       _rng(std::random_device{}()) {
+    connection(0);
+    connection(1);
+}
+
+mikrotik::api::hedged_handler::~hedged_handler() noexcept = default;
+
+std::vector<mikrotik::api::reply>
+mikrotik::api::hedged_handler::execute(const sentence& snt) {
+    if (!is_idempotent(snt))
+        return connection(pick()).submit(snt).get();
+
+    auto command = snt.words()[0];
+    auto& stats = stats_of(command);
+    auto budget = _opts.retry.attempts;
+    if (auto it = _opts.attempts.find(command);
+        it != _opts.attempts.end())
+        budget = it->second;
+
+    _hedge_tokens = std::min(hedge_burst, _hedge_tokens + _opts.hedge_ratio);
+    for (std::size_t tries = 1;; ++tries) {
+        try {
+            return hedge(snt, stats);
+        } catch (const bad_socket&) {
+            if (tries == budget)
+                throw;
+            ++_retries;
+            std::this_thread::sleep_for(_opts.retry.delay(tries - 1, _rng));
+        }
+    }
+}
+
+std::chrono::microseconds
+mikrotik::api::hedged_handler::hedge_delay(const sentence& snt) const {
+    auto words = snt.words();
+    if (words.empty())
+        return _opts.initial_hedge_delay;
+
+    auto it = _stats.find(std::string(words[0]));
+    if (it == _stats.end())
+        return _opts.initial_hedge_delay;
+    return delay_of(*it->second);
+}
+
+std::size_t
+mikrotik::api::hedged_handler::hedges() const noexcept {
+    return _hedges;
+}
+
+std::size_t
+mikrotik::api::hedged_handler::retries() const noexcept {
+    return _retries;
+}
+
+mikrotik::api::shared_connection&
+mikrotik::api::hedged_handler::connection(std::size_t idx) {
+    auto& conn = _conns[idx];
+    if (!conn || conn->failed()) {
+        // a failed connection's sentences fail with it, so their races move on
+        conn.reset();
+        conn = std::make_unique<shared_connection>(_address, _user, _pass, _port, _opts.limits);
+    }
+    return *conn;
+}
+
+mikrotik::api::hedged_handler::command_stats&
+mikrotik::api::hedged_handler::stats_of(std::string_view command) {
+    auto& stats = _stats[std::string(command)];
+    if (!stats)
+        stats = std::make_unique<command_stats>(_opts.window);
+    return *stats;
+}
+
+std::vector<mikrotik::api::reply>
+mikrotik::api::hedged_handler::hedge(const sentence& snt, command_stats& stats) {
+    using clock = std::chrono::steady_clock;
+    const auto start = clock::now();
+    const auto first = pick();
+    auto rc = std::make_shared<race>();
+
+    auto& primary = connection(first);
+    rc->started = 1;
+    primary.submit(snt, race::entry(rc));
+
+    std::unique_lock<std::mutex> lck(rc->mtx);
+    auto finished = [&rc] { return rc->finished(); };
+    if (!rc->cv.wait_for(lck, delay_of(stats), finished) && take_hedge()) {
+        lck.unlock();
+        try {
+            auto& secondary = connection(1 - first);
+            {
+                std::lock_guard<std::mutex> guard(rc->mtx);
+                ++rc->started;
+            }
+            secondary.submit(snt, race::entry(rc));
+            ++_hedges;
+        } catch (const bad_socket&) {
+            // the device is not accepting connections, the first one may still answer
+        }
+        lck.lock();
+    }
+    rc->cv.wait(lck, finished);
+
+    if (!rc->won)
+        std::rethrow_exception(rc->error);
+    stats.latencies.add(std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start));
+    return std::move(rc->replies);
+}
+
+std::chrono::microseconds
+mikrotik::api::hedged_handler::delay_of(const command_stats& stats) const {
+    if (stats.latencies.size() < _opts.min_samples)
+        return _opts.initial_hedge_delay;
+    return stats.latencies.percentile(_opts.hedge_percentile);
+}
+
+std::size_t
+mikrotik::api::hedged_handler::pick() noexcept {
+    // alternate, but avoid the connection still busy with earlier, possibly stalled, sentences
+    auto idx = _next++ % 2;
+    if (_conns[0] && _conns[1] && _conns[idx]->pending() > _conns[1 - idx]->pending())
+        idx = 1 - idx;
+    return idx;
+}
+
+bool
+mikrotik::api::hedged_handler::take_hedge() noexcept {
+    if (_hedge_tokens < 1)
+        return false;
+    _hedge_tokens -= 1;
+    return true;
+}
@@ -0,0 +1,72 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik/api/idempotence.hpp>
+
+// stdlib
+#include <string_view>
+
+namespace {
+    // the name of an attribute word, like "once" in "=once=yes"
+    std::string_view
+    attribute_name(std::string_view word) noexcept {
+        if (word.size() < 2 || word.front() != '=')
+            return {};
+        word.remove_prefix(1);
+        return word.substr(0, word.find('='));
+    }
+}
+
+bool
+mikrotik::api::is_idempotent(const sentence& snt) noexcept {
+    auto words = snt.words();
+    if (words.empty())
+        return false;
+
+    auto cmd = words[0];
+    auto verb = cmd.substr(cmd.rfind('/') + 1);
+
+    bool print = verb == "print";
+    bool monitor = verb.substr(0, 7) == "monitor";
+    if (!print && !monitor)
+        return verb == "get" || verb == "getall";
+
+    bool once = false;
+    for (std::size_t i = 1; i < words.size(); ++i) {
+        auto name = attribute_name(words[i]);
+        if (print && (name == "follow" || name == "follow-only" || name == "interval"))
+            return false;
+        once |= name == "once";
+    }
+    return print || once;
+}
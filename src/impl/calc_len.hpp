@@ -34,9 +34,16 @@
 #pragma once
 
 // stdlib
+#include <cstddef>
 #include <string_view>
 #include <string>
 
+// project
+#include <mikrotik/api/impl/length_codec.hpp>
+
 namespace mikrotik::api::impl {
     std::string calc_len(std::string_view str);
+    // out must have room for max_length_size bytes, returns the amount of bytes written.
+    // throws bad_word if the word is too long, see encode_length for the noexcept version
+    std::size_t calc_len(std::string_view str, char* out);
 }
@@ -0,0 +1,61 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// project
+#include <mikrotik/api/impl/sockets.hpp>
+#include <mikrotik/api/sentence.hpp>
+
+namespace mikrotik::api::impl {
+    // writes the optional api attribute word and the terminating empty word of a
+    // sentence into trailer. throws bad_word if the api attribute word is too long
+    void encode_trailer(std::string_view api_attr, std::string& trailer);
+
+    // appends the buffers of the sentence and of its trailer to out. the words are
+    // sent from where they are, so neither the sentence nor the trailer may change
+    // until the buffers are sent. nothing is appended if encoding the trailer throws
+    void encode_sentence(const sentence& snt,
+                         std::string_view api_attr,
+                         std::string& trailer,
+                         std::vector<socket::buffer>& out);
+
+    // drops the first sent bytes from the buffers, returns the amount of buffers left
+    std::size_t skip_sent(socket::buffer*& bufs, std::size_t count, std::size_t sent) noexcept;
+}
@@ -0,0 +1,81 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace mikrotik::api::impl {
+    // the last `capacity` latencies of a command, to estimate its percentiles from
+    struct latency_window {
+        explicit latency_window(std::size_t capacity)
+             : _capacity(std::max<std::size_t>(capacity, 1)) {
+            _samples.reserve(_capacity);
+        }
+
+        // overwrites the oldest sample once full
+        void add(std::chrono::microseconds sample) {
+            if (_samples.size() < _capacity)
+                _samples.push_back(sample);
+            else
+                _samples[_next] = sample;
+            _next = (_next + 1) % _capacity;
+        }
+
+        std::size_t size() const noexcept {
+            return _samples.size();
+        }
+
+        // the smallest sample not exceeded by the `p` part of the samples, p in [0, 1].
+        // sorts a copy partially, which is cheap next to a round trip
+        std::chrono::microseconds percentile(double p) const {
+            if (_samples.empty())
+                return std::chrono::microseconds(0);
+
+            auto copy = _samples;
+            auto idx = static_cast<std::size_t>(std::clamp(p, 0.0, 1.0)
+                                                * static_cast<double>(copy.size() - 1));
+            std::nth_element(copy.begin(), copy.begin() + static_cast<std::ptrdiff_t>(idx), copy.end());
+            return copy[idx];
+        }
+
+    private:
+        std::size_t _capacity;
+        std::size_t _next = 0;
+        std::vector<std::chrono::microseconds> _samples;
+    };
+}
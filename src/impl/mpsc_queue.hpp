@@ -0,0 +1,108 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <atomic>
+#include <thread>
+
+namespace mikrotik::api::impl {
+    // the link of a node in an mpsc_queue, to be inherited from
+    struct mpsc_node {
+        std::atomic<mpsc_node*> next{nullptr};
+    };
+
+    // an intrusive, unbounded, lock-free multi producer single consumer queue
+    // (Dmitry Vyukov's). push() may be called from any thread, pop() only from
+    // one at a time. the queue does not own the nodes
+    template<class T>
+    struct mpsc_queue {
+        mpsc_queue() noexcept
+             : _head{&_stub},
+               _tail{&_stub} { }
+
+        mpsc_queue(const mpsc_queue&) = delete;
+        mpsc_queue& operator=(const mpsc_queue&) = delete;
+
+        // wait-free: a single exchange, the node is visible to pop() once
+        // its predecessor is linked to it
+        void push(T* node) noexcept {
+            push_node(node);
+        }
+
+        // returns null if the queue is empty
+        T* pop() noexcept {
+            auto tail = _tail;
+            auto next = tail->next.load(std::memory_order_acquire);
+            if (tail == &_stub) {
+                if (next == nullptr)
+                    return nullptr;
+                _tail = next;
+                tail = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+            if (next == nullptr) {
+                // tail is the last node, unless a producer is between the exchange
+                // and the linking in push, which is only a few instructions, so wait
+                while (tail != _head.load(std::memory_order_acquire)) {
+                    if ((next = tail->next.load(std::memory_order_acquire)) != nullptr)
+                        break;
+                    std::this_thread::yield();
+                }
+            }
+            if (next == nullptr) {
+                // the stub is pushed back, so tail can be taken out
+                push_node(&_stub);
+                next = tail->next.load(std::memory_order_acquire);
+                while (next == nullptr) {
+                    std::this_thread::yield();
+                    next = tail->next.load(std::memory_order_acquire);
+                }
+            }
+            _tail = next;
+            return static_cast<T*>(tail);
+        }
+
+    private:
+        void push_node(mpsc_node* node) noexcept {
+            node->next.store(nullptr, std::memory_order_relaxed);
+            auto prev = _head.exchange(node, std::memory_order_acq_rel);
+            prev->next.store(node, std::memory_order_release);
+        }
+
+        std::atomic<mpsc_node*> _head;
+        mpsc_node* _tail;
+        mpsc_node _stub;
+    };
+}
@@ -0,0 +1,82 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <cstddef>
+#include <vector>
+
+// project
+#include <mikrotik/api/impl/sockets.hpp>
+
+namespace mikrotik::api::impl {
+    // waits for readiness of many non-blocking sockets at once: epoll on Linux,
+    // poll everywhere else. the data pointer given when registering a socket
+    // is returned with its events
+    struct poller {
+        enum : unsigned {
+            readable = 1u,
+            writable = 2u,
+            failed = 4u // error or hang-up, always reported
+        };
+
+        struct event {
+            void* data;
+            unsigned events;
+        };
+
+        poller();
+        poller(const poller&) = delete;
+        poller& operator=(const poller&) = delete;
+        ~poller() noexcept;
+
+        void add(socket::handle sock, unsigned events, void* data);
+        void modify(socket::handle sock, unsigned events, void* data);
+        void remove(socket::handle sock) noexcept;
+
+        // waits at most timeout_ms milliseconds, or forever if negative,
+        // and replaces the contents of ready with the ready sockets
+        void wait(std::vector<event>& ready, int timeout_ms);
+
+        std::size_t size() const noexcept {
+            return _size;
+        }
+
+    private:
+        std::size_t _size = 0;
+        int _epoll = -1;
+        std::vector<pollfd> _fds;
+        std::vector<void*> _data;
+    };
+}
@@ -0,0 +1,88 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#pragma once
+
+// stdlib
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// project
+#include <mikrotik/api/impl/sockets.hpp>
+
+namespace mikrotik::api::impl {
+    // starts socket operations, and reports their completion later from wait().
+    // a socket may only have one operation in flight at a time, and all memory
+    // given to an operation must stay valid until it completes.
+    // the data pointer given when starting an operation is returned with its completion
+    struct reactor {
+        struct completion {
+            void* data;
+            std::size_t bytes; // sent or received, 0 on receive means closed
+            int error;         // 0 on success
+        };
+
+        virtual ~reactor() noexcept = default;
+
+        virtual void connect(socket::handle sock, const sockaddr& addr, void* data) = 0;
+        virtual void send(socket::handle sock, const socket::buffer* bufs, std::size_t count, void* data) = 0;
+        virtual void recv(socket::handle sock, char* buf, std::size_t len, void* data) = 0;
+
+        // must be called before closing a socket. an operation still in flight on it is
+        // cancelled and never reported, but its memory must stay valid until pending()
+        // stops counting it
+        virtual void forget(socket::handle sock) noexcept = 0;
+
+        // waits at most timeout_ms milliseconds, or forever if negative, for at
+        // least one operation to complete, and replaces the contents of done with
+        // the completed operations
+        virtual void wait(std::vector<completion>& done, int timeout_ms) = 0;
+
+        // the amount of operations in flight
+        virtual std::size_t pending() const noexcept = 0;
+    };
+
+    // io_uring if the library was built with it, and the kernel supports it,
+    // otherwise the poll based one
+    std::unique_ptr<reactor> make_reactor();
+
+    // performs the operations when the poller reports their socket ready
+    std::unique_ptr<reactor> make_poll_reactor();
+
+#ifdef MIKROTIK_API_IO_URING
+    // submits the operations to an io_uring. returns null if the kernel does not
+    // support io_uring, or the operations required
+    std::unique_ptr<reactor> make_uring_reactor();
+#endif
+}
@@ -34,9 +34,12 @@
 #pragma once
 
 // stdlib
+#include <cstddef>
+#include <cstdint>
 #include <string_view>
 
 #include <mikrotik/api/impl/sockets.hpp>
+#include <mikrotik/api/ip_address.hpp>
 
 namespace mikrotik::api::impl::socket {
     bool is_valid(handle sock) noexcept;
@@ -44,12 +47,29 @@ namespace mikrotik::api::impl::socket {
     int init() noexcept;
     int finish() noexcept;
 
+    // the created socket never raises SIGPIPE when sending to a closed connection
     handle create(int domain, int type, int protocol) noexcept;
+    // where sends cannot be flagged with MSG_NOSIGNAL, sets SO_NOSIGPIPE on the socket
+    void no_sigpipe(handle sock) noexcept;
 
     int connect(handle sock, sockaddr addr) noexcept;
 
+    // a non-blocking datagram socket connected to itself on loopback: sending a byte
+    // to it makes it readable, which wakes up a thread polling it with other sockets
+    handle make_wakeup() noexcept;
+    sockaddr make_address(const ip_address& address, std::uint16_t port) noexcept;
+
+    int set_nonblocking(handle sock, bool nonblocking) noexcept;
+    int pending_error(handle sock) noexcept;
+    int poll(pollfd* fds, std::size_t count, int timeout_ms) noexcept;
+
+    std::ptrdiff_t recv(handle sock, char* buf, std::size_t len) noexcept;
+    std::ptrdiff_t send(handle sock, const buffer* bufs, std::size_t count) noexcept;
+
     int close(handle sock) noexcept;
 
     int get_last_error() noexcept;
+    bool would_block(int err) noexcept;
+    bool in_progress(int err) noexcept;
     std::string_view string_error(int err) noexcept;
 }
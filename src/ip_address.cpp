@@ -73,8 +73,27 @@ mikrotik::api::ip_address::ip_address(const char *address)
 
 std::string
 mikrotik::api::ip_address::render(int port) const {
+    char buf[15 + 1 + 11];
+    auto [end, _] = to_chars(buf, buf + 15);
     if (port) {
-        return fmt::format("{}.{}.{}.{}:{}", _bytes[0], _bytes[1], _bytes[2], _bytes[3], port);
+        *end++ = ':';
+        end = std::to_chars(end, buf + sizeof(buf), port).ptr;
     }
-    return fmt::format("{}.{}.{}.{}", _bytes[0], _bytes[1], _bytes[2], _bytes[3]);
+    return std::string(buf, end);
+}
+
+std::to_chars_result
+mikrotik::api::ip_address::to_chars(char* first, char* last) const noexcept {
+    for (std::size_t i = 0; i < _bytes.size(); ++i) {
+        if (i != 0) {
+            if (first == last)
+                return {last, std::errc::value_too_large};
+            *first++ = '.';
+        }
+        auto [ptr, ec] = std::to_chars(first, last, _bytes[i]);
+        if (ec != std::errc())
+            return {last, ec};
+        first = ptr;
+    }
+    return {first, std::errc()};
 }
@@ -0,0 +1,152 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik/api/pipeline.hpp>
+
+// stdlib
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+// {fmt}
+#include "lib/fmt.hpp"
+
+// project
+#include <mikrotik/api/exception/bad_socket.hpp>
+
+namespace {
+    constexpr const std::string_view tag_word = ".tag=";
+}
+
+mikrotik::api::pipeline::pipeline(api_handler& api)
+     : _api(api) { }
+
+mikrotik::api::pipeline::tag_type
+mikrotik::api::pipeline::submit(const sentence& snt) {
+    return submit_tagged(snt);
+}
+
+mikrotik::api::pipeline::tag_type
+mikrotik::api::pipeline::submit(const prepared_sentence& snt) {
+    return submit_tagged(snt);
+}
+
+template<class Sentence>
+mikrotik::api::pipeline::tag_type
+mikrotik::api::pipeline::submit_tagged(const Sentence& snt) {
+    auto tag = _next_tag++;
+    if (_next_tag == 0)
+        _next_tag = 1;
+
+    char word[tag_word.size() + 10];
+    std::memcpy(word, tag_word.data(), tag_word.size());
+    auto [end, _] = std::to_chars(word + tag_word.size(), word + sizeof(word), tag);
+
+    // a sentence that failed to send gets no replies, so it is not in flight
+    _api.send(snt, {word, static_cast<std::size_t>(end - word)});
+    _requests.try_emplace(tag);
+    return tag;
+}
+
+std::optional<mikrotik::api::reply>
+mikrotik::api::pipeline::read_one() {
+    const auto& view = _api.read_view();
+
+    std::optional<tag_type> tag;
+    reply rep;
+    rep.reply_type = view.reply_type;
+    rep.attributes.reserve(view.attributes.size());
+    for (auto word : view.attributes) {
+        if (word.substr(0, tag_word.size()) == tag_word) {
+            tag_type value;
+            auto beg = word.data() + tag_word.size();
+            auto end = word.data() + word.size();
+            if (auto [ptr, err] = std::from_chars(beg, end, value);
+                err == std::errc{} && ptr == end) {
+                tag = value;
+                continue;
+            }
+        }
+        rep.attributes.emplace_back(word);
+    }
+
+    // !fatal is never tagged, and affects everyone. other untagged replies
+    // belong to sentences sent around the pipeline, so they are not ours
+    if (!tag) {
+        if (rep.reply_type == reply::fatal)
+            return rep;
+        return std::nullopt;
+    }
+
+    if (auto it = _requests.find(*tag); it != _requests.end()) {
+        it->second.replies.push_back(std::move(rep));
+    }
+    // replies to unknown tags are not ours, ignore them
+    return std::nullopt;
+}
+
+mikrotik::api::reply
+mikrotik::api::pipeline::read(tag_type tag) {
+    auto it = _requests.find(tag);
+    if (it == _requests.end())
+        throw bad_socket(fmt::format("no sentence in flight with tag {}", tag));
+
+    while (it->second.replies.empty()) {
+        if (auto fatal = read_one()) {
+            // the connection is gone, and so are all sentences in flight
+            _requests.clear();
+            return std::move(*fatal);
+        }
+    }
+
+    auto rep = std::move(it->second.replies.front());
+    it->second.replies.pop_front();
+    if (rep.reply_type == reply::done)
+        _requests.erase(it);
+    return rep;
+}
+
+std::vector<mikrotik::api::reply>
+mikrotik::api::pipeline::collect(tag_type tag) {
+    std::vector<reply> replies;
+    do {
+        replies.push_back(read(tag));
+    } while (replies.back().reply_type != reply::done
+             && replies.back().reply_type != reply::fatal);
+    return replies;
+}
+
+std::size_t
+mikrotik::api::pipeline::in_flight() const noexcept {
+    return _requests.size();
+}
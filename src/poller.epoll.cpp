@@ -0,0 +1,122 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include "impl/poller.hpp"
+
+// stdlib
+#include <cerrno>
+#include <cstring>
+
+// POSIX
+#include <sys/epoll.h>
+
+// {fmt}
+#include "lib/fmt.hpp"
+
+// project
+#include "impl/socket_funcs.hpp"
+#include <mikrotik/api/exception/bad_socket.hpp>
+namespace sock = mikrotik::api::impl::socket;
+
+namespace {
+    epoll_event
+    mk_event(unsigned events, void* data) noexcept {
+        epoll_event ev{};
+        if (events & mikrotik::api::impl::poller::readable)
+            ev.events |= EPOLLIN;
+        if (events & mikrotik::api::impl::poller::writable)
+            ev.events |= EPOLLOUT;
+        ev.data.ptr = data;
+        return ev;
+    }
+}
+
+mikrotik::api::impl::poller::poller()
+     : _epoll{epoll_create1(EPOLL_CLOEXEC)} {
+    if (_epoll < 0)
+        throw bad_socket(fmt::format("creating epoll instance failed: {}",
+                                     sock::string_error(errno)));
+}
+
+mikrotik::api::impl::poller::~poller() noexcept {
+    ::close(_epoll);
+}
+
+void
+mikrotik::api::impl::poller::add(socket::handle sock, unsigned events, void* data) {
+    auto ev = mk_event(events, data);
+    if (epoll_ctl(_epoll, EPOLL_CTL_ADD, sock, &ev) != 0)
+        throw bad_socket(fmt::format("registering socket failed: {}",
+                                     sock::string_error(errno)));
+    ++_size;
+}
+
+void
+mikrotik::api::impl::poller::modify(socket::handle sock, unsigned events, void* data) {
+    auto ev = mk_event(events, data);
+    if (epoll_ctl(_epoll, EPOLL_CTL_MOD, sock, &ev) != 0)
+        throw bad_socket(fmt::format("registering socket failed: {}",
+                                     sock::string_error(errno)));
+}
+
+void
+mikrotik::api::impl::poller::remove(socket::handle sock) noexcept {
+    epoll_event ev{};
+    if (epoll_ctl(_epoll, EPOLL_CTL_DEL, sock, &ev) == 0)
+        --_size;
+}
+
+void
+mikrotik::api::impl::poller::wait(std::vector<event>& ready, int timeout_ms) {
+    epoll_event evs[128];
+
+    int count;
+    do {
+        count = epoll_wait(_epoll, evs, 128, timeout_ms);
+    } while (count < 0 && errno == EINTR);
+    if (count < 0)
+        throw bad_socket(fmt::format("waiting for sockets failed: {}",
+                                     sock::string_error(errno)));
+
+    ready.clear();
+    for (int i = 0; i < count; ++i) {
+        unsigned events = 0;
+        if (evs[i].events & EPOLLIN)
+            events |= readable;
+        if (evs[i].events & EPOLLOUT)
+            events |= writable;
+        if (evs[i].events & (EPOLLERR | EPOLLHUP))
+            events |= failed;
+        ready.push_back({evs[i].data.ptr, events});
+    }
+}
@@ -0,0 +1,121 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include "impl/poller.hpp"
+
+// stdlib
+#include <algorithm>
+
+// {fmt}
+#include "lib/fmt.hpp"
+
+// project
+#include "impl/socket_funcs.hpp"
+#include <mikrotik/api/exception/bad_socket.hpp>
+namespace sock = mikrotik::api::impl::socket;
+
+namespace {
+    short
+    mk_events(unsigned events) noexcept {
+        short ret = 0;
+        if (events & mikrotik::api::impl::poller::readable)
+            ret |= POLLIN;
+        if (events & mikrotik::api::impl::poller::writable)
+            ret |= POLLOUT;
+        return ret;
+    }
+}
+
+mikrotik::api::impl::poller::poller() = default;
+
+mikrotik::api::impl::poller::~poller() noexcept = default;
+
+void
+mikrotik::api::impl::poller::add(socket::handle sock, unsigned events, void* data) {
+    pollfd fd{};
+    fd.fd = sock;
+    fd.events = mk_events(events);
+    _fds.push_back(fd);
+    _data.push_back(data);
+    ++_size;
+}
+
+void
+mikrotik::api::impl::poller::modify(socket::handle sock, unsigned events, void* data) {
+    auto it = std::find_if(_fds.begin(), _fds.end(), [sock](const pollfd& fd) {
+        return fd.fd == sock;
+    });
+    if (it == _fds.end())
+        throw bad_socket("registering socket failed: socket is not registered");
+
+    it->events = mk_events(events);
+    _data[static_cast<std::size_t>(it - _fds.begin())] = data;
+}
+
+void
+mikrotik::api::impl::poller::remove(socket::handle sock) noexcept {
+    auto it = std::find_if(_fds.begin(), _fds.end(), [sock](const pollfd& fd) {
+        return fd.fd == sock;
+    });
+    if (it == _fds.end())
+        return;
+
+    auto idx = static_cast<std::size_t>(it - _fds.begin());
+    _fds[idx] = _fds.back();
+    _fds.pop_back();
+    _data[idx] = _data.back();
+    _data.pop_back();
+    --_size;
+}
+
+void
+mikrotik::api::impl::poller::wait(std::vector<event>& ready, int timeout_ms) {
+    ready.clear();
+    if (sock::poll(_fds.data(), _fds.size(), timeout_ms) == SOCKET_ERROR)
+        throw bad_socket(fmt::format("waiting for sockets failed: {}",
+                                     sock::string_error(sock::get_last_error())));
+
+    for (std::size_t i = 0; i < _fds.size(); ++i) {
+        if (_fds[i].revents == 0)
+            continue;
+
+        unsigned events = 0;
+        if (_fds[i].revents & POLLIN)
+            events |= readable;
+        if (_fds[i].revents & POLLOUT)
+            events |= writable;
+        if (_fds[i].revents & (POLLERR | POLLHUP | POLLNVAL))
+            events |= failed;
+        ready.push_back({_data[i], events});
+    }
+}
@@ -0,0 +1,105 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik/api/prepared_sentence.hpp>
+
+// stdlib
+#include <algorithm>
+
+// project
+#include "impl/calc_len.hpp"
+#include <mikrotik/api/exception/bad_word.hpp>
+
+mikrotik::api::prepared_sentence::prepared_sentence(const sentence& constant,
+                                                    std::initializer_list<std::string_view> slots)
+     : _constant(constant) {
+    _slots.reserve(slots.size());
+    for (auto name : slots) {
+        auto& slot = _slots.emplace_back();
+        slot.word.reserve(name.size() + 2);
+        slot.word += '=';
+        slot.word += name;
+        slot.word += '=';
+        slot.name_size = slot.word.size();
+        slot.prefix_size = impl::calc_len(slot.word, slot.prefix);
+    }
+}
+
+std::size_t
+mikrotik::api::prepared_sentence::slot(std::string_view name) const {
+    auto it = std::find_if(_slots.begin(), _slots.end(), [name](const slot_data& slot) {
+        return std::string_view(slot.word).substr(1, slot.name_size - 2) == name;
+    });
+    if (it == _slots.end())
+        throw bad_word(std::string(name), "no slot with this name");
+    return static_cast<std::size_t>(it - _slots.begin());
+}
+
+mikrotik::api::prepared_sentence&
+mikrotik::api::prepared_sentence::bind(std::size_t slot, std::string_view value) {
+    auto& data = _slots.at(slot);
+    data.word.resize(data.name_size);
+    data.word += value;
+    data.prefix_size = impl::calc_len(data.word, data.prefix);
+    return *this;
+}
+
+mikrotik::api::prepared_sentence&
+mikrotik::api::prepared_sentence::bind(std::string_view name, std::string_view value) {
+    return bind(slot(name), value);
+}
+
+std::size_t
+mikrotik::api::prepared_sentence::slots() const noexcept {
+    return _slots.size();
+}
+
+mikrotik::api::sentence
+mikrotik::api::prepared_sentence::to_sentence() const {
+    sentence ret(_constant);
+    for (const auto& slot : _slots) {
+        ret.add_word(slot.word);
+    }
+    return ret;
+}
+
+void
+mikrotik::api::prepared_sentence::gather(std::vector<impl::socket::buffer>& out) const {
+    auto bytes = _constant.encoded();
+    if (!bytes.empty())
+        out.push_back({bytes.data(), bytes.size()});
+    for (const auto& slot : _slots) {
+        out.push_back({slot.prefix, slot.prefix_size});
+        out.push_back({slot.word.data(), slot.word.size()});
+    }
+}
@@ -0,0 +1,210 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+// project
+#include "impl/encode_sentence.hpp"
+#include "impl/scan_sentence.hpp"
+#include <mikrotik/api/impl/length_codec.hpp>
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/prepared_sentence.hpp>
+#include <mikrotik/api/protocol.hpp>
+#include <mikrotik/api/sentence.hpp>
+
+// stdlib
+#include <algorithm>
+#include <cstring>
+
+// {fmt}
+#include "lib/fmt.hpp"
+
+using namespace mikrotik::api::literals;
+
+namespace {
+    // the amount of terminators in the encoded sentences
+    std::size_t
+    count_sentences(std::string_view bytes) noexcept {
+        std::size_t count = 0;
+        while (!bytes.empty()) {
+            std::size_t len = 0;
+            auto prefix = mikrotik::api::impl::decode_length(bytes, len);
+            if (prefix == 0 || prefix == mikrotik::api::impl::bad_length)
+                break;
+            if (len == 0)
+                ++count;
+            bytes.remove_prefix(std::min(bytes.size(), prefix + len));
+        }
+        return count;
+    }
+}
+
+void
+mikrotik::api::protocol::login(std::string_view user, std::string_view pass) {
+    auto comm = "login"_cmd
+           [{"name", user}]
+           [{"password", pass}];
+    // the sentence is gone by the time it is written, so it is stored in a trailer
+    auto& trailer = next_trailer();
+    trailer.assign(comm.encoded());
+    trailer += '\0';
+    _output.push_back({trailer.data(), trailer.size()});
+    _state = state::logging_in;
+}
+
+bool
+mikrotik::api::protocol::is_logged_in() const noexcept {
+    return _state == state::ready;
+}
+
+void
+mikrotik::api::protocol::send(const sentence& snt, std::string_view api_attr) {
+    impl::encode_sentence(snt, api_attr, next_trailer(), _output);
+    ++_outstanding;
+}
+
+void
+mikrotik::api::protocol::send(const prepared_sentence& snt, std::string_view api_attr) {
+    auto& trailer = next_trailer();
+    impl::encode_trailer(api_attr, trailer);
+    snt.gather(_output);
+    _output.push_back({trailer.data(), trailer.size()});
+    ++_outstanding;
+}
+
+void
+mikrotik::api::protocol::send_encoded(std::string_view bytes) {
+    if (!bytes.empty())
+        _output.push_back({bytes.data(), bytes.size()});
+    _outstanding += count_sentences(bytes);
+}
+
+std::string&
+mikrotik::api::protocol::next_trailer() {
+    if (_trailers_used == _trailers.size())
+        _trailers.emplace_back();
+    return _trailers[_trailers_used++];
+}
+
+mikrotik::api::protocol::output
+mikrotik::api::protocol::next_output() const noexcept {
+    return {_output.data() + _written, _output.size() - _written};
+}
+
+void
+mikrotik::api::protocol::consume_output(std::size_t n) noexcept {
+    auto bufs = _output.data() + _written;
+    impl::skip_sent(bufs, _output.size() - _written, n);
+    _written = static_cast<std::size_t>(bufs - _output.data());
+
+    // everything is written, so the buffers and the trailers can be reused
+    if (_written == _output.size())
+        discard_output();
+}
+
+void
+mikrotik::api::protocol::discard_output() noexcept {
+    _output.clear();
+    _written = 0;
+    _trailers_used = 0;
+}
+
+void
+mikrotik::api::protocol::feed(std::string_view bytes) {
+    std::memcpy(prepare_input(bytes.size()), bytes.data(), bytes.size());
+    commit_input(bytes.size());
+}
+
+char*
+mikrotik::api::protocol::prepare_input(std::size_t min_space) {
+    // the bytes of the sentence in view() are kept, as it is valid until next_event()
+    return _input.prepare(min_space);
+}
+
+std::size_t
+mikrotik::api::protocol::input_space() const noexcept {
+    return _input.space();
+}
+
+void
+mikrotik::api::protocol::commit_input(std::size_t n) noexcept {
+    _input.commit(n);
+}
+
+std::size_t
+mikrotik::api::protocol::needed() const noexcept {
+    auto have = _input.size() - _view_size;
+    return _need > have ? _need - have : 1;
+}
+
+mikrotik::api::protocol::event
+mikrotik::api::protocol::next_event() {
+    // the previous sentence is only released now, so its views stay valid until here
+    _input.consume(_view_size);
+    _view_size = 0;
+
+    _view_size = impl::scan_sentence(_input.data(), _words, _need);
+    if (_view_size == 0)
+        return need_input;
+    impl::make_view(_words, _view);
+
+    if (_state == state::logging_in) {
+        if (_view.reply_type != reply::done)
+            throw bad_socket(fmt::format("error: could not log into device: {}",
+                                         _view.attributes.empty() ? std::string_view{}
+                                                                  : _view.attributes.back()));
+        _state = state::ready;
+        return logged_in;
+    }
+
+    if (_view.reply_type == reply::fatal) {
+        _outstanding = 0;
+    } else if (_view.reply_type == reply::done && _outstanding > 0) {
+        --_outstanding;
+    }
+    return received;
+}
+
+const mikrotik::api::reply_view&
+mikrotik::api::protocol::view() const noexcept {
+    return _view;
+}
+
+std::size_t
+mikrotik::api::protocol::outstanding() const noexcept {
+    return _outstanding;
+}
+
+std::size_t
+mikrotik::api::protocol::buffered_input() const noexcept {
+    return _input.size() - _view_size;
+}
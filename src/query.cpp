@@ -33,21 +33,21 @@
 
 #include <mikrotik/api/query.hpp>
 
-// {fmt}
-#include "lib/fmt.hpp"
+// project
+#include "impl/concat.hpp"
 
 mikrotik::api::query::query(std::string_view name)
-       : value(fmt::format("?{}", name)) {
+       : value(impl::concat({"?", name})) {
 }
 
 mikrotik::api::query::query(std::string_view name, std::string_view value)
-       : value(fmt::format("?{}={}", name, value)) {
+       : value(impl::concat({"?", name, "=", value})) {
 }
 
 mikrotik::api::query::query(const char* name)
-       : value(fmt::format("?{}", name)) {
+       : value(impl::concat({"?", name})) {
 }
 
 mikrotik::api::query::query(const char* name, const char* value)
-       : value(fmt::format("?{}={}", name, value)) {
+       : value(impl::concat({"?", name, "=", value})) {
 }
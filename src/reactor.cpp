@@ -0,0 +1,225 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include "impl/reactor.hpp"
+
+// stdlib
+#include <unordered_map>
+
+// project
+#include "impl/poller.hpp"
+#include "impl/socket_funcs.hpp"
+namespace sock = mikrotik::api::impl::socket;
+
+namespace {
+    using namespace mikrotik::api::impl;
+
+    struct poll_reactor final : reactor {
+        void
+        connect(socket::handle s, const sockaddr& addr, void* data) override {
+            auto& o = begin(s, op::connect, data);
+            if (::connect(s, &addr, sizeof(addr)) == 0)
+                return finish(o, 0, 0);
+
+            auto err = sock::get_last_error();
+            if (!sock::in_progress(err))
+                return finish(o, 0, err);
+            arm(o, poller::writable);
+        }
+
+        void
+        send(socket::handle s, const socket::buffer* bufs, std::size_t count, void* data) override {
+            auto& o = begin(s, op::send, data);
+            o.bufs = bufs;
+            o.count = count;
+            // sockets are usually writable, so try right away
+            if (!try_send(o))
+                arm(o, poller::writable);
+        }
+
+        void
+        recv(socket::handle s, char* buf, std::size_t len, void* data) override {
+            auto& o = begin(s, op::recv, data);
+            o.buf = buf;
+            o.len = len;
+            // replies are usually not there yet, so wait for them first
+            arm(o, poller::readable);
+        }
+
+        void
+        forget(socket::handle s) noexcept override {
+            auto it = _ops.find(s);
+            if (it == _ops.end())
+                return;
+            if (it->second.interest != 0)
+                _poller.remove(s);
+            if (it->second.active)
+                --_active;
+            _ops.erase(it);
+        }
+
+        void
+        wait(std::vector<completion>& done, int timeout_ms) override {
+            done.clear();
+            done.swap(_done);
+            if (_active == 0)
+                return;
+
+            _poller.wait(_events, done.empty() ? timeout_ms : 0);
+            for (auto ev : _events) {
+                auto& o = *static_cast<op*>(ev.data);
+                if (!o.active) {
+                    // the interest is kept after an operation completes, in case the next
+                    // one needs the same, so an idle socket is only removed once it wakes us
+                    _poller.remove(o.sock);
+                    o.interest = 0;
+                    continue;
+                }
+
+                switch (o.kind) {
+                case op::connect:
+                    finish(o, 0, sock::pending_error(o.sock));
+                    break;
+                case op::send:
+                    try_send(o);
+                    break;
+                case op::recv: {
+                    auto got = sock::recv(o.sock, o.buf, o.len);
+                    if (got != SOCKET_ERROR) {
+                        finish(o, static_cast<std::size_t>(got), 0);
+                    } else if (auto err = sock::get_last_error(); !sock::would_block(err)) {
+                        finish(o, 0, err);
+                    }
+                    break;
+                }
+                }
+            }
+            done.insert(done.end(), _done.begin(), _done.end());
+            _done.clear();
+        }
+
+        std::size_t
+        pending() const noexcept override {
+            return _active + _done.size();
+        }
+
+    private:
+        struct op {
+            enum kind_type {
+                connect,
+                send,
+                recv
+            };
+
+            kind_type kind = connect;
+            void* data = nullptr;
+            socket::handle sock = INVALID_SOCKET;
+            const socket::buffer* bufs = nullptr;
+            std::size_t count = 0;
+            char* buf = nullptr;
+            std::size_t len = 0;
+            bool active = false;
+            unsigned interest = 0;
+        };
+
+        op&
+        begin(socket::handle s, op::kind_type kind, void* data) {
+            // the interest of the previous operation is kept
+            auto& o = _ops[s];
+            o.kind = kind;
+            o.data = data;
+            o.sock = s;
+            return o;
+        }
+
+        bool
+        try_send(op& o) {
+            auto sent = sock::send(o.sock, o.bufs, o.count);
+            if (sent != SOCKET_ERROR) {
+                finish(o, static_cast<std::size_t>(sent), 0);
+                return true;
+            }
+            auto err = sock::get_last_error();
+            if (sock::would_block(err))
+                return false;
+            finish(o, 0, err);
+            return true;
+        }
+
+        void
+        arm(op& o, unsigned interest) {
+            if (!o.active) {
+                o.active = true;
+                ++_active;
+            }
+            if (o.interest == interest)
+                return;
+
+            if (o.interest == 0) {
+                _poller.add(o.sock, interest, &o);
+            } else {
+                _poller.modify(o.sock, interest, &o);
+            }
+            o.interest = interest;
+        }
+
+        void
+        finish(op& o, std::size_t bytes, int error) {
+            if (o.active) {
+                o.active = false;
+                --_active;
+            }
+            _done.push_back({o.data, bytes, error});
+        }
+
+        poller _poller;
+        std::unordered_map<socket::handle, op> _ops;
+        std::size_t _active = 0;
+        std::vector<completion> _done;
+        std::vector<poller::event> _events;
+    };
+}
+
+std::unique_ptr<mikrotik::api::impl::reactor>
+mikrotik::api::impl::make_poll_reactor() {
+    return std::make_unique<poll_reactor>();
+}
+
+std::unique_ptr<mikrotik::api::impl::reactor>
+mikrotik::api::impl::make_reactor() {
+#ifdef MIKROTIK_API_IO_URING
+    if (auto ring = make_uring_reactor())
+        return ring;
+#endif
+    return make_poll_reactor();
+}
@@ -0,0 +1,428 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include "impl/reactor.hpp"
+
+// stdlib
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+
+// Linux
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+// project
+#include "impl/socket_funcs.hpp"
+namespace sock = mikrotik::api::impl::socket;
+
+// io_uring is used through its system calls directly, so liburing is not required.
+// rings are only touched by the thread that owns the reactor, the acquire-release
+// pairs are for the kernel's side of the rings.
+namespace {
+    using namespace mikrotik::api::impl;
+
+    constexpr const unsigned ring_entries = 256;
+    constexpr const std::size_t slot_size = 16 * 1024;
+    constexpr const std::size_t slot_count = 64;
+    constexpr const std::size_t max_iov = 64;
+
+    int
+    sys_setup(unsigned entries, io_uring_params* params) noexcept {
+        return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    int
+    sys_enter(int ring, unsigned submit, unsigned min_complete, unsigned flags, const void* arg) noexcept {
+        return static_cast<int>(::syscall(__NR_io_uring_enter, ring, submit, min_complete, flags,
+                                          arg, arg ? sizeof(io_uring_getevents_arg) : 0));
+    }
+
+    int
+    sys_register(int ring, unsigned opcode, const void* arg, unsigned count) noexcept {
+        return static_cast<int>(::syscall(__NR_io_uring_register, ring, opcode, arg, count));
+    }
+
+    template<class T>
+    T*
+    at(void* base, std::size_t off) noexcept {
+        return reinterpret_cast<T*>(static_cast<char*>(base) + off);
+    }
+
+    struct uring_reactor final : reactor {
+        uring_reactor(const uring_reactor&) = delete;
+        uring_reactor& operator=(const uring_reactor&) = delete;
+
+        ~uring_reactor() noexcept override {
+            if (_sqes != MAP_FAILED)
+                ::munmap(_sqes, _sqes_size);
+            if (_rings != MAP_FAILED)
+                ::munmap(_rings, _rings_size);
+            if (_ring >= 0)
+                ::close(_ring);
+        }
+
+        static std::unique_ptr<reactor>
+        create() {
+            std::unique_ptr<uring_reactor> ret(new uring_reactor);
+            if (!ret->setup())
+                return nullptr;
+            return ret;
+        }
+
+        void
+        connect(socket::handle s, const sockaddr& addr, void* data) override {
+            auto& o = alloc(op::connect, s, data);
+            o.addr = addr;
+
+            auto& sqe = next_sqe();
+            sqe.opcode = IORING_OP_CONNECT;
+            sqe.fd = s;
+            sqe.addr = reinterpret_cast<std::uintptr_t>(&o.addr);
+            sqe.off = sizeof(o.addr);
+            sqe.user_data = reinterpret_cast<std::uintptr_t>(&o);
+        }
+
+        void
+        send(socket::handle s, const socket::buffer* bufs, std::size_t count, void* data) override {
+            auto& o = alloc(op::send, s, data);
+            count = std::min(count, max_iov);
+            for (std::size_t i = 0; i < count; ++i) {
+                o.iov[i].iov_base = const_cast<char*>(bufs[i].data);
+                o.iov[i].iov_len = bufs[i].size;
+            }
+            o.msg = {};
+            o.msg.msg_iov = o.iov;
+            o.msg.msg_iovlen = count;
+
+            auto& sqe = next_sqe();
+            sqe.opcode = IORING_OP_SENDMSG;
+            sqe.fd = s;
+            sqe.addr = reinterpret_cast<std::uintptr_t>(&o.msg);
+            sqe.len = 1;
+            sqe.msg_flags = MSG_NOSIGNAL;
+            sqe.user_data = reinterpret_cast<std::uintptr_t>(&o);
+        }
+
+        void
+        recv(socket::handle s, char* buf, std::size_t len, void* data) override {
+            auto& o = alloc(op::recv, s, data);
+            o.buf = buf;
+
+            auto& sqe = next_sqe();
+            sqe.fd = s;
+            sqe.user_data = reinterpret_cast<std::uintptr_t>(&o);
+            if (!_free_slots.empty()) {
+                // read into the registered memory, saving the kernel from mapping
+                // the pages of the buffer for every read, then copy out
+                o.slot = _free_slots.back();
+                _free_slots.pop_back();
+                sqe.opcode = IORING_OP_READ_FIXED;
+                sqe.addr = reinterpret_cast<std::uintptr_t>(_slab.data() + o.slot * slot_size);
+                sqe.len = static_cast<std::uint32_t>(std::min(len, slot_size));
+                sqe.buf_index = 0;
+            } else {
+                sqe.opcode = IORING_OP_RECV;
+                sqe.addr = reinterpret_cast<std::uintptr_t>(buf);
+                sqe.len = static_cast<std::uint32_t>(std::min<std::size_t>(len, UINT32_MAX));
+            }
+        }
+
+        void
+        forget(socket::handle s) noexcept override {
+            for (auto& o : _ops) {
+                if (o.sock != s)
+                    continue;
+                // the completion is dropped when reaped. the cancellation is submitted
+                // right away, before the operation could complete and be reused
+                o.sock = INVALID_SOCKET;
+                o.forgotten = true;
+                auto& sqe = next_sqe();
+                sqe.opcode = IORING_OP_ASYNC_CANCEL;
+                sqe.addr = reinterpret_cast<std::uintptr_t>(&o);
+                sqe.user_data = cancel_data;
+                enter(0, 0, nullptr);
+            }
+        }
+
+        void
+        wait(std::vector<completion>& done, int timeout_ms) override {
+            done.clear();
+            done.swap(_early);
+            if (_pending == 0)
+                return;
+            if (!done.empty())
+                timeout_ms = 0;
+
+            // everything queued since the last wait is submitted with the same call
+            // that waits for the completions
+            __kernel_timespec ts{};
+            ts.tv_sec = timeout_ms / 1000;
+            ts.tv_nsec = (timeout_ms % 1000) * 1000000LL;
+            io_uring_getevents_arg arg{};
+            arg.sigmask_sz = _NSIG / 8;
+            arg.ts = reinterpret_cast<std::uintptr_t>(&ts);
+
+            unsigned flags = IORING_ENTER_EXT_ARG;
+            unsigned min_complete = 0;
+            if (timeout_ms != 0) {
+                flags |= IORING_ENTER_GETEVENTS;
+                min_complete = 1;
+                if (timeout_ms < 0)
+                    arg.ts = 0;
+            }
+            enter(min_complete, flags, &arg);
+            reap(done);
+        }
+
+        std::size_t
+        pending() const noexcept override {
+            return _pending + _early.size();
+        }
+
+    private:
+        struct op {
+            enum kind_type {
+                connect,
+                send,
+                recv
+            };
+
+            kind_type kind;
+            void* data;
+            socket::handle sock;
+            bool forgotten;
+            sockaddr addr;
+            msghdr msg;
+            iovec iov[max_iov];
+            char* buf;
+            std::size_t slot;
+        };
+
+        static constexpr const std::size_t no_slot = static_cast<std::size_t>(-1);
+        // the user data of cancellations, whose completions are not reported
+        static constexpr const std::uint64_t cancel_data = 0;
+
+        uring_reactor() = default;
+
+        bool
+        setup() {
+            io_uring_params params{};
+            _ring = sys_setup(ring_entries, &params);
+            if (_ring < 0)
+                return false;
+
+            // connecting and sending without blocking the submitting thread, and
+            // waiting with a timeout need at least Linux 5.11
+            constexpr const unsigned required = IORING_FEAT_SINGLE_MMAP
+                                                | IORING_FEAT_NODROP
+                                                | IORING_FEAT_FAST_POLL
+                                                | IORING_FEAT_EXT_ARG;
+            if ((params.features & required) != required || !supports_ops())
+                return false;
+
+            _rings_size = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                                   params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+            _rings = ::mmap(nullptr, _rings_size, PROT_READ | PROT_WRITE,
+                            MAP_SHARED | MAP_POPULATE, _ring, IORING_OFF_SQ_RING);
+            if (_rings == MAP_FAILED)
+                return false;
+            _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            _sqes = ::mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE,
+                           MAP_SHARED | MAP_POPULATE, _ring, IORING_OFF_SQES);
+            if (_sqes == MAP_FAILED)
+                return false;
+
+            _sq_head = at<unsigned>(_rings, params.sq_off.head);
+            _sq_tail = at<unsigned>(_rings, params.sq_off.tail);
+            _sq_mask = *at<unsigned>(_rings, params.sq_off.ring_mask);
+            _sq_entries = params.sq_entries;
+            _sq_array = at<unsigned>(_rings, params.sq_off.array);
+            _tail = *_sq_tail;
+            _cq_head = at<unsigned>(_rings, params.cq_off.head);
+            _cq_tail = at<unsigned>(_rings, params.cq_off.tail);
+            _cq_mask = *at<unsigned>(_rings, params.cq_off.ring_mask);
+            _cqes = at<io_uring_cqe>(_rings, params.cq_off.cqes);
+
+            // without registered buffers every read goes straight into the connection's buffer
+            _slab.resize(slot_size * slot_count);
+            iovec slab{_slab.data(), _slab.size()};
+            if (sys_register(_ring, IORING_REGISTER_BUFFERS, &slab, 1) == 0) {
+                for (std::size_t i = slot_count; i > 0; --i) {
+                    _free_slots.push_back(i - 1);
+                }
+            } else {
+                _slab.clear();
+                _slab.shrink_to_fit();
+            }
+            return true;
+        }
+
+        bool
+        supports_ops() const noexcept {
+            alignas(io_uring_probe) unsigned char buf[sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op)]{};
+            auto probe = reinterpret_cast<io_uring_probe*>(buf);
+            if (sys_register(_ring, IORING_REGISTER_PROBE, probe, 256) != 0)
+                return false;
+
+            for (auto code : {IORING_OP_CONNECT, IORING_OP_SENDMSG, IORING_OP_RECV,
+                              IORING_OP_READ_FIXED, IORING_OP_ASYNC_CANCEL}) {
+                if (code > probe->last_op || !(probe->ops[code].flags & IO_URING_OP_SUPPORTED))
+                    return false;
+            }
+            return true;
+        }
+
+        op&
+        alloc(op::kind_type kind, socket::handle s, void* data) {
+            op* o;
+            if (_free_ops.empty()) {
+                o = &_ops.emplace_back();
+            } else {
+                o = _free_ops.back();
+                _free_ops.pop_back();
+            }
+            o->kind = kind;
+            o->data = data;
+            o->sock = s;
+            o->forgotten = false;
+            o->buf = nullptr;
+            o->slot = no_slot;
+            ++_pending;
+            return *o;
+        }
+
+        io_uring_sqe&
+        next_sqe() {
+            // a full submission queue is flushed to the kernel without waiting
+            while (_tail - __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE) == _sq_entries) {
+                enter(0, 0, nullptr);
+                if (_tail - __atomic_load_n(_sq_head, __ATOMIC_ACQUIRE) == _sq_entries) {
+                    // the kernel refuses new submissions until the completions
+                    // are reaped, keep them for the next wait
+                    reap(_early);
+                    enter(0, IORING_ENTER_GETEVENTS, nullptr);
+                }
+            }
+
+            auto idx = _tail & _sq_mask;
+            auto& sqe = static_cast<io_uring_sqe*>(_sqes)[idx];
+            std::memset(&sqe, 0, sizeof(sqe));
+            _sq_array[idx] = idx;
+            ++_tail;
+            ++_unsubmitted;
+            __atomic_store_n(_sq_tail, _tail, __ATOMIC_RELEASE);
+            return sqe;
+        }
+
+        void
+        enter(unsigned min_complete, unsigned flags, const void* arg) {
+            int ret;
+            do {
+                ret = sys_enter(_ring, _unsubmitted, min_complete, flags, arg);
+            } while (ret < 0 && errno == EINTR);
+
+            // on error nothing was submitted: ETIME is just the timeout, and on
+            // EBUSY the completions are reaped right after, making room for the rest
+            if (ret > 0)
+                _unsubmitted -= static_cast<unsigned>(ret);
+        }
+
+        void
+        reap(std::vector<completion>& done) {
+            auto head = *_cq_head;
+            auto tail = __atomic_load_n(_cq_tail, __ATOMIC_ACQUIRE);
+            for (; head != tail; ++head) {
+                const auto& cqe = _cqes[head & _cq_mask];
+                if (cqe.user_data == cancel_data)
+                    continue;
+                auto& o = *reinterpret_cast<op*>(static_cast<std::uintptr_t>(cqe.user_data));
+
+                completion c{o.data, 0, 0};
+                if (cqe.res < 0) {
+                    c.error = -cqe.res;
+                } else {
+                    c.bytes = static_cast<std::size_t>(cqe.res);
+                }
+                if (o.slot != no_slot) {
+                    if (!o.forgotten)
+                        std::memcpy(o.buf, _slab.data() + o.slot * slot_size, c.bytes);
+                    _free_slots.push_back(o.slot);
+                }
+                if (!o.forgotten)
+                    done.push_back(c);
+
+                o.sock = INVALID_SOCKET;
+                _free_ops.push_back(&o);
+                --_pending;
+            }
+            __atomic_store_n(_cq_head, head, __ATOMIC_RELEASE);
+        }
+
+        int _ring = -1;
+        void* _rings = MAP_FAILED;
+        std::size_t _rings_size = 0;
+        void* _sqes = MAP_FAILED;
+        std::size_t _sqes_size = 0;
+
+        unsigned* _sq_head = nullptr;
+        unsigned* _sq_tail = nullptr;
+        unsigned* _sq_array = nullptr;
+        unsigned _sq_mask = 0;
+        unsigned _sq_entries = 0;
+        unsigned _tail = 0;
+        unsigned _unsubmitted = 0;
+
+        unsigned* _cq_head = nullptr;
+        unsigned* _cq_tail = nullptr;
+        unsigned _cq_mask = 0;
+        io_uring_cqe* _cqes = nullptr;
+
+        std::deque<op> _ops;
+        std::vector<op*> _free_ops;
+        std::size_t _pending = 0;
+        std::vector<completion> _early;
+
+        std::vector<char> _slab;
+        std::vector<std::size_t> _free_slots;
+    };
+}
+
+std::unique_ptr<mikrotik::api::impl::reactor>
+mikrotik::api::impl::make_uring_reactor() {
+    return uring_reactor::create();
+}
@@ -0,0 +1,124 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik/api/resilient_handler.hpp>
+
+// stdlib
+#include <thread>
+#include <utility>
+
+// project
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/idempotence.hpp>
+
+mikrotik::api::resilient_handler::resilient_handler(ip_address address,
+                                                    std::string_view user,
+                                                    std::string_view pass,
+                                                    std::uint16_t port,
+                                                    const resilient_options& opts)
+     : _address(std::move(address)),
+       _user(user),
+       _pass(pass),
+       _port(port),
+       _opts(opts),
+       _rng(std::random_device{}()) { }
+
+std::vector<mikrotik::api::reply>
+mikrotik::api::resilient_handler::execute(const sentence& snt) {
+    const auto replay = is_idempotent(snt);
+    for (std::size_t tries = 1;; ++tries) {
+        bool sent = false;
+        try {
+            if (!_api)
+                connect();
+            // a failing send may still have delivered the sentence
+            sent = true;
+            _api->send(snt);
+
+            std::vector<reply> replies;
+            for (;;) {
+                auto rep = _api->read();
+                if (rep.reply_type == reply::fatal)
+                    throw bad_socket("session closed by the device");
+                const auto done = rep.reply_type == reply::done;
+                replies.push_back(std::move(rep));
+                if (done)
+                    return replies;
+            }
+        } catch (const bad_socket&) {
+            reset();
+            ++_failures;
+            if ((sent && !replay) || tries == _opts.retry.attempts)
+                throw;
+        }
+    }
+}
+
+mikrotik::api::api_handler&
+mikrotik::api::resilient_handler::connection() {
+    for (std::size_t tries = 1; !_api; ++tries) {
+        try {
+            connect();
+        } catch (const bad_socket&) {
+            ++_failures;
+            if (tries == _opts.retry.attempts)
+                throw;
+        }
+    }
+    return *_api;
+}
+
+void
+mikrotik::api::resilient_handler::reset() noexcept {
+    _api.reset();
+}
+
+bool
+mikrotik::api::resilient_handler::is_connected() const noexcept {
+    return _api != nullptr;
+}
+
+std::size_t
+mikrotik::api::resilient_handler::reconnects() const noexcept {
+    return _connects == 0 ? 0 : _connects - 1;
+}
+
+void
+mikrotik::api::resilient_handler::connect() {
+    if (_failures != 0)
+        std::this_thread::sleep_for(_opts.retry.delay(_failures - 1, _rng));
+
+    _api = std::make_unique<api_handler>(_address, _user, _pass, _port, _opts.limits);
+    ++_connects;
+    _failures = 0;
+}
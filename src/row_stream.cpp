@@ -0,0 +1,191 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik/api/row_stream.hpp>
+
+// stdlib
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+
+// {fmt}
+#include "lib/fmt.hpp"
+
+// project
+#include <mikrotik/api/api_handler.hpp>
+#include <mikrotik/api/attribute_map.hpp>
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/exception/bad_command.hpp>
+#include <mikrotik/api/exception/bad_socket.hpp>
+
+using namespace mikrotik::api::literals;
+
+namespace {
+    // nothing else uses the connection while the stream is alive, so the tag
+    // only needs to tell the replies of the stream from the reply of its /cancel
+    constexpr const std::string_view tag_value = "0";
+    constexpr const std::string_view tag_word = ".tag=0";
+
+    bool
+    is_tagged(const mikrotik::api::reply_view& rep) noexcept {
+        return std::find(rep.attributes.begin(), rep.attributes.end(), tag_word) != rep.attributes.end();
+    }
+}
+
+mikrotik::api::row_stream::row_stream(api_handler& api, const sentence& snt)
+     : _api{&api} {
+    _api->send(snt, tag_word);
+}
+
+mikrotik::api::row_stream::row_stream(row_stream&& other) noexcept
+     : _api{other._api},
+       _row{std::move(other._row)},
+       _done{std::exchange(other._done, true)} { }
+
+mikrotik::api::row_stream::~row_stream() noexcept {
+    if (_done)
+        return;
+
+    try {
+        // commands like print with =follow= never end on their own, so the
+        // command is cancelled, then both its !done and that of the /cancel are
+        // waited for. if the command ended before the /cancel arrived, the
+        // /cancel fails instead, which is fine
+        _api->send("cancel"_cmd[{"tag", tag_value}]);
+
+        for (bool cancelled = false; !_done || !cancelled;) {
+            const auto& rep = _api->read_view();
+            if (rep.reply_type == reply_view::fatal)
+                break;
+            if (rep.reply_type != reply_view::done)
+                continue;
+
+            if (is_tagged(rep)) {
+                _done = true;
+            } else {
+                cancelled = true;
+            }
+        }
+    } catch (...) {
+        // the connection is broken anyway
+    }
+}
+
+mikrotik::api::row_stream::iterator
+mikrotik::api::row_stream::begin() {
+    advance();
+    return iterator{_done ? nullptr : this};
+}
+
+mikrotik::api::row_stream::iterator
+mikrotik::api::row_stream::end() noexcept {
+    return iterator{};
+}
+
+bool
+mikrotik::api::row_stream::done() const noexcept {
+    return _done;
+}
+
+void
+mikrotik::api::row_stream::advance() {
+    if (_done)
+        return;
+
+    const auto& rep = _api->read_view();
+    switch (rep.reply_type) {
+    case reply_view::re:
+        // the tag is not part of the row
+        _row.reply_type = rep.reply_type;
+        _row.attributes.clear();
+        std::copy_if(rep.attributes.begin(),
+                     rep.attributes.end(),
+                     std::back_inserter(_row.attributes),
+                     [](std::string_view word) { return word != tag_word; });
+        return;
+    case reply_view::done:
+        _done = true;
+        return;
+    case reply_view::trap: {
+        // the message is lost with the next read, so copy it out first
+        std::string message{attribute_map(rep).get("message").value_or("unknown error")};
+        for (auto type = rep.reply_type;
+             type != reply_view::done && type != reply_view::fatal;
+             type = _api->read_view().reply_type) { }
+        _done = true;
+        throw bad_command(message);
+    }
+    case reply_view::fatal:
+        _done = true;
+        throw bad_socket(fmt::format("the device closed the connection: {}",
+                                     rep.attributes.empty() ? "" : rep.attributes.back()));
+    }
+}
+
+mikrotik::api::row_stream::iterator::iterator(row_stream* stream) noexcept
+     : _stream{stream} { }
+
+mikrotik::api::row_stream::iterator::reference
+mikrotik::api::row_stream::iterator::operator*() const noexcept {
+    return _stream->_row;
+}
+
+mikrotik::api::row_stream::iterator::pointer
+mikrotik::api::row_stream::iterator::operator->() const noexcept {
+    return &_stream->_row;
+}
+
+mikrotik::api::row_stream::iterator&
+mikrotik::api::row_stream::iterator::operator++() {
+    _stream->advance();
+    if (_stream->_done)
+        _stream = nullptr;
+    return *this;
+}
+
+void
+mikrotik::api::row_stream::iterator::operator++(int) {
+    ++*this;
+}
+
+bool
+mikrotik::api::row_stream::iterator::operator==(const iterator& other) const noexcept {
+    return _stream == other._stream;
+}
+
+bool
+mikrotik::api::row_stream::iterator::operator!=(const iterator& other) const noexcept {
+    return !(*this == other);
+}
@@ -0,0 +1,89 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include "impl/scan_sentence.hpp"
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/impl/length_codec.hpp>
+
+// {fmt}
+#include "lib/fmt.hpp"
+
+std::size_t
+mikrotik::api::impl::scan_sentence(std::string_view data,
+                                   std::vector<std::string_view>& words,
+                                   std::size_t& need) {
+    words.clear();
+
+    std::size_t pos = 0;
+    for (;;) {
+        std::size_t len;
+        auto prefix = decode_length(data.substr(pos), len);
+        if (prefix == 0) {
+            need = pos + (pos < data.size() ? decoded_size(data[pos]) : 1);
+            return 0;
+        }
+        if (prefix == bad_length)
+            throw bad_socket(fmt::format("received reserved control byte {:#04x} instead of a word",
+                                         static_cast<unsigned char>(data[pos])));
+        pos += prefix;
+
+        if (len == 0)
+            return pos;
+
+        if (data.size() - pos < len) {
+            need = pos + len + 1;// at least the terminating empty word follows
+            return 0;
+        }
+        words.push_back(data.substr(pos, len));
+        pos += len;
+    }
+}
+
+void
+mikrotik::api::impl::make_view(const std::vector<std::string_view>& words, reply_view& view) {
+    view.reply_type = reply::done;
+    view.attributes.clear();
+    for (auto word : words) {
+        if (word == "!done") {
+            view.reply_type = reply::done;
+        } else if (word == "!trap") {
+            view.reply_type = reply::trap;
+        } else if (word == "!fatal") {
+            view.reply_type = reply::fatal;
+        } else if (word == "!re") {
+            view.reply_type = reply::re;
+        } else {
+            view.attributes.push_back(word);
+        }
+    }
+}
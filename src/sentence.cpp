@@ -31,29 +31,104 @@
 // Created by bodand on 2020-06-26.
 //
 
-// {fmt}
-#include "lib/fmt.hpp"
+// stdlib
+#include <algorithm>
+#include <limits>
 
 // project
+#include "impl/calc_len.hpp"
 #include <mikrotik/api/command.hpp>
+#include <mikrotik/api/exception/bad_word.hpp>
 #include <mikrotik/api/sentence.hpp>
 
-mikrotik::api::sentence::sentence(command cmd)
-     : _words{cmd.cmd} {
+mikrotik::api::sentence::sentence(std::pmr::memory_resource* resource) noexcept
+     : _bytes(resource),
+       _words(resource) {
 }
 
-mikrotik::api::sentence::sentence(std::initializer_list<std::string> words)
-     : _words(words.begin(), words.end()) {
+mikrotik::api::sentence::sentence(command cmd) {
+    add_word(cmd.cmd);
+}
+
+mikrotik::api::sentence::sentence(std::initializer_list<std::string> words) {
+    for (const auto& word : words) {
+        add_word(word);
+    }
 }
 
 void
 mikrotik::api::sentence::add_word(std::string_view word) {
-    _words.emplace_back(word.data());
+    char prefix[impl::max_length_size];
+    auto prefix_size = impl::calc_len(word, prefix);
+    if (_bytes.size() + prefix_size + word.size() > std::numeric_limits<std::uint32_t>::max())
+        throw bad_word(std::string(word.substr(0, 32)), "sentence too long to be sent");
+
+    _bytes.append(prefix, prefix_size);
+    auto begin = static_cast<std::uint32_t>(_bytes.size());
+    _bytes.append(word.data(), word.size());
+    _words.push_back({begin, static_cast<std::uint32_t>(word.size())});
+}
+
+void
+mikrotik::api::sentence::add_parts(std::initializer_list<std::string_view> parts) {
+    std::size_t size = 0;
+    for (auto part : parts) {
+        size += part.size();
+    }
+
+    char prefix[impl::max_length_size];
+    auto prefix_size = impl::encode_length(size, prefix);
+    if (prefix_size == 0
+        || _bytes.size() + prefix_size + size > std::numeric_limits<std::uint32_t>::max())
+        throw bad_word(std::string(parts.begin()[1].substr(0, 32)), "word too long");
+
+    _bytes.append(prefix, prefix_size);
+    auto begin = static_cast<std::uint32_t>(_bytes.size());
+    auto out = _bytes.grow(size);
+    for (auto part : parts) {
+        std::copy(part.begin(), part.end(), out);
+        out += part.size();
+    }
+    _words.push_back({begin, static_cast<std::uint32_t>(size)});
+}
+
+mikrotik::api::sentence&
+mikrotik::api::sentence::add_attribute(std::string_view name, std::string_view value) {
+    add_parts({"=", name, "=", value});
+    return *this;
+}
+
+mikrotik::api::sentence&
+mikrotik::api::sentence::add_query(std::string_view name) {
+    add_parts({"?", name});
+    return *this;
+}
+
+mikrotik::api::sentence&
+mikrotik::api::sentence::add_query(std::string_view name, std::string_view value) {
+    add_parts({"?", name, "=", value});
+    return *this;
+}
+
+mikrotik::api::sentence::word_list
+mikrotik::api::sentence::words() const noexcept {
+    return word_list(this);
+}
+
+std::string_view
+mikrotik::api::sentence::encoded() const noexcept {
+    return {_bytes.data(), _bytes.size()};
+}
+
+std::pmr::memory_resource*
+mikrotik::api::sentence::memory_resource() const noexcept {
+    return _bytes.resource();
 }
 
-const std::vector<std::string>&
-mikrotik::api::sentence::words() const {
-    return _words;
+std::string_view
+mikrotik::api::sentence::word(std::size_t idx) const noexcept {
+    auto pos = _words.data()[idx];
+    return {_bytes.data() + pos.begin, pos.size};
 }
 
 mikrotik::api::sentence&
@@ -64,7 +139,7 @@ mikrotik::api::sentence::operator[](mikrotik::api::attribute attr) && {
 
 mikrotik::api::sentence
 mikrotik::api::sentence::operator[](mikrotik::api::attribute attr) const& {
-    sentence ret(_words.begin(), _words.end());
+    sentence ret(*this);
     ret.add_word(attr.value);
     return ret;
 }
@@ -77,7 +152,104 @@ mikrotik::api::sentence::operator()(mikrotik::api::query q) && {
 
 mikrotik::api::sentence
 mikrotik::api::sentence::operator()(mikrotik::api::query q) const& {
-    sentence ret(_words.begin(), _words.end());
+    sentence ret(*this);
     ret.add_word(q.value);
     return ret;
 }
+
+mikrotik::api::sentence::word_list::const_iterator
+mikrotik::api::sentence::word_list::begin() const noexcept {
+    return {_snt, 0};
+}
+
+mikrotik::api::sentence::word_list::const_iterator
+mikrotik::api::sentence::word_list::end() const noexcept {
+    return {_snt, size()};
+}
+
+std::size_t
+mikrotik::api::sentence::word_list::size() const noexcept {
+    return _snt->_words.size();
+}
+
+bool
+mikrotik::api::sentence::word_list::empty() const noexcept {
+    return size() == 0;
+}
+
+std::string_view
+mikrotik::api::sentence::word_list::operator[](std::size_t idx) const noexcept {
+    return _snt->word(idx);
+}
+
+std::string_view
+mikrotik::api::sentence::word_list::front() const noexcept {
+    return _snt->word(0);
+}
+
+std::string_view
+mikrotik::api::sentence::word_list::back() const noexcept {
+    return _snt->word(size() - 1);
+}
+
+mikrotik::api::sentence::word_list::operator std::vector<std::string>() const {
+    return std::vector<std::string>(begin(), end());
+}
+
+bool
+mikrotik::api::sentence::word_list::operator==(const word_list& other) const noexcept {
+    return std::equal(begin(), end(), other.begin(), other.end());
+}
+
+bool
+mikrotik::api::sentence::word_list::operator!=(const word_list& other) const noexcept {
+    return !(*this == other);
+}
+
+std::string_view
+mikrotik::api::sentence::word_list::const_iterator::operator*() const noexcept {
+    return _snt->word(_idx);
+}
+
+std::string_view
+mikrotik::api::sentence::word_list::const_iterator::operator[](difference_type n) const noexcept {
+    return _snt->word(static_cast<std::size_t>(static_cast<difference_type>(_idx) + n));
+}
+
+mikrotik::api::sentence::word_list::const_iterator&
+mikrotik::api::sentence::word_list::const_iterator::operator++() noexcept {
+    ++_idx;
+    return *this;
+}
+
+mikrotik::api::sentence::word_list::const_iterator
+mikrotik::api::sentence::word_list::const_iterator::operator++(int) noexcept {
+    auto ret = *this;
+    ++_idx;
+    return ret;
+}
+
+mikrotik::api::sentence::word_list::const_iterator&
+mikrotik::api::sentence::word_list::const_iterator::operator--() noexcept {
+    --_idx;
+    return *this;
+}
+
+mikrotik::api::sentence::word_list::const_iterator
+mikrotik::api::sentence::word_list::const_iterator::operator--(int) noexcept {
+    auto ret = *this;
+    --_idx;
+    return ret;
+}
+
+mikrotik::api::sentence::word_list::const_iterator&
+mikrotik::api::sentence::word_list::const_iterator::operator+=(difference_type n) noexcept {
+    _idx = static_cast<std::size_t>(static_cast<difference_type>(_idx) + n);
+    return *this;
+}
+
+mikrotik::api::sentence::word_list::const_iterator&
+mikrotik::api::sentence::word_list::const_iterator::operator-=(difference_type n) noexcept {
+    _idx = static_cast<std::size_t>(static_cast<difference_type>(_idx) - n);
+    return *this;
+}
@@ -0,0 +1,370 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik/api/shared_connection.hpp>
+
+// stdlib
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+// {fmt}
+#include "lib/fmt.hpp"
+
+// project
+#include "impl/mpsc_queue.hpp"
+#include "impl/socket_funcs.hpp"
+#include <mikrotik/api/api_handler.hpp>
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/exception/socket_timeout.hpp>
+namespace sock = mikrotik::api::impl::socket;
+
+namespace {
+    constexpr const std::string_view tag_word = ".tag=";
+}
+
+struct mikrotik::api::shared_connection::request : impl::mpsc_node {
+    sentence snt;
+    completion done;
+    std::optional<std::promise<std::vector<reply>>> promise;
+    std::vector<reply> replies;
+
+    void complete(std::exception_ptr error) noexcept {
+        if (!promise) {
+            try {
+                done(std::move(replies), std::move(error));
+            } catch (...) {
+                // nobody on the I/O thread could handle it, and the other
+                // sentences must still be completed
+            }
+            return;
+        }
+        if (error)
+            promise->set_exception(std::move(error));
+        else
+            promise->set_value(std::move(replies));
+    }
+};
+
+struct mikrotik::api::shared_connection::state {
+    state(ip_address address,
+          std::string_view user,
+          std::string_view pass,
+          std::uint16_t port,
+          const timeouts& limits)
+         : api(address, user, pass, port, limits),
+           limit(limits.operation) { }
+
+    api_handler api;
+    std::chrono::milliseconds limit;
+    sock::handle wakeup = INVALID_SOCKET;
+    std::thread io;
+
+    // shared with the submitting threads
+    impl::mpsc_queue<request> queue;
+    std::atomic<bool> signalled{false};
+    std::atomic<bool> stopping{false};
+    std::atomic<bool> failed{false};
+    std::atomic<std::size_t> pending{0};
+
+    // owned by the I/O thread
+    std::unordered_map<std::uint32_t, std::unique_ptr<request>> in_flight;
+    std::uint32_t next_tag = 1;
+    std::exception_ptr error;
+    // the next sentence must be sent, or the next reply read by then
+    std::chrono::steady_clock::time_point deadline;
+
+    void progress() {
+        deadline = std::chrono::steady_clock::now() + limit;
+    }
+
+    int timeout() const {
+        if (limit.count() <= 0 || in_flight.empty())
+            return -1;
+        auto left = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        return static_cast<int>(std::max<std::chrono::milliseconds::rep>(left.count(), 0));
+    }
+};
+
+mikrotik::api::shared_connection::shared_connection(ip_address address,
+                                                    std::string_view user,
+                                                    std::string_view pass,
+                                                    std::uint16_t port,
+                                                    const timeouts& limits)
+     : _state(std::make_unique<state>(address, user, pass, port, limits)) {
+    auto& st = *_state;
+    // the I/O thread waits for the socket and the wakeup at once, never blocking on either
+    if (sock::set_nonblocking(st.api._sock, true) != 0)
+        throw bad_socket(fmt::format("making socket non-blocking failed: {}",
+                                     sock::string_error(sock::get_last_error())));
+    st.wakeup = sock::make_wakeup();
+    if (!sock::is_valid(st.wakeup))
+        throw bad_socket(fmt::format("creating wakeup socket failed: {}",
+                                     sock::string_error(sock::get_last_error())));
+
+    st.io = std::thread([this] { run(); });
+}
+
+mikrotik::api::shared_connection::~shared_connection() noexcept {
+    auto& st = *_state;
+    st.stopping.store(true);
+    char byte = 0;
+    impl::socket::buffer buf{&byte, 1};
+    sock::send(st.wakeup, &buf, 1);
+    st.io.join();
+
+    // everything not completed by now never will
+    fail(std::make_exception_ptr(bad_socket("connection closed while the sentence was in flight")));
+    sock::close(st.wakeup);
+}
+
+std::future<std::vector<mikrotik::api::reply>>
+mikrotik::api::shared_connection::submit(sentence snt) {
+    auto req = std::make_unique<request>();
+    req->snt = std::move(snt);
+    auto ret = req->promise.emplace().get_future();
+    enqueue(req.release());
+    return ret;
+}
+
+void
+mikrotik::api::shared_connection::submit(sentence snt, completion done) {
+    if (!done)
+        throw std::invalid_argument("shared_connection: the completion of a sentence must not be empty");
+    auto req = std::make_unique<request>();
+    req->snt = std::move(snt);
+    req->done = std::move(done);
+    enqueue(req.release());
+}
+
+bool
+mikrotik::api::shared_connection::failed() const noexcept {
+    return _state->failed.load();
+}
+
+std::size_t
+mikrotik::api::shared_connection::pending() const noexcept {
+    return _state->pending.load(std::memory_order_relaxed);
+}
+
+void
+mikrotik::api::shared_connection::enqueue(request* req) {
+    auto& st = *_state;
+    st.pending.fetch_add(1, std::memory_order_relaxed);
+    st.queue.push(req);
+
+    // only the first submitter since the I/O thread last looked at the queue
+    // wakes it, the rest only push
+    if (!st.signalled.exchange(true)) {
+        char byte = 0;
+        impl::socket::buffer buf{&byte, 1};
+        sock::send(st.wakeup, &buf, 1);
+    }
+}
+
+void
+mikrotik::api::shared_connection::run() noexcept {
+    auto& st = *_state;
+    pollfd fds[2]{};
+    fds[0].fd = st.wakeup;
+    fds[0].events = POLLIN;
+    fds[1].fd = st.api._sock;
+
+    while (!st.stopping.load()) {
+        try {
+            // requests pushed after this are signalled again, so none are missed
+            st.signalled.exchange(false);
+            while (auto req = st.queue.pop()) {
+                start(req);
+            }
+            if (!st.failed.load())
+                flush();
+
+            fds[1].events = POLLIN;
+            if (!st.api._proto.next_output().empty())
+                fds[1].events |= POLLOUT;
+            // a failed connection only waits for new requests to fail
+            auto count = st.failed.load() ? 1u : 2u;
+            auto ready = sock::poll(fds, count, count == 2 ? st.timeout() : -1);
+            if (ready == SOCKET_ERROR)
+                throw bad_socket(fmt::format("failure while waiting for the connection: {}",
+                                             sock::string_error(sock::get_last_error())));
+            if (ready == 0)
+                throw socket_timeout(fds[1].events & POLLOUT ? "sending a sentence" : "reading a reply",
+                                     st.limit);
+
+            if (fds[0].revents != 0) {
+                char buf[64];
+                while (sock::recv(st.wakeup, buf, sizeof(buf)) > 0) { }
+            }
+            if (count == 2 && (fds[1].revents & (POLLIN | POLLERR | POLLHUP)) != 0) {
+                receive();
+                dispatch();
+            }
+        } catch (...) {
+            fail(std::current_exception());
+        }
+    }
+}
+
+void
+mikrotik::api::shared_connection::start(request* ptr) {
+    std::unique_ptr<request> req(ptr);
+    auto& st = *_state;
+    if (st.failed.load()) {
+        st.pending.fetch_sub(1, std::memory_order_relaxed);
+        return req->complete(st.error);
+    }
+
+    auto tag = st.next_tag++;
+    if (st.next_tag == 0)
+        st.next_tag = 1;
+
+    char word[tag_word.size() + 10];
+    std::memcpy(word, tag_word.data(), tag_word.size());
+    auto [end, _] = std::to_chars(word + tag_word.size(), word + sizeof(word), tag);
+
+    st.api._proto.send(req->snt, {word, static_cast<std::size_t>(end - word)});
+    // the time limit starts with the first sentence in flight
+    if (st.in_flight.empty())
+        st.progress();
+    st.in_flight.emplace(tag, std::move(req));
+}
+
+void
+mikrotik::api::shared_connection::flush() {
+    auto& st = *_state;
+    auto& proto = st.api._proto;
+    for (auto out = proto.next_output(); !out.empty(); out = proto.next_output()) {
+        auto sent = sock::send(st.api._sock, out.bufs, out.count);
+        if (sent == SOCKET_ERROR) {
+            auto err = sock::get_last_error();
+            // the rest is sent when the socket becomes writable again
+            if (sock::would_block(err))
+                return;
+            throw bad_socket(fmt::format("failure while sending sentence: {}",
+                                         sock::string_error(err)));
+        }
+        proto.consume_output(static_cast<std::size_t>(sent));
+        st.progress();
+    }
+}
+
+void
+mikrotik::api::shared_connection::receive() {
+    auto& st = *_state;
+    auto& proto = st.api._proto;
+    auto buf = proto.prepare_input(proto.needed());
+    auto read = sock::recv(st.api._sock, buf, proto.input_space());
+
+    if (read == SOCKET_ERROR) {
+        auto err = sock::get_last_error();
+        if (sock::would_block(err))
+            return;
+        throw bad_socket(fmt::format("failure while reading: {}", sock::string_error(err)));
+    }
+    if (read == 0)
+        throw bad_socket("connection closed by the device");
+
+    proto.commit_input(static_cast<std::size_t>(read));
+}
+
+void
+mikrotik::api::shared_connection::dispatch() {
+    auto& st = *_state;
+    auto& proto = st.api._proto;
+    while (proto.next_event() == protocol::received) {
+        const auto& view = proto.view();
+        st.progress();
+
+        std::optional<std::uint32_t> tag;
+        reply rep;
+        rep.reply_type = view.reply_type;
+        rep.attributes.reserve(view.attributes.size());
+        for (auto word : view.attributes) {
+            if (word.substr(0, tag_word.size()) == tag_word) {
+                std::uint32_t value;
+                auto beg = word.data() + tag_word.size();
+                auto end = word.data() + word.size();
+                if (auto [ptr, err] = std::from_chars(beg, end, value);
+                    err == std::errc{} && ptr == end) {
+                    tag = value;
+                    continue;
+                }
+            }
+            rep.attributes.emplace_back(word);
+        }
+
+        // untagged replies only come on fatal errors, which affect everyone
+        if (!tag)
+            throw bad_socket(fmt::format("the device sent a fatal error: {}",
+                                         rep.attributes.empty() ? "" : rep.attributes.front()));
+
+        auto it = st.in_flight.find(*tag);
+        if (it == st.in_flight.end())
+            continue;
+        it->second->replies.push_back(std::move(rep));
+        if (view.reply_type == reply::done) {
+            auto req = std::move(it->second);
+            st.in_flight.erase(it);
+            st.pending.fetch_sub(1, std::memory_order_relaxed);
+            req->complete({});
+        }
+    }
+}
+
+void
+mikrotik::api::shared_connection::fail(std::exception_ptr error) noexcept {
+    auto& st = *_state;
+    if (!st.failed.exchange(true))
+        st.error = std::move(error);
+
+    // the buffers not written yet point into the requests about to be destroyed
+    st.api._proto.discard_output();
+    for (auto& [tag, req] : st.in_flight) {
+        st.pending.fetch_sub(1, std::memory_order_relaxed);
+        req->complete(st.error);
+    }
+    st.in_flight.clear();
+    while (auto req = st.queue.pop()) {
+        st.pending.fetch_sub(1, std::memory_order_relaxed);
+        std::unique_ptr<request>(req)->complete(st.error);
+    }
+}
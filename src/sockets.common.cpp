@@ -35,11 +35,67 @@
 
 #include "impl/socket_funcs.hpp"
 
+// stdlib
+#include <cstring>
+
 mikrotik::api::impl::socket::handle
 mikrotik::api::impl::socket::create(int domain, int type, int protocol) noexcept {
     handle sock = ::socket(domain, type, protocol);
     if (!is_valid(sock)) {
         finish();
+        return sock;
     }
+    no_sigpipe(sock);
     return sock;
 }
+
+int
+mikrotik::api::impl::socket::connect(handle sock, sockaddr addr) noexcept {
+    return ::connect(sock, &addr, sizeof(addr));
+}
+
+mikrotik::api::impl::socket::handle
+mikrotik::api::impl::socket::make_wakeup() noexcept {
+    handle sock = create(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (!is_valid(sock))
+        return sock;
+
+    sockaddr_in loopback{};
+    loopback.sin_family = AF_INET;
+    loopback.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    sockaddr addr;
+    std::memcpy(&addr, &loopback, sizeof(sockaddr));
+
+    // bind to any free port, then connect to the port got
+    socklen_t len = sizeof(addr);
+    if (::bind(sock, &addr, sizeof(addr)) == SOCKET_ERROR
+        || getsockname(sock, &addr, &len) == SOCKET_ERROR
+        || connect(sock, addr) == SOCKET_ERROR
+        || set_nonblocking(sock, true) != 0) {
+        close(sock);
+        return INVALID_SOCKET;
+    }
+    return sock;
+}
+
+int
+mikrotik::api::impl::socket::pending_error(handle sock) noexcept {
+    int err = 0;
+    socklen_t len = sizeof(err);
+    if (getsockopt(sock, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&err), &len) == SOCKET_ERROR)
+        return get_last_error();
+    return err;
+}
+
+sockaddr
+mikrotik::api::impl::socket::make_address(const ip_address& address, std::uint16_t port) noexcept {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    // the bytes are stored in network order already
+    std::memcpy(&addr.sin_addr, address._bytes.data(), address._bytes.size());
+    addr.sin_port = htons(port);
+
+    sockaddr ret;
+    std::memcpy(&ret, &addr, sizeof(sockaddr));
+    return ret;
+}
@@ -35,6 +35,15 @@
 #include <mikrotik/api/impl/sockets.hpp>
 
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+
+// don't die from SIGPIPE if the device hangs up: sends are flagged with MSG_NOSIGNAL,
+// or where it does not exist, like on macOS, sockets are created with SO_NOSIGPIPE
+#ifndef MSG_NOSIGNAL
+#    define MIKROTIK_API_SO_NOSIGPIPE
+#    define MSG_NOSIGNAL 0
+#endif
 
 bool
 mikrotik::api::impl::socket::is_valid(handle sock) noexcept {
@@ -51,12 +60,69 @@ mikrotik::api::impl::socket::finish() noexcept {
     return 0;
 }
 
+void
+mikrotik::api::impl::socket::no_sigpipe([[maybe_unused]] handle sock) noexcept {
+#if defined(MIKROTIK_API_SO_NOSIGPIPE) && defined(SO_NOSIGPIPE)
+    int on = 1;
+    setsockopt(sock, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+}
+
 int
 mikrotik::api::impl::socket::close(handle sock) noexcept {
-    int ret = shutdown(sock, SHUT_RDWR);
-    if (ret == 0) {
-        return ::close(sock);
+    // shutdown fails on sockets that were never connected, but they must
+    // be closed all the same
+    shutdown(sock, SHUT_RDWR);
+    return ::close(sock);
+}
+
+std::ptrdiff_t
+mikrotik::api::impl::socket::recv(handle sock, char* buf, std::size_t len) noexcept {
+    ssize_t ret;
+    do {
+        ret = ::recv(sock, buf, len, 0);
+    } while (ret == -1 && errno == EINTR);
+    return ret;
+}
+
+std::ptrdiff_t
+mikrotik::api::impl::socket::send(handle sock, const buffer* bufs, std::size_t count) noexcept {
+    constexpr const std::size_t max_iov = 64;
+    iovec iov[max_iov];
+
+    if (count > max_iov)
+        count = max_iov;
+    for (std::size_t i = 0; i < count; ++i) {
+        iov[i].iov_base = const_cast<char*>(bufs[i].data);
+        iov[i].iov_len = bufs[i].size;
     }
+
+    msghdr msg{};
+    msg.msg_iov = iov;
+    msg.msg_iovlen = count;
+
+    ssize_t ret;
+    do {
+        ret = ::sendmsg(sock, &msg, MSG_NOSIGNAL);
+    } while (ret == -1 && errno == EINTR);
+    return ret;
+}
+
+int
+mikrotik::api::impl::socket::set_nonblocking(handle sock, bool nonblocking) noexcept {
+    int flags = fcntl(sock, F_GETFL, 0);
+    if (flags == -1)
+        return -1;
+    flags = nonblocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+    return fcntl(sock, F_SETFL, flags);
+}
+
+int
+mikrotik::api::impl::socket::poll(pollfd* fds, std::size_t count, int timeout_ms) noexcept {
+    int ret;
+    do {
+        ret = ::poll(fds, static_cast<nfds_t>(count), timeout_ms);
+    } while (ret == -1 && errno == EINTR);
     return ret;
 }
 
@@ -65,6 +131,20 @@ mikrotik::api::impl::socket::get_last_error() noexcept {
     return errno;
 }
 
+bool
+mikrotik::api::impl::socket::would_block(int err) noexcept {
+#if EAGAIN == EWOULDBLOCK
+    return err == EAGAIN;
+#else
+    return err == EAGAIN || err == EWOULDBLOCK;
+#endif
+}
+
+bool
+mikrotik::api::impl::socket::in_progress(int err) noexcept {
+    return err == EINPROGRESS;
+}
+
 std::string_view
 mikrotik::api::impl::socket::string_error(int err) noexcept {
     switch (err) {
@@ -34,6 +34,8 @@
 #include "impl/socket_funcs.hpp"
 #include <mikrotik/api/impl/sockets.hpp>
 
+#include <limits>
+
 bool
 mikrotik::api::impl::socket::is_valid(handle sock) noexcept {
     return sock != INVALID_SOCKET;
@@ -50,13 +52,53 @@ mikrotik::api::impl::socket::finish() noexcept {
     return WSACleanup();
 }
 
+void
+mikrotik::api::impl::socket::no_sigpipe(handle) noexcept {
+    // there are no signals on Windows
+}
+
 int
 mikrotik::api::impl::socket::close(handle sock) noexcept {
-    int ret = shutdown(sock, SD_BOTH);
-    if (ret == 0) {
-        return closesocket(sock);
+    // shutdown fails on sockets that were never connected, but they must
+    // be closed all the same
+    shutdown(sock, SD_BOTH);
+    return closesocket(sock);
+}
+
+std::ptrdiff_t
+mikrotik::api::impl::socket::recv(handle sock, char* buf, std::size_t len) noexcept {
+    // WinSock takes an int as length
+    auto max = static_cast<std::size_t>(std::numeric_limits<int>::max());
+    return ::recv(sock, buf, static_cast<int>(len < max ? len : max), 0);
+}
+
+std::ptrdiff_t
+mikrotik::api::impl::socket::send(handle sock, const buffer* bufs, std::size_t count) noexcept {
+    constexpr const std::size_t max_bufs = 64;
+    WSABUF wsa_bufs[max_bufs];
+
+    if (count > max_bufs)
+        count = max_bufs;
+    for (std::size_t i = 0; i < count; ++i) {
+        wsa_bufs[i].buf = const_cast<CHAR*>(bufs[i].data);
+        wsa_bufs[i].len = static_cast<ULONG>(bufs[i].size);
     }
-    return ret;
+
+    DWORD sent = 0;
+    if (WSASend(sock, wsa_bufs, static_cast<DWORD>(count), &sent, 0, nullptr, nullptr) == SOCKET_ERROR)
+        return SOCKET_ERROR;
+    return static_cast<std::ptrdiff_t>(sent);
+}
+
+int
+mikrotik::api::impl::socket::set_nonblocking(handle sock, bool nonblocking) noexcept {
+    u_long mode = nonblocking ? 1 : 0;
+    return ioctlsocket(sock, FIONBIO, &mode);
+}
+
+int
+mikrotik::api::impl::socket::poll(pollfd* fds, std::size_t count, int timeout_ms) noexcept {
+    return WSAPoll(fds, static_cast<ULONG>(count), timeout_ms);
 }
 
 int
@@ -64,6 +106,17 @@ mikrotik::api::impl::socket::get_last_error() noexcept {
     return WSAGetLastError();
 }
 
+bool
+mikrotik::api::impl::socket::would_block(int err) noexcept {
+    return err == WSAEWOULDBLOCK;
+}
+
+bool
+mikrotik::api::impl::socket::in_progress(int err) noexcept {
+    // a non-blocking connect reports would block on WinSock
+    return err == WSAEWOULDBLOCK || err == WSAEINPROGRESS;
+}
+
 std::string_view
 mikrotik::api::impl::socket::string_error(int err) noexcept {
     switch (err) {
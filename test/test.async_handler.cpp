@@ -0,0 +1,211 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+// stdlib
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <string>
+#include <vector>
+
+// test'd
+#include <mikrotik/api/async_handler.hpp>
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/event_loop.hpp>
+#include <mikrotik/api/exception/bad_command.hpp>
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/exception/socket_timeout.hpp>
+#include <mikrotik/api/mock/server.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+using namespace std::chrono_literals;
+
+namespace {
+    task<std::vector<reply>>
+    print_identity(event_loop& loop, const mock::server& srv) {
+        async_handler api(loop);
+        co_await api.connect(srv.address(), "admin", "", srv.port());
+        co_return co_await api.execute("system"_cmd / "identity" / "print");
+    }
+
+    task<void>
+    log_in(event_loop& loop, ip_address address, std::uint16_t port, std::string pass, timeouts limits = {}) {
+        async_handler api(loop);
+        co_await api.connect(address, "admin", std::move(pass), port, limits);
+    }
+
+    task<std::vector<reply>>
+    execute_limited(event_loop& loop, const mock::server& srv, sentence snt, timeouts limits) {
+        async_handler api(loop);
+        co_await api.connect(srv.address(), "admin", "", srv.port(), limits);
+        co_return co_await api.execute(std::move(snt));
+    }
+
+    mock::row
+    interface(std::size_t i) {
+        return {{"name", "ether" + std::to_string(i)}};
+    }
+
+    task<std::vector<reply>>
+    execute_unknown(event_loop& loop, const mock::server& srv) {
+        async_handler api(loop);
+        co_await api.connect(srv.address(), "admin", "", srv.port());
+        co_return co_await api.execute("no"_cmd / "such" / "command");
+    }
+
+    task<std::size_t>
+    count_rows(event_loop& loop, const mock::server& srv) {
+        async_handler api(loop);
+        co_await api.connect(srv.address(), "admin", "", srv.port());
+
+        std::size_t count = 0;
+        auto rows = api.rows("interface"_cmd / "print");
+        while (auto row = co_await rows.next()) {
+            REQUIRE(row->reply_type == reply::re);
+            ++count;
+        }
+        co_return count;
+    }
+
+    task<std::vector<reply>>
+    abandon_rows(event_loop& loop, const mock::server& srv) {
+        async_handler api(loop);
+        co_await api.connect(srv.address(), "admin", "", srv.port());
+
+        {
+            auto rows = api.rows("interface"_cmd / "print");
+            co_await rows.next();
+            co_await rows.next();
+        }
+        co_return co_await api.execute("system"_cmd / "identity" / "print");
+    }
+}
+
+TEST_CASE("async_handler connects and executes a command",
+          "[async_handler][e2e][coroutine][api]") {
+    mock::server srv;
+    srv.table("/system/identity", {{{"name", "MikroTik"}}});
+    event_loop loop;
+
+    auto replies = loop.run(print_identity(loop, srv));
+
+    REQUIRE(replies.size() == 2);
+    CHECK(replies[0].reply_type == reply::re);
+    CHECK(replies[0].attributes == std::vector<std::string>{"=name=MikroTik"});
+    CHECK(replies[1].reply_type == reply::done);
+    CHECK(srv.connections() == 1);
+}
+
+TEST_CASE("async_handler fails to log in with a bad password",
+          "[async_handler][e2e][coroutine][api]") {
+    mock::server srv;
+    event_loop loop;
+
+    CHECK_THROWS_AS(loop.run(log_in(loop, srv.address(), srv.port(), "wrong")), bad_socket);
+}
+
+TEST_CASE("async_handler fails to connect to a closed port",
+          "[async_handler][e2e][coroutine][api]") {
+    std::optional<mock::server> srv(std::in_place);
+    auto address = srv->address();
+    auto port = srv->port();
+    srv.reset();
+    event_loop loop;
+
+    CHECK_THROWS_AS(loop.run(log_in(loop, address, port, "")), bad_socket);
+}
+
+TEST_CASE("async_handler throws bad_command on a trap",
+          "[async_handler][e2e][coroutine][api]") {
+    mock::server srv;
+    event_loop loop;
+
+    CHECK_THROWS_AS(loop.run(execute_unknown(loop, srv)), bad_command);
+}
+
+TEST_CASE("async_handler streams every row",
+          "[async_handler][e2e][coroutine][api]") {
+    mock::server srv;
+    srv.generate("/interface", 1000, interface);
+    event_loop loop;
+
+    CHECK(loop.run(count_rows(loop, srv)) == 1000);
+}
+
+TEST_CASE("async_handler drops the rest of abandoned rows",
+          "[async_handler][e2e][coroutine][api]") {
+    mock::server srv;
+    srv.generate("/interface", 100, interface);
+    srv.table("/system/identity", {{{"name", "MikroTik"}}});
+    event_loop loop;
+
+    auto replies = loop.run(abandon_rows(loop, srv));
+
+    REQUIRE(replies.size() == 2);
+    CHECK(replies[0].attributes == std::vector<std::string>{"=name=MikroTik"});
+    CHECK(replies[1].reply_type == reply::done);
+}
+
+TEST_CASE("async_handler times out a device not answering",
+          "[async_handler][socket_timeout][e2e][coroutine][api]") {
+    mock::server srv;
+    // answered only when the test finishes, releasing the thread of the server
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    srv.on("/stall", [released](const mock::request&) {
+        released.wait_for(10s);
+        return std::vector<reply>{{reply::done, {}}};
+    });
+    event_loop loop;
+
+    timeouts limits;
+    limits.operation = 100ms;
+    auto start = std::chrono::steady_clock::now();
+    CHECK_THROWS_AS(loop.run(execute_limited(loop, srv, "stall"_cmd, limits)), socket_timeout);
+    CHECK(std::chrono::steady_clock::now() - start < 5s);
+    release.set_value();
+}
+
+TEST_CASE("async_handler times out the login as a whole",
+          "[async_handler][socket_timeout][e2e][coroutine][api]") {
+    mock::server srv;
+    srv.latency(300ms);
+    event_loop loop;
+
+    timeouts limits;
+    limits.login = 100ms;
+    CHECK_THROWS_AS(loop.run(log_in(loop, srv.address(), srv.port(), "", limits)), socket_timeout);
+}
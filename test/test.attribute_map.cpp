@@ -0,0 +1,113 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+#include <string_view>
+#include <type_traits>
+using namespace std::literals;
+
+// test'd
+#include <mikrotik/api/attribute_map.hpp>
+using namespace mikrotik::api;
+
+TEST_CASE("attribute_map finds attributes by name",
+          "[attribute_map][reply][api]") {
+    reply rep{reply::re, {"=.id=*1", "=name=ether1", "=rx-byte=1024"}};
+    attribute_map attrs(rep);
+
+    CHECK(attrs.size() == 3);
+    CHECK(attrs.get(".id") == "*1"sv);
+    CHECK(attrs.get("name") == "ether1"sv);
+    CHECK(attrs.get("rx-byte") == "1024"sv);
+}
+
+TEST_CASE("attribute_map returns nothing for missing attributes",
+          "[attribute_map][reply][api]") {
+    reply rep{reply::re, {"=name=ether1"}};
+    attribute_map attrs(rep);
+
+    CHECK_FALSE(attrs.get("tx-byte").has_value());
+    CHECK_FALSE(attrs.contains("tx-byte"));
+}
+
+TEST_CASE("attribute_map keeps equals signs and emptiness of values",
+          "[attribute_map][reply][api]") {
+    reply rep{reply::re, {"=comment=a=b", "=address="}};
+    attribute_map attrs(rep);
+
+    CHECK(attrs.get("comment") == "a=b"sv);
+    CHECK(attrs.get("address") == ""sv);
+    CHECK(attrs.contains("address"));
+}
+
+TEST_CASE("attribute_map indexes API attribute words with their leading period",
+          "[attribute_map][reply][api]") {
+    reply rep{reply::done, {".tag=42"}};
+    attribute_map attrs(rep);
+
+    CHECK(attrs.get(".tag") == "42"sv);
+}
+
+TEST_CASE("attribute_map can be reused for a new reply",
+          "[attribute_map][reply][api]") {
+    reply rep1{reply::re, {"=name=ether1"}};
+    reply rep2{reply::re, {"=name=ether2", "=mtu=1500"}};
+    attribute_map attrs(rep1);
+    attrs.assign(rep2);
+
+    CHECK(attrs.size() == 2);
+    CHECK(attrs.get("name") == "ether2"sv);
+    CHECK(attrs.get("mtu") == "1500"sv);
+}
+
+TEST_CASE("attribute_map works with many attributes and prehashed keys",
+          "[attribute_map][reply][api]") {
+    reply rep{reply::re, {}};
+    for (int i = 0; i < 100; ++i) {
+        rep.attributes.push_back("=attr" + std::to_string(i) + "=" + std::to_string(i * 2));
+    }
+    attribute_map attrs(rep);
+    constexpr attribute_map::key key50("attr50");
+
+    CHECK(attrs.size() == 100);
+    CHECK(attrs.get(key50) == "100"sv);
+    CHECK(attrs.get("attr99") == "198"sv);
+}
+
+TEST_CASE("attribute_map cannot index temporary replies",
+          "[attribute_map][reply][api]") {
+    CHECK_FALSE(std::is_constructible_v<attribute_map, reply&&>);
+    CHECK(std::is_constructible_v<attribute_map, const reply&>);
+    CHECK(std::is_constructible_v<attribute_map, reply_view&&>);
+}
@@ -0,0 +1,146 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+// stdlib
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// test'd
+#include <mikrotik/api/bootstrap.hpp>
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/exception/socket_timeout.hpp>
+#include <mikrotik/api/mock/server.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+using namespace std::chrono_literals;
+
+namespace {
+    std::uint16_t
+    closed_port() {
+        mock::server srv;
+        return srv.port();
+    }
+}
+
+TEST_CASE("bootstrap connects to every device",
+          "[bootstrap][e2e][api]") {
+    mock::server first;
+    mock::server second;
+    second.add_user("reader", "secret");
+    second.table("/system/identity", {{{"name", "second"}}});
+
+    std::vector<endpoint> devices{{first.address(), "admin", "", first.port()},
+                                  {second.address(), "reader", "secret", second.port()},
+                                  {first.address(), "admin", "", first.port()}};
+    auto results = bootstrap(devices);
+
+    REQUIRE(results.size() == 3);
+    for (const auto& res : results) {
+        REQUIRE(res.api);
+        CHECK_FALSE(res.error);
+    }
+    CHECK(first.connections() == 2);
+    CHECK(second.connections() == 1);
+
+    results[1].api->send("system"_cmd / "identity" / "print");
+    auto rep = results[1].api->read();
+    CHECK(rep.reply_type == reply::re);
+    CHECK_THAT(rep.attributes, Catch::Equals(std::vector<std::string>{"=name=second"}));
+    CHECK(results[1].api->read().reply_type == reply::done);
+}
+
+TEST_CASE("bootstrap reports failures per device",
+          "[bootstrap][e2e][api]") {
+    mock::server srv;
+    std::vector<endpoint> devices{{srv.address(), "admin", "", closed_port()},
+                                  {srv.address(), "nobody", "", srv.port()},
+                                  {srv.address(), "admin", "", srv.port()}};
+
+    std::vector<int> reported(devices.size());
+    std::vector<bootstrap_result> results(devices.size());
+    bootstrap(devices, [&](std::size_t idx, bootstrap_result&& res) {
+        ++reported[idx];
+        results[idx] = std::move(res);
+    });
+
+    CHECK_THAT(reported, Catch::Equals(std::vector<int>{1, 1, 1}));
+    CHECK_FALSE(results[0].api);
+    CHECK_THROWS_AS(std::rethrow_exception(results[0].error), bad_socket);
+    CHECK_FALSE(results[1].api);
+    CHECK_THROWS_AS(std::rethrow_exception(results[1].error), bad_socket);
+    CHECK(results[2].api);
+}
+
+TEST_CASE("bootstrap times out logging into slow devices",
+          "[bootstrap][e2e][api]") {
+    mock::server srv;
+    srv.latency(1s);
+    bootstrap_options opts;
+    opts.limits.login = 100ms;
+
+    auto results = bootstrap({{srv.address(), "admin", "", srv.port()}}, opts);
+    REQUIRE(results.size() == 1);
+    CHECK_FALSE(results[0].api);
+    CHECK_THROWS_AS(std::rethrow_exception(results[0].error), socket_timeout);
+}
+
+TEST_CASE("bootstrap logs in concurrently with bounded devices in flight",
+          "[bootstrap][e2e][api]") {
+    mock::server srv;
+    srv.latency(100ms);
+    std::vector<endpoint> devices(20, {srv.address(), "admin", "", srv.port()});
+
+    auto start = std::chrono::steady_clock::now();
+    auto results = bootstrap(devices);
+    auto all_at_once = std::chrono::steady_clock::now() - start;
+    for (const auto& res : results) {
+        CHECK(res.api);
+    }
+    // one after the other would take 2 seconds
+    CHECK(all_at_once < 1s);
+
+    bootstrap_options opts;
+    opts.max_in_flight = 5;
+    start = std::chrono::steady_clock::now();
+    results = bootstrap(devices, opts);
+    auto five_at_once = std::chrono::steady_clock::now() - start;
+    for (const auto& res : results) {
+        CHECK(res.api);
+    }
+    CHECK(five_at_once >= 400ms);
+    CHECK(srv.connections() == 40);
+}
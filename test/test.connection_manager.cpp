@@ -0,0 +1,318 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+// stdlib
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#    include <fcntl.h>
+#endif
+
+// test'd
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/connection_manager.hpp>
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/exception/socket_timeout.hpp>
+#include <mikrotik/api/mock/server.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+using namespace std::chrono_literals;
+
+namespace {
+    // automatic is io_uring, if the library was built with it, and the kernel supports it
+    connection_manager::backend
+    any_backend() {
+        return GENERATE(connection_manager::backend::poll, connection_manager::backend::automatic);
+    }
+
+    struct result {
+        std::vector<reply> replies;
+        std::exception_ptr error;
+        bool done = false;
+    };
+
+    connection_manager::completion
+    store(result& res) {
+        return [&res](std::vector<reply>&& replies, std::exception_ptr error) {
+            res.replies = std::move(replies);
+            res.error = error;
+            res.done = true;
+        };
+    }
+
+    std::string
+    message(const std::exception_ptr& error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const std::exception& ex) {
+            return ex.what();
+        }
+    }
+
+    std::string
+    timed_out_operation(const std::exception_ptr& error) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const socket_timeout& ex) {
+            return ex.operation();
+        } catch (...) {
+            return "";
+        }
+    }
+}
+
+TEST_CASE("connection_manager executes commands on many connections",
+          "[connection_manager][e2e][api]") {
+    auto io = any_backend();
+    mock::server srv;
+    srv.table("/system/identity", {{{"name", "MikroTik"}}});
+
+    connection_manager mgr(3, io);
+    std::vector<result> results(64);
+    for (auto& res : results) {
+        auto conn = mgr.add(srv.address(), "admin", "", srv.port());
+        mgr.execute(conn, "system"_cmd / "identity" / "print", store(res));
+    }
+    mgr.run();
+
+    for (const auto& res : results) {
+        REQUIRE(res.done);
+        CHECK_FALSE(res.error);
+        REQUIRE(res.replies.size() == 2);
+        CHECK(res.replies[0].reply_type == reply::re);
+        CHECK(res.replies[1].reply_type == reply::done);
+    }
+    CHECK(srv.connections() == 64);
+}
+
+TEST_CASE("connection_manager keeps connections between runs",
+          "[connection_manager][e2e][api]") {
+    auto io = any_backend();
+    mock::server srv;
+    srv.table("/system/identity", {{{"name", "MikroTik"}}});
+
+    connection_manager mgr(1, io);
+    auto conn = mgr.add(srv.address(), "admin", "", srv.port());
+    result first;
+    result second;
+    mgr.execute(conn, "system"_cmd / "identity" / "print", store(first));
+    mgr.run();
+    mgr.execute(conn, "system"_cmd / "identity" / "print", store(second));
+    mgr.run();
+
+    CHECK(first.done);
+    CHECK(second.done);
+    CHECK_FALSE(second.error);
+    CHECK(srv.connections() == 1);
+}
+
+TEST_CASE("connection_manager fails connections with a bad login",
+          "[connection_manager][e2e][api]") {
+    auto io = any_backend();
+    mock::server srv;
+    srv.table("/system/identity", {{{"name", "MikroTik"}}});
+
+    connection_manager mgr(1, io);
+    auto bad = mgr.add(srv.address(), "admin", "wrong", srv.port());
+    auto good = mgr.add(srv.address(), "admin", "", srv.port());
+    result bad_res;
+    result good_res;
+    mgr.execute(bad, "system"_cmd / "identity" / "print", store(bad_res));
+    mgr.execute(good, "system"_cmd / "identity" / "print", store(good_res));
+    mgr.run();
+
+    REQUIRE(bad_res.done);
+    REQUIRE(bad_res.error);
+    CHECK_THROWS_AS(std::rethrow_exception(bad_res.error), bad_socket);
+    CHECK_THAT(message(bad_res.error), Catch::Contains("could not log into device"));
+    CHECK(mgr.failed(bad));
+
+    CHECK_FALSE(good_res.error);
+    CHECK_FALSE(mgr.failed(good));
+}
+
+TEST_CASE("connection_manager fails connections closed by the device",
+          "[connection_manager][e2e][api]") {
+    auto io = any_backend();
+    mock::server srv;
+
+    connection_manager mgr(1, io);
+    auto conn = mgr.add(srv.address(), "admin", "", srv.port());
+    result quit;
+    mgr.execute(conn, "quit"_cmd, store(quit));
+    mgr.run();
+
+    REQUIRE(quit.done);
+    REQUIRE(quit.error);
+    REQUIRE(quit.replies.size() == 1);
+    CHECK(quit.replies[0].reply_type == reply::fatal);
+    CHECK(mgr.failed(conn));
+
+    // later commands fail without being sent
+    result later;
+    mgr.execute(conn, "system"_cmd / "identity" / "print", store(later));
+    mgr.run();
+    REQUIRE(later.done);
+    CHECK(later.error);
+    CHECK(srv.requests() == 2);
+}
+
+TEST_CASE("connection_manager times out a device not answering",
+          "[connection_manager][socket_timeout][e2e][api]") {
+    auto io = any_backend();
+    mock::server srv;
+    srv.table("/system/identity", {{{"name", "MikroTik"}}});
+    // answered only when the test finishes, releasing the thread of the server
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    srv.on("/stall", [released](const mock::request&) {
+        released.wait_for(10s);
+        return std::vector<reply>{{reply::done, {}}};
+    });
+
+    timeouts limits;
+    limits.operation = 100ms;
+    connection_manager mgr(1, io);
+    auto stalled = mgr.add(srv.address(), "admin", "", srv.port(), limits);
+    auto healthy = mgr.add(srv.address(), "admin", "", srv.port(), limits);
+    result stalled_res;
+    result after_res;
+    result healthy_res;
+    mgr.execute(stalled, "stall"_cmd, store(stalled_res));
+    mgr.execute(stalled, "system"_cmd / "identity" / "print", store(after_res));
+    mgr.execute(healthy, "system"_cmd / "identity" / "print", store(healthy_res));
+
+    auto start = std::chrono::steady_clock::now();
+    mgr.run();
+    CHECK(std::chrono::steady_clock::now() - start < 5s);
+
+    REQUIRE(stalled_res.done);
+    CHECK_THROWS_AS(std::rethrow_exception(stalled_res.error), socket_timeout);
+    CHECK(timed_out_operation(stalled_res.error) == "reading a reply");
+    REQUIRE(after_res.done);
+    CHECK(timed_out_operation(after_res.error) == "reading a reply");
+    CHECK(mgr.failed(stalled));
+
+    CHECK_FALSE(healthy_res.error);
+    CHECK_FALSE(mgr.failed(healthy));
+    release.set_value();
+}
+
+#ifndef _WIN32
+namespace {
+    // a listener which never accepts: connections complete in its queue,
+    // but their login is never answered. once the queue is full, the
+    // handshake of the next connection is not answered either
+    struct silent_listener {
+        silent_listener() {
+            fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+            ::listen(fd, 0);
+            socklen_t len = sizeof(addr);
+            ::getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &len);
+            port = ntohs(addr.sin_port);
+        }
+
+        ~silent_listener() {
+            if (filler >= 0)
+                ::close(filler);
+            ::close(fd);
+        }
+
+        bool
+        fill() {
+            filler = ::socket(AF_INET, SOCK_STREAM, 0);
+            ::fcntl(filler, F_SETFL, O_NONBLOCK);
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            addr.sin_port = htons(port);
+            ::connect(filler, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+
+            pollfd pfd{filler, POLLOUT, 0};
+            return ::poll(&pfd, 1, 1000) == 1;
+        }
+
+        int fd = -1;
+        int filler = -1;
+        std::uint16_t port = 0;
+    };
+}
+
+TEST_CASE("connection_manager times out logging in",
+          "[connection_manager][socket_timeout][e2e][api]") {
+    auto io = any_backend();
+    silent_listener device;
+
+    timeouts limits;
+    limits.login = 100ms;
+    connection_manager mgr(1, io);
+    auto conn = mgr.add("127.0.0.1", "admin", "", device.port, limits);
+    result res;
+    mgr.execute(conn, "system"_cmd / "identity" / "print", store(res));
+    mgr.run();
+
+    REQUIRE(res.done);
+    CHECK_THROWS_AS(std::rethrow_exception(res.error), socket_timeout);
+    CHECK(timed_out_operation(res.error) == "logging in");
+    CHECK(mgr.failed(conn));
+}
+
+TEST_CASE("connection_manager times out connecting",
+          "[connection_manager][socket_timeout][e2e][api]") {
+    auto io = any_backend();
+    silent_listener device;
+    REQUIRE(device.fill());
+
+    timeouts limits;
+    limits.connect = 100ms;
+    connection_manager mgr(1, io);
+    auto conn = mgr.add("127.0.0.1", "admin", "", device.port, limits);
+    result res;
+    mgr.execute(conn, "system"_cmd / "identity" / "print", store(res));
+    mgr.run();
+
+    REQUIRE(res.done);
+    CHECK(timed_out_operation(res.error).rfind("connecting to 127.0.0.1:", 0) == 0);
+    CHECK(mgr.failed(conn));
+}
+#endif
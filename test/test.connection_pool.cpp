@@ -0,0 +1,257 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+// stdlib
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// test'd
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/connection_pool.hpp>
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/mock/server.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+using namespace std::chrono_literals;
+
+TEST_CASE("connection_pool reuses returned connections",
+          "[connection_pool][e2e][api]") {
+    mock::server srv;
+    srv.table("/system/identity", {{{"name", "MikroTik"}}});
+    connection_pool pool;
+
+    {
+        auto api = pool.acquire(srv.address(), "admin", "", srv.port());
+        CHECK(pool.leased() == 1);
+        api->send("system"_cmd / "identity" / "print");
+        CHECK(api->read().reply_type == reply::re);
+        CHECK(api->read().reply_type == reply::done);
+    }
+    CHECK(pool.leased() == 0);
+    CHECK(pool.idle() == 1);
+
+    {
+        auto api = pool.acquire(srv.address(), "admin", "", srv.port());
+        api->send("system"_cmd / "identity" / "print");
+        CHECK(api->read().reply_type == reply::re);
+        CHECK(api->read().reply_type == reply::done);
+    }
+    CHECK(srv.connections() == 1);
+}
+
+TEST_CASE("connection_pool closes connections dropped before all replies were read",
+          "[connection_pool][e2e][api]") {
+    mock::server srv;
+    srv.generate("/interface", 100, [](std::size_t idx) {
+        return mock::row{{"name", "ether" + std::to_string(idx)}};
+    });
+    srv.table("/system/identity", {{{"name", "MikroTik"}}});
+    pool_options opts;
+    opts.validate_after = 0ms;
+    connection_pool pool(opts);
+
+    {
+        auto api = pool.acquire(srv.address(), "admin", "", srv.port());
+        api->send("interface"_cmd / "print");
+        CHECK(api->read().reply_type == reply::re);
+    }
+    CHECK(pool.leased() == 0);
+    CHECK(pool.idle() == 0);
+
+    auto api = pool.acquire(srv.address(), "admin", "", srv.port());
+    api->send("system"_cmd / "identity" / "print");
+    auto rep = api->read();
+    REQUIRE(rep.reply_type == reply::re);
+    CHECK(rep.attributes == std::vector<std::string>{"=name=MikroTik"});
+    CHECK(api->read().reply_type == reply::done);
+    CHECK(srv.connections() == 2);
+}
+
+TEST_CASE("connection_pool creates connections for concurrent leases",
+          "[connection_pool][e2e][api]") {
+    mock::server srv;
+    srv.add_user("reader", "secret");
+    connection_pool pool;
+
+    {
+        auto first = pool.acquire(srv.address(), "admin", "", srv.port());
+        auto second = pool.acquire(srv.address(), "admin", "", srv.port());
+        auto other_user = pool.acquire(srv.address(), "reader", "secret", srv.port());
+        CHECK(&*first != &*second);
+        CHECK(pool.leased() == 3);
+    }
+    CHECK(pool.idle() == 3);
+    CHECK(srv.connections() == 3);
+}
+
+TEST_CASE("connection_pool closes discarded and failed connections",
+          "[connection_pool][e2e][api]") {
+    mock::server srv;
+    connection_pool pool;
+
+    auto api = pool.acquire(srv.address(), "admin", "", srv.port());
+    api.discard();
+    CHECK(pool.leased() == 0);
+    CHECK(pool.idle() == 0);
+
+    try {
+        auto failing = pool.acquire(srv.address(), "admin", "", srv.port());
+        throw std::runtime_error("connection broke");
+    } catch (const std::runtime_error&) {
+    }
+    CHECK(pool.leased() == 0);
+    CHECK(pool.idle() == 0);
+
+    pool.acquire(srv.address(), "admin", "", srv.port());
+    CHECK(pool.idle() == 1);
+    CHECK(srv.connections() == 3);
+}
+
+TEST_CASE("connection_pool replaces broken idle connections",
+          "[connection_pool][e2e][api]") {
+    mock::server srv;
+    pool_options opts;
+    opts.validate_after = 0ms;
+    connection_pool pool(opts);
+
+    {
+        auto api = pool.acquire(srv.address(), "admin", "", srv.port());
+        api->send(sentence("quit"_cmd));
+        CHECK(api->read().reply_type == reply::fatal);
+    }
+    CHECK(pool.idle() == 1);
+
+    auto api = pool.acquire(srv.address(), "admin", "", srv.port());
+    CHECK(srv.connections() == 2);
+    api->send("nothing"_cmd / "here");
+    CHECK(api->read().reply_type == reply::trap);
+    CHECK(api->read().reply_type == reply::done);
+}
+
+TEST_CASE("connection_pool keeps warm spares of used devices",
+          "[connection_pool][e2e][api]") {
+    mock::server srv;
+    pool_options opts;
+    opts.warm_spares = 3;
+    connection_pool pool(opts);
+
+    pool.maintain();
+    CHECK(pool.idle() == 0);
+
+    pool.acquire(srv.address(), "admin", "", srv.port());
+    pool.maintain();
+    CHECK(pool.idle() == 3);
+    CHECK(srv.connections() == 3);
+
+    {
+        auto first = pool.acquire(srv.address(), "admin", "", srv.port());
+        auto second = pool.acquire(srv.address(), "admin", "", srv.port());
+        pool.maintain();
+        CHECK(pool.idle() == 3);
+    }
+    CHECK(pool.idle() == 5);
+    CHECK(srv.connections() == 5);
+}
+
+TEST_CASE("connection_pool forgets devices not leased from anymore",
+          "[connection_pool][e2e][api]") {
+    mock::server srv;
+    pool_options opts;
+    opts.idle_timeout = 0ms;
+    connection_pool pool(opts);
+
+    {
+        // leased connections are kept when their device times out
+        auto api = pool.acquire(srv.address(), "admin", "", srv.port());
+        std::this_thread::sleep_for(1ms);
+        pool.maintain();
+        CHECK(pool.leased() == 1);
+    }
+    CHECK(pool.leased() == 0);
+    CHECK(pool.idle() == 1);
+
+    std::this_thread::sleep_for(1ms);
+    pool.maintain();
+    CHECK(pool.idle() == 0);
+
+    auto api = pool.acquire(srv.address(), "admin", "", srv.port());
+    CHECK(srv.connections() == 2);
+    api->send("nothing"_cmd / "here");
+    CHECK(api->read().reply_type == reply::trap);
+    CHECK(api->read().reply_type == reply::done);
+    CHECK(pool.leased() == 1);
+}
+
+TEST_CASE("connection_pool waits for returned connections at the limit",
+          "[connection_pool][e2e][api]") {
+    mock::server srv;
+    pool_options opts;
+    opts.max_per_device = 1;
+    connection_pool pool(opts);
+
+    auto first = pool.acquire(srv.address(), "admin", "", srv.port());
+    auto conn = &*first;
+    auto second = std::async(std::launch::async, [&] {
+        return pool.acquire(srv.address(), "admin", "", srv.port());
+    });
+    CHECK(second.wait_for(100ms) == std::future_status::timeout);
+
+    {
+        auto returned = std::move(first);
+    }
+    auto lease = second.get();
+    CHECK(&*lease == conn);
+    CHECK(srv.connections() == 1);
+}
+
+TEST_CASE("connection_pool maintains itself in the background",
+          "[connection_pool][e2e][api]") {
+    mock::server srv;
+    pool_options opts;
+    opts.warm_spares = 2;
+    opts.maintenance_interval = 10ms;
+    connection_pool pool(opts);
+
+    pool.acquire(srv.address(), "admin", "", srv.port());
+    auto until = std::chrono::steady_clock::now() + 2s;
+    while (pool.idle() < 2 && std::chrono::steady_clock::now() < until) {
+        std::this_thread::sleep_for(5ms);
+    }
+    CHECK(pool.idle() == 2);
+}
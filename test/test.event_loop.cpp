@@ -0,0 +1,134 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// test'd
+#include <mikrotik/api/async_generator.hpp>
+#include <mikrotik/api/event_loop.hpp>
+#include <mikrotik/api/task.hpp>
+using namespace mikrotik::api;
+
+namespace {
+    task<int>
+    answer() {
+        co_return 42;
+    }
+
+    task<int>
+    twice(task<int> t) {
+        co_return 2 * co_await std::move(t);
+    }
+
+    task<int>
+    failing() {
+        throw std::runtime_error("failed");
+        co_return 0;
+    }
+
+    task<int>
+    await_empty() {
+        co_return co_await task<int>{};
+    }
+
+    async_generator<int>
+    count_to(int n) {
+        for (int i = 1; i <= n; ++i) {
+            co_yield i;
+        }
+    }
+
+    task<int>
+    sum(async_generator<int> gen) {
+        int ret = 0;
+        while (auto i = co_await gen.next()) {
+            ret += *i;
+        }
+        co_return ret;
+    }
+
+    task<void>
+    log_steps(event_loop& loop, std::string name, std::vector<std::string>& log) {
+        for (int i = 0; i < 2; ++i) {
+            log.push_back(name + std::to_string(i));
+            co_await loop.yield();
+        }
+    }
+}
+
+TEST_CASE("event_loop runs task to get its result",
+          "[event_loop][coroutine][api]") {
+    event_loop loop;
+
+    CHECK(loop.run(answer()) == 42);
+    CHECK(loop.run(twice(answer())) == 84);
+}
+
+TEST_CASE("event_loop rethrows exception escaping task",
+          "[event_loop][coroutine][api]") {
+    event_loop loop;
+
+    CHECK_THROWS_AS(loop.run(failing()), std::runtime_error);
+    CHECK_THROWS_AS(loop.run(twice(failing())), std::runtime_error);
+}
+
+TEST_CASE("awaiting an empty task throws",
+          "[task][coroutine][api]") {
+    event_loop loop;
+
+    CHECK_THROWS_AS(loop.run(await_empty()), std::logic_error);
+}
+
+TEST_CASE("async_generator produces all yielded values",
+          "[async_generator][coroutine][api]") {
+    event_loop loop;
+
+    CHECK(loop.run(sum(count_to(4))) == 10);
+    CHECK(loop.run(sum(count_to(0))) == 0);
+}
+
+TEST_CASE("event_loop interleaves yielding tasks",
+          "[event_loop][coroutine][api]") {
+    event_loop loop;
+    std::vector<std::string> log;
+
+    loop.spawn(log_steps(loop, "a", log));
+    loop.spawn(log_steps(loop, "b", log));
+    loop.run();
+
+    CHECK(log == std::vector<std::string>{"a0", "b0", "a1", "b1"});
+}
@@ -0,0 +1,148 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+// stdlib
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// test'd
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/hedged_handler.hpp>
+#include <mikrotik/api/mock/server.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+using namespace std::chrono_literals;
+
+namespace {
+    // answers the first request late, like a device under load, and the rest at once
+    void
+    slow_first(mock::server& srv, const std::string& command, std::shared_ptr<std::atomic<int>> calls) {
+        srv.on(command, [calls](const mock::request&) {
+            if (calls->fetch_add(1) == 0)
+                std::this_thread::sleep_for(500ms);
+            return std::vector<reply>{{reply::re, {"=name=MikroTik"}},
+                                      {reply::done, {}}};
+        });
+    }
+}
+
+TEST_CASE("hedged_handler executes sentences without duplicating quick ones",
+          "[hedged_handler][e2e][api]") {
+    mock::server srv;
+    srv.table("/system/identity", {{{"name", "MikroTik"}}});
+    hedged_handler api(srv.address(), "admin", "", srv.port());
+    CHECK(srv.connections() == 2);
+
+    for (int i = 0; i < 30; ++i) {
+        auto replies = api.execute(sentence("system"_cmd / "identity" / "print"));
+        REQUIRE(replies.size() == 2);
+        CHECK(replies[0].reply_type == reply::re);
+        CHECK(replies[1].reply_type == reply::done);
+    }
+    CHECK(api.hedges() == 0);
+    CHECK(api.hedge_delay(sentence("system"_cmd / "identity" / "print")) < 100ms);
+}
+
+TEST_CASE("hedged_handler duplicates slow idempotent sentences",
+          "[hedged_handler][e2e][api]") {
+    mock::server srv;
+    auto calls = std::make_shared<std::atomic<int>>(0);
+    slow_first(srv, "/system/identity/print", calls);
+    hedging_options opts;
+    opts.initial_hedge_delay = 20ms;
+    hedged_handler api(srv.address(), "admin", "", srv.port(), opts);
+
+    auto start = std::chrono::steady_clock::now();
+    auto replies = api.execute(sentence("system"_cmd / "identity" / "print"));
+    CHECK(std::chrono::steady_clock::now() - start < 400ms);
+    REQUIRE(replies.size() == 2);
+    CHECK(replies[0].reply_type == reply::re);
+    CHECK(api.hedges() == 1);
+    CHECK(*calls == 2);
+}
+
+TEST_CASE("hedged_handler sends mutating sentences once",
+          "[hedged_handler][e2e][api]") {
+    mock::server srv;
+    auto calls = std::make_shared<std::atomic<int>>(0);
+    slow_first(srv, "/system/identity/set", calls);
+    hedging_options opts;
+    opts.initial_hedge_delay = 1ms;
+    hedged_handler api(srv.address(), "admin", "", srv.port(), opts);
+
+    auto replies = api.execute(("system"_cmd / "identity" / "set")[{"name", "other"}]);
+    CHECK(replies.back().reply_type == reply::done);
+    CHECK(api.hedges() == 0);
+    CHECK(*calls == 1);
+}
+
+TEST_CASE("hedged_handler retries idempotent sentences within their budget",
+          "[hedged_handler][e2e][api]") {
+    auto srv = std::make_unique<mock::server>();
+    const auto address = srv->address();
+    hedging_options opts;
+    opts.retry.initial = 1ms;
+    opts.attempts["/system/identity/print"] = 3;
+    hedged_handler api(address, "admin", "", srv->port(), opts);
+    srv.reset();
+
+    CHECK_THROWS_AS(api.execute(sentence("system"_cmd / "identity" / "print")), bad_socket);
+    CHECK(api.retries() == 2);
+    CHECK_THROWS_AS(api.execute(sentence("interface"_cmd / "print")), bad_socket);
+    CHECK(api.retries() == 3);
+    CHECK_THROWS_AS(api.execute(sentence("system"_cmd / "reboot")), bad_socket);
+    CHECK(api.retries() == 3);
+}
+
+TEST_CASE("hedged_handler reconnects after the device restarts",
+          "[hedged_handler][e2e][api]") {
+    auto srv = std::make_unique<mock::server>();
+    const auto port = srv->port();
+    hedged_handler api(srv->address(), "admin", "", port);
+
+    srv.reset();
+    srv = std::make_unique<mock::server>(port);
+    srv->table("/system/identity", {{{"name", "rebooted"}}});
+
+    auto replies = api.execute(sentence("system"_cmd / "identity" / "print"));
+    REQUIRE(replies.size() == 2);
+    CHECK(replies[0].reply_type == reply::re);
+    CHECK(api.retries() <= 1);
+}
@@ -0,0 +1,64 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+// test'd
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/idempotence.hpp>
+#include <mikrotik/api/sentence.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+
+TEST_CASE("reading sentences are idempotent",
+          "[idempotence][api]") {
+    CHECK(is_idempotent(sentence("interface"_cmd / "print")));
+    CHECK(is_idempotent(("ip"_cmd / "address" / "print")[{"count-only", ""}]));
+    CHECK(is_idempotent(("system"_cmd / "script" / "get")[{"value-name", "source"}]));
+    CHECK(is_idempotent(sentence("interface"_cmd / "getall")));
+    CHECK(is_idempotent(("interface"_cmd / "monitor-traffic")[{"interface", "ether1"}]
+                                                             [{"once", ""}]));
+    CHECK(is_idempotent(("interface"_cmd / "ethernet" / "monitor")[{"once", "yes"}]));
+}
+
+TEST_CASE("mutating and endless sentences are not idempotent",
+          "[idempotence][api]") {
+    CHECK_FALSE(is_idempotent(("interface"_cmd / "set")[{".id", "*1"}]
+                                                       [{"disabled", "yes"}]));
+    CHECK_FALSE(is_idempotent(sentence("ip"_cmd / "address" / "add")));
+    CHECK_FALSE(is_idempotent(sentence("system"_cmd / "reboot")));
+    CHECK_FALSE(is_idempotent(("interface"_cmd / "monitor-traffic")[{"interface", "ether1"}]));
+    CHECK_FALSE(is_idempotent(("log"_cmd / "print")[{"follow", ""}]));
+    CHECK_FALSE(is_idempotent(("log"_cmd / "print")[{"follow-only", ""}]));
+    CHECK_FALSE(is_idempotent(("interface"_cmd / "print")[{"interval", "1"}]));
+}
@@ -140,3 +140,23 @@ TEST_CASE("ip_address' render appends non-zero port",
 
     CHECK(ip.render(8080) == "1.2.3.4:8080");
 }
+
+TEST_CASE("ip_address to_chars writes the dotted address",
+          "[ip_address][util][api]") {
+    ip_address ip{"192.168.88.1"};
+    char buf[15];
+
+    auto [end, ec] = ip.to_chars(buf, buf + sizeof(buf));
+    CHECK(ec == std::errc());
+    CHECK(std::string_view(buf, static_cast<std::size_t>(end - buf)) == "192.168.88.1"sv);
+    CHECK(ip.render() == "192.168.88.1");
+    CHECK(ip.render(8728) == "192.168.88.1:8728");
+}
+
+TEST_CASE("ip_address to_chars fails if the buffer is too small",
+          "[ip_address][util][api]") {
+    ip_address ip{"255.255.255.255"};
+    char buf[14];
+
+    CHECK(ip.to_chars(buf, buf + sizeof(buf)).ec == std::errc::value_too_large);
+}
@@ -0,0 +1,202 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+using namespace std::literals;
+
+// test'd
+#include <mikrotik/api/impl/length_codec.hpp>
+using namespace mikrotik::api::impl;
+
+namespace {
+    // the length prefix implementation of v1.1, which only knows 1-4 byte prefixes
+    std::size_t
+    reference_encode(std::size_t len, char* out) {
+        if (len < 0x80) {
+            out[0] = static_cast<char>(len);
+            return 1;
+        }
+        if (len < 0x4000) {
+            out[0] = static_cast<char>((len >> 8) | 0x80);
+            out[1] = static_cast<char>(len);
+            return 2;
+        }
+        if (len < 0x200000) {
+            out[0] = static_cast<char>((len >> 16) | 0xC0);
+            out[1] = static_cast<char>(len >> 8);
+            out[2] = static_cast<char>(len);
+            return 3;
+        }
+        out[0] = static_cast<char>((len >> 24) | 0xE0);
+        out[1] = static_cast<char>(len >> 16);
+        out[2] = static_cast<char>(len >> 8);
+        out[3] = static_cast<char>(len);
+        return 4;
+    }
+
+    std::size_t
+    reference_decode(std::string_view data, std::size_t& len) {
+        auto byte = static_cast<unsigned char>(data[0]);
+        std::size_t size = (byte & 0xE0) == 0xE0   ? 4
+                           : (byte & 0xC0) == 0xC0 ? 3
+                           : (byte & 0x80) == 0x80 ? 2
+                                                   : 1;
+        if (data.size() < size)
+            return 0;
+        len = byte & (0xFFu >> size);
+        for (std::size_t i = 1; i < size; ++i) {
+            len = (len << 8) | static_cast<unsigned char>(data[i]);
+        }
+        return size;
+    }
+
+    bool
+    matches_reference(std::size_t len) {
+        char exp[max_length_size];
+        char got[max_length_size];
+        auto exp_size = reference_encode(len, exp);
+        auto got_size = encode_length(len, got);
+        if (exp_size != got_size || std::string_view(exp, exp_size) != std::string_view(got, got_size))
+            return false;
+
+        std::size_t decoded = 0;
+        return decode_length({got, got_size}, decoded) == got_size && decoded == len;
+    }
+
+    bool
+    round_trips(std::size_t len) {
+        char buf[max_length_size];
+        auto size = encode_length(len, buf);
+        std::size_t decoded = 0;
+        return size == length_size(len)
+               && decode_length({buf, size}, decoded) == size
+               && decoded == len;
+    }
+}
+
+TEST_CASE("encode_length matches the old implementation for every 1-3 byte length",
+          "[length_codec][util][impl]") {
+    std::size_t mismatches = 0;
+    for (std::size_t len = 0; len < 0x20'0000; ++len) {
+        mismatches += !matches_reference(len);
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("encode_length matches the old implementation for 4 byte lengths",
+          "[length_codec][util][impl]") {
+    std::size_t mismatches = 0;
+    for (std::size_t len = 0x20'0000; len < 0x1000'0000; len += 251) {
+        mismatches += !matches_reference(len);
+    }
+    for (std::size_t len : {0x20'0000u, 0x20'0001u, 0xFFF'FFFEu, 0xFFF'FFFFu}) {
+        mismatches += !matches_reference(len);
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("encode_length uses the 5 byte form above 4 byte lengths",
+          "[length_codec][util][impl]") {
+    char buf[max_length_size];
+
+    CHECK(encode_length(0x1000'0000, buf) == 5);
+    CHECK(std::string_view(buf, 5) == "\xF0\x10\x00\x00\x00"sv);
+    CHECK(encode_length(0xFFFF'FFFF, buf) == 5);
+    CHECK(std::string_view(buf, 5) == "\xF0\xFF\xFF\xFF\xFF"sv);
+
+    std::size_t failures = 0;
+    for (std::size_t len = 0x1000'0000; len <= max_word_length; len += 65'521) {
+        failures += !round_trips(len);
+    }
+    CHECK(failures == 0);
+}
+
+TEST_CASE("encode_length rejects lengths longer than the protocol allows",
+          "[length_codec][util][impl]") {
+    char buf[max_length_size] = {};
+
+    CHECK(length_size(max_word_length + 1) == 0);
+    CHECK(encode_length(max_word_length + 1, buf) == 0);
+    CHECK(buf[0] == 0);
+}
+
+TEST_CASE("decode_length matches the old implementation for every 1-2 byte input",
+          "[length_codec][util][impl]") {
+    std::size_t mismatches = 0;
+    for (unsigned first = 0; first < 0xF0; ++first) {
+        for (unsigned second = 0; second < 0x100; ++second) {
+            char data[] = {static_cast<char>(first), static_cast<char>(second)};
+            std::size_t exp = 0;
+            std::size_t got = 0;
+            auto exp_size = reference_decode({data, 2}, exp);
+            auto got_size = decode_length({data, 2}, got);
+            mismatches += exp_size != got_size || (exp_size != 0 && exp != got);
+        }
+    }
+    CHECK(mismatches == 0);
+}
+
+TEST_CASE("decode_length reports incomplete length prefixes",
+          "[length_codec][util][impl]") {
+    std::size_t len = 0;
+
+    CHECK(decode_length("", len) == 0);
+    CHECK(decode_length("\xC0\x40"sv, len) == 0);
+    CHECK(decode_length("\xF0\x10\x00\x00"sv, len) == 0);
+}
+
+TEST_CASE("decode_length rejects reserved control bytes",
+          "[length_codec][util][impl]") {
+    for (unsigned first = 0xF8; first < 0x100; ++first) {
+        char data[] = {static_cast<char>(first), 0, 0, 0, 0};
+        std::size_t len = 0;
+
+        CHECK(decoded_size(data[0]) == 0);
+        CHECK(decode_length({data, 5}, len) == bad_length);
+    }
+}
+
+TEST_CASE("length codec works at compile time",
+          "[length_codec][util][impl]") {
+    constexpr auto size = [] {
+        char buf[max_length_size] = {};
+        std::size_t len = 0;
+        return decode_length({buf, encode_length(0x4000, buf)}, len) * 0x10000 + len;
+    }();
+
+    STATIC_REQUIRE(size == 3 * 0x10000 + 0x4000);
+}
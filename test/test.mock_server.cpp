@@ -0,0 +1,259 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+// stdlib
+#include <chrono>
+#include <string>
+
+// test'd
+#include <mikrotik/api/api_handler.hpp>
+#include <mikrotik/api/attribute_map.hpp>
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/mock/server.hpp>
+#include <mikrotik/api/pipeline.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+
+namespace {
+    mock::row
+    interface(std::size_t idx) {
+        return {{".id", "*" + std::to_string(idx)},
+                {"name", "ether" + std::to_string(idx)},
+                {"running", idx % 2 == 0 ? "true" : "false"}};
+    }
+}
+
+TEST_CASE("mock server logs in known users only",
+          "[mock_server][e2e][api]") {
+    mock::server srv;
+    srv.add_user("reader", "secret");
+
+    CHECK_NOTHROW(api_handler(srv.address(), "admin", "", srv.port()));
+    CHECK_NOTHROW(api_handler(srv.address(), "reader", "secret", srv.port()));
+    CHECK_THROWS_AS(api_handler(srv.address(), "reader", "wrong", srv.port()), bad_socket);
+    CHECK_THROWS_AS(api_handler(srv.address(), "nobody", "", srv.port()), bad_socket);
+    CHECK(srv.connections() == 4);
+}
+
+TEST_CASE("mock server serves tables",
+          "[mock_server][e2e][api]") {
+    mock::server srv;
+    srv.table("/interface", {interface(0), interface(1), interface(2)});
+    api_handler api(srv.address(), "admin", "", srv.port());
+
+    api.send("interface"_cmd / "print");
+    for (std::size_t i = 0; i < 3; ++i) {
+        auto rep = api.read();
+        REQUIRE(rep.reply_type == reply::re);
+        CHECK_THAT(rep.attributes,
+                   Catch::Equals(std::vector<std::string>{"=.id=*" + std::to_string(i),
+                                                          "=name=ether" + std::to_string(i),
+                                                          std::string("=running=") + (i % 2 == 0 ? "true" : "false")}));
+    }
+    CHECK(api.read().reply_type == reply::done);
+}
+
+TEST_CASE("mock server filters rows by queries and proplist",
+          "[mock_server][e2e][api]") {
+    mock::server srv;
+    srv.generate("/interface", 10, interface);
+    api_handler api(srv.address(), "admin", "", srv.port());
+
+    auto cmd = ("interface"_cmd / "print")[{".proplist", "name"}]
+                                          ({"running", "true"})
+                                          (query("-comment"));
+    std::vector<std::string> names;
+    for (const auto& row : api.stream(cmd)) {
+        REQUIRE(row.attributes.size() == 1);
+        names.emplace_back(row.attributes[0]);
+    }
+    CHECK_THAT(names,
+               Catch::Equals(std::vector<std::string>{"=name=ether0", "=name=ether2", "=name=ether4",
+                                                      "=name=ether6", "=name=ether8"}));
+
+    api.send(("interface"_cmd / "print")[{"count-only", ""}]);
+    auto rep = api.read();
+    CHECK(rep.reply_type == reply::done);
+    CHECK(attribute_map(rep).get("ret") == "10");
+}
+
+TEST_CASE("mock server streams big generated tables",
+          "[mock_server][e2e][api]") {
+    mock::server srv;
+    srv.generate("/ip/route", 100'000, [](std::size_t idx) {
+        return mock::row{{"dst-address", std::to_string(idx)}};
+    });
+    api_handler api(srv.address(), "admin", "", srv.port());
+
+    std::size_t rows = 0;
+    std::size_t wrong = 0;
+    for (const auto& row : api.stream("ip"_cmd / "route" / "print")) {
+        if (row.attributes[0] != "=dst-address=" + std::to_string(rows))
+            ++wrong;
+        ++rows;
+    }
+    CHECK(rows == 100'000);
+    CHECK(wrong == 0);
+}
+
+TEST_CASE("mock server follows prints until cancelled",
+          "[mock_server][e2e][api]") {
+    mock::server srv;
+    srv.table("/interface", {interface(0), interface(1)});
+    api_handler api(srv.address(), "admin", "", srv.port());
+    pipeline pipe(api);
+
+    auto print = pipe.submit(("interface"_cmd / "print")[{"follow", ""}]);
+    CHECK(pipe.read(print).reply_type == reply::re);
+    CHECK(pipe.read(print).reply_type == reply::re);
+    auto cancel = pipe.submit(("cancel"_cmd)[{"tag", std::to_string(print)}]);
+
+    auto rest = pipe.collect(print);
+    REQUIRE(rest.size() == 2);
+    CHECK(rest[0].reply_type == reply::trap);
+    CHECK(attribute_map(rest[0]).get("message") == "interrupted");
+    CHECK(rest[1].reply_type == reply::done);
+    auto cancelled = pipe.collect(cancel);
+    REQUIRE(cancelled.size() == 1);
+    CHECK(cancelled[0].reply_type == reply::done);
+}
+
+TEST_CASE("mock server answers scripted commands with the request tag",
+          "[mock_server][e2e][api]") {
+    mock::server srv;
+    srv.on("/system/identity/print", [](const mock::request& req) {
+        CHECK(req.attribute("detail") == "yes");
+        return std::vector<reply>{{reply::re, {"=name=MikroTik"}},
+                                  {reply::done, {}}};
+    });
+    api_handler api(srv.address(), "admin", "", srv.port());
+    pipeline pipe(api);
+
+    auto tag = pipe.submit(("system"_cmd / "identity" / "print")[{"detail", "yes"}]);
+    auto reps = pipe.collect(tag);
+    REQUIRE(reps.size() == 2);
+    CHECK(reps[0].reply_type == reply::re);
+    CHECK(attribute_map(reps[0]).get("name") == "MikroTik");
+    CHECK(reps[1].reply_type == reply::done);
+}
+
+TEST_CASE("mock server traps unknown commands, and commands before login",
+          "[mock_server][e2e][api]") {
+    mock::server srv;
+    api_handler api(srv.address(), "admin", "", srv.port());
+
+    api.send("no"_cmd / "such" / "thing");
+    auto rep = api.read();
+    CHECK(rep.reply_type == reply::trap);
+    CHECK(attribute_map(rep).get("message") == "no such command prefix");
+    CHECK(api.read().reply_type == reply::done);
+
+    api.send("quit"_cmd);
+    CHECK(api.read().reply_type == reply::fatal);
+    CHECK_THROWS_AS(api.read(), bad_socket);
+}
+
+TEST_CASE("mock server delays replies by the latency",
+          "[mock_server][e2e][api]") {
+    using namespace std::chrono;
+    mock::server srv;
+    srv.table("/interface", {interface(0)});
+    api_handler api(srv.address(), "admin", "", srv.port());
+    srv.latency(milliseconds(50));
+
+    auto start = steady_clock::now();
+    for (int i = 0; i < 4; ++i) {
+        api.send("interface"_cmd / "print");
+        while (api.read().reply_type != reply::done) { }
+    }
+    auto sequential = steady_clock::now() - start;
+    CHECK(sequential >= milliseconds(200));
+
+    // pipelined requests arrive together, so they wait for the latency together
+    pipeline pipe(api);
+    start = steady_clock::now();
+    std::vector<pipeline::tag_type> tags;
+    for (int i = 0; i < 4; ++i) {
+        tags.push_back(pipe.submit("interface"_cmd / "print"));
+    }
+    for (auto tag : tags) {
+        pipe.collect(tag);
+    }
+    auto pipelined = steady_clock::now() - start;
+    CHECK(pipelined >= milliseconds(50));
+    CHECK(pipelined < sequential);
+}
+
+TEST_CASE("mock server limits the bandwidth of replies",
+          "[mock_server][e2e][api]") {
+    using namespace std::chrono;
+    mock::server srv;
+    srv.generate("/log", 1'000, [](std::size_t) {
+        return mock::row{{"message", std::string(90, 'x')}};
+    });
+    srv.bandwidth(1'000'000);
+    api_handler api(srv.address(), "admin", "", srv.port());
+
+    // about 100 KB of replies at 1 MB/s
+    auto start = steady_clock::now();
+    for (const auto& row : api.stream("log"_cmd / "print")) {
+        (void) row;
+    }
+    CHECK(steady_clock::now() - start >= milliseconds(80));
+}
+
+#ifndef _WIN32
+TEST_CASE("mock server serves connected sockets",
+          "[mock_server][e2e][api]") {
+    int fds[2];
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    mock::server srv;
+    srv.serve(fds[1]);
+
+    const char login[] = "\x06/login\x0b=name=admin\x00";
+    REQUIRE(::send(fds[0], login, sizeof(login) - 1, 0) == sizeof(login) - 1);
+
+    std::string got;
+    char buf[64];
+    while (got.size() < 7) {
+        auto n = ::recv(fds[0], buf, sizeof(buf), 0);
+        REQUIRE(n > 0);
+        got.append(buf, static_cast<std::size_t>(n));
+    }
+    CHECK(got == std::string("\x05!done\x00", 7));
+    ::close(fds[0]);
+}
+#endif
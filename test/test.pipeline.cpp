@@ -0,0 +1,169 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+// stdlib
+#include <string>
+#include <vector>
+
+// test'd
+#include <mikrotik/api/api_handler.hpp>
+#include <mikrotik/api/attribute_map.hpp>
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/mock/server.hpp>
+#include <mikrotik/api/pipeline.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+
+namespace {
+    void
+    echo(mock::server& srv) {
+        srv.on("/echo", [](const mock::request& req) {
+            return std::vector<reply>{{reply::re, {"=value=" + std::string(*req.attribute("value"))}},
+                                      {reply::done, {}}};
+        });
+    }
+
+    std::string
+    value(const reply& rep) {
+        return std::string(attribute_map(rep).get("value").value_or(""));
+    }
+}
+
+TEST_CASE("pipeline routes replies to their tags in any order",
+          "[pipeline][e2e][api]") {
+    mock::server srv;
+    echo(srv);
+    api_handler api(srv.address(), "admin", "", srv.port());
+    pipeline pipe(api);
+
+    std::vector<pipeline::tag_type> tags;
+    for (int i = 0; i < 10; ++i) {
+        tags.push_back(pipe.submit(("echo"_cmd)[{"value", std::to_string(i)}]));
+    }
+    CHECK(pipe.in_flight() == 10);
+
+    for (int i = 9; i >= 0; --i) {
+        auto replies = pipe.collect(tags[static_cast<std::size_t>(i)]);
+        REQUIRE(replies.size() == 2);
+        CHECK(value(replies[0]) == std::to_string(i));
+        CHECK(replies[1].reply_type == reply::done);
+    }
+    CHECK(pipe.in_flight() == 0);
+}
+
+TEST_CASE("pipeline separates interleaved replies",
+          "[pipeline][e2e][api]") {
+    mock::server srv;
+    srv.generate("/interface", 20, [](std::size_t i) {
+        return mock::row{{"name", "ether" + std::to_string(i)}};
+    });
+    srv.generate("/ip/route", 20, [](std::size_t i) {
+        return mock::row{{"dst-address", std::to_string(i)}};
+    });
+    api_handler api(srv.address(), "admin", "", srv.port());
+    pipeline pipe(api);
+
+    // the followed print is only done after the cancel, so its replies
+    // surround those of the other print
+    auto followed = pipe.submit(("interface"_cmd / "print")[{"follow", ""}]);
+    auto routes = pipe.submit("ip"_cmd / "route" / "print");
+    auto cancel = pipe.submit(("cancel"_cmd)[{"tag", std::to_string(followed)}]);
+
+    for (std::size_t i = 0; i < 20; ++i) {
+        auto route = pipe.read(routes);
+        auto iface = pipe.read(followed);
+        REQUIRE(route.reply_type == reply::re);
+        REQUIRE(iface.reply_type == reply::re);
+        CHECK(attribute_map(route).get("dst-address") == std::to_string(i));
+        CHECK(attribute_map(iface).get("name") == "ether" + std::to_string(i));
+    }
+    CHECK(pipe.read(routes).reply_type == reply::done);
+    CHECK(pipe.read(followed).reply_type == reply::trap);
+    CHECK(pipe.read(followed).reply_type == reply::done);
+    CHECK(pipe.collect(cancel).back().reply_type == reply::done);
+    CHECK(pipe.in_flight() == 0);
+}
+
+TEST_CASE("pipeline skips untagged replies other than fatal",
+          "[pipeline][e2e][api]") {
+    mock::server srv;
+    echo(srv);
+    api_handler api(srv.address(), "admin", "", srv.port());
+    pipeline pipe(api);
+
+    auto first = pipe.submit(("echo"_cmd)[{"value", "1"}]);
+    api.send("no"_cmd / "such" / "command");
+    auto second = pipe.submit(("echo"_cmd)[{"value", "2"}]);
+
+    auto replies = pipe.collect(second);
+    REQUIRE(replies.size() == 2);
+    CHECK(value(replies[0]) == "2");
+    replies = pipe.collect(first);
+    REQUIRE(replies.size() == 2);
+    CHECK(value(replies[0]) == "1");
+}
+
+TEST_CASE("pipeline returns fatal replies to the tag being read, and forgets the rest",
+          "[pipeline][e2e][api]") {
+    mock::server srv;
+    srv.table("/interface", {{{"name", "ether1"}}});
+    api_handler api(srv.address(), "admin", "", srv.port());
+    pipeline pipe(api);
+
+    // followed prints are never done, so both are in flight when the
+    // connection is terminated by an untagged !fatal
+    auto first = pipe.submit(("interface"_cmd / "print")[{"follow", ""}]);
+    auto second = pipe.submit(("interface"_cmd / "print")[{"follow", ""}]);
+    api.send("quit"_cmd);
+
+    auto replies = pipe.collect(second);
+    REQUIRE(replies.size() == 2);
+    CHECK(replies[0].reply_type == reply::re);
+    CHECK(replies[1].reply_type == reply::fatal);
+    CHECK(pipe.in_flight() == 0);
+    CHECK_THROWS_AS(pipe.read(first), bad_socket);
+}
+
+TEST_CASE("pipeline does not keep sentences that failed to send",
+          "[pipeline][e2e][api]") {
+    mock::server srv;
+    api_handler api(srv.address(), "admin", "", srv.port());
+    pipeline pipe(api);
+    api.disconnect();
+
+    CHECK_THROWS_AS(pipe.submit("system"_cmd / "identity" / "print"), bad_socket);
+    CHECK(pipe.in_flight() == 0);
+}
@@ -0,0 +1,105 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik_api_export.h>
+#if defined(MIKROTIK_API_STATIC_DEFINE) && !defined(_WIN32)
+#    include <catch2/catch.hpp>
+
+#    include <vector>
+
+// test'd
+#    include "impl/poller.hpp"
+using namespace mikrotik::api::impl;
+
+namespace {
+    struct socket_pair {
+        socket_pair() {
+            ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+        }
+        ~socket_pair() {
+            ::close(fds[0]);
+            ::close(fds[1]);
+        }
+
+        int fds[2] = {-1, -1};
+    };
+}
+
+TEST_CASE("poller reports writable sockets with their data",
+          "[poller][util][impl]") {
+    socket_pair pair;
+    poller r;
+    int data = 0;
+    std::vector<poller::event> ready;
+
+    r.add(pair.fds[0], poller::writable, &data);
+    r.wait(ready, 0);
+
+    REQUIRE(ready.size() == 1);
+    CHECK(ready[0].data == &data);
+    CHECK(ready[0].events & poller::writable);
+}
+
+TEST_CASE("poller reports readable sockets only when data arrives",
+          "[poller][util][impl]") {
+    socket_pair pair;
+    poller r;
+    int data = 0;
+    std::vector<poller::event> ready;
+
+    r.add(pair.fds[0], poller::readable, &data);
+    r.wait(ready, 0);
+    CHECK(ready.empty());
+
+    ::write(pair.fds[1], "x", 1);
+    r.wait(ready, 0);
+    REQUIRE(ready.size() == 1);
+    CHECK(ready[0].events & poller::readable);
+}
+
+TEST_CASE("poller forgets removed sockets",
+          "[poller][util][impl]") {
+    socket_pair pair;
+    poller r;
+    int data = 0;
+    std::vector<poller::event> ready;
+
+    r.add(pair.fds[0], poller::writable, &data);
+    CHECK(r.size() == 1);
+    r.remove(pair.fds[0]);
+    CHECK(r.size() == 0);
+
+    r.wait(ready, 0);
+    CHECK(ready.empty());
+}
+#endif
@@ -0,0 +1,87 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// test'd
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/exception/bad_word.hpp>
+#include <mikrotik/api/prepared_sentence.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+
+TEST_CASE("prepared_sentence appends its slots to the constant words",
+          "[prepared_sentence][dsl][api]") {
+    prepared_sentence snt(("ip"_cmd / "address" / "add")[{"interface", "ether1"}],
+                          {"address", "comment"});
+
+    CHECK(snt.slots() == 2);
+    CHECK_THAT(snt.to_sentence().words(),
+               Catch::Equals(std::vector<std::string>{"/ip/address/add",
+                                                      "=interface=ether1",
+                                                      "=address=",
+                                                      "=comment="}));
+}
+
+TEST_CASE("prepared_sentence bind sets slot values",
+          "[prepared_sentence][dsl][api]") {
+    prepared_sentence snt("ip"_cmd / "address" / "add", {"address", "comment"});
+
+    snt.bind("address", "10.0.0.1/24")
+       .bind(snt.slot("comment"), "first");
+    CHECK_THAT(snt.to_sentence().words(),
+               Catch::Equals(std::vector<std::string>{"/ip/address/add",
+                                                      "=address=10.0.0.1/24",
+                                                      "=comment=first"}));
+
+    snt.bind("address", "10.0.0.2/24");
+    CHECK_THAT(snt.to_sentence().words(),
+               Catch::Equals(std::vector<std::string>{"/ip/address/add",
+                                                      "=address=10.0.0.2/24",
+                                                      "=comment=first"}));
+}
+
+TEST_CASE("prepared_sentence slot lookup is by exact name",
+          "[prepared_sentence][dsl][api]") {
+    prepared_sentence snt("ip"_cmd / "address" / "add", {"address", "add"});
+
+    CHECK(snt.slot("address") == 0);
+    CHECK(snt.slot("add") == 1);
+    CHECK_THROWS_AS(snt.slot("addr"), bad_word);
+    CHECK_THROWS_AS(snt.bind("comment", "x"), bad_word);
+    CHECK_THROWS_AS(snt.bind(2, "x"), std::out_of_range);
+}
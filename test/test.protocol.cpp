@@ -0,0 +1,299 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+// stdlib
+#include <string>
+#include <string_view>
+
+// test'd
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/prepared_sentence.hpp>
+#include <mikrotik/api/protocol.hpp>
+#include <mikrotik/api/static_command.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+using namespace std::string_literals;
+
+namespace {
+    std::string
+    encode(std::initializer_list<std::string_view> words) {
+        std::string ret;
+        for (auto word : words) {
+            ret += static_cast<char>(word.size());
+            ret += word;
+        }
+        ret += '\0';
+        return ret;
+    }
+
+    std::string
+    written(const protocol& proto) {
+        std::string ret;
+        auto out = proto.next_output();
+        for (std::size_t i = 0; i < out.count; ++i) {
+            ret.append(out.bufs[i].data, out.bufs[i].size);
+        }
+        return ret;
+    }
+
+    protocol
+    logged_in_protocol() {
+        protocol proto;
+        proto.login("admin", "");
+        proto.consume_output(proto.next_output().size());
+        proto.feed(encode({"!done"}));
+        REQUIRE(proto.next_event() == protocol::logged_in);
+        return proto;
+    }
+}
+
+TEST_CASE("protocol sends the login sentence",
+          "[protocol][api]") {
+    protocol proto;
+    proto.login("admin", "secret");
+
+    CHECK(written(proto) == encode({"/login", "=name=admin", "=password=secret"}));
+    CHECK_FALSE(proto.is_logged_in());
+}
+
+TEST_CASE("protocol reports successful login",
+          "[protocol][api]") {
+    protocol proto;
+    proto.login("admin", "");
+    proto.consume_output(proto.next_output().size());
+    CHECK(proto.next_output().empty());
+
+    CHECK(proto.next_event() == protocol::need_input);
+    proto.feed(encode({"!done"}));
+    CHECK(proto.next_event() == protocol::logged_in);
+    CHECK(proto.is_logged_in());
+    CHECK(proto.next_event() == protocol::need_input);
+}
+
+TEST_CASE("protocol throws if the login is rejected",
+          "[protocol][api]") {
+    protocol proto;
+    proto.login("admin", "wrong");
+    proto.feed(encode({"!trap", "=message=invalid user name or password (6)"}));
+
+    CHECK_THROWS_AS(proto.next_event(), bad_socket);
+    CHECK_FALSE(proto.is_logged_in());
+}
+
+TEST_CASE("protocol decodes replies fed in pieces",
+          "[protocol][api]") {
+    auto proto = logged_in_protocol();
+    auto bytes = encode({"!re", "=name=ether1"}) + encode({"!done"});
+
+    for (std::size_t i = 0; i < bytes.size() - 7; ++i) {
+        REQUIRE(proto.next_event() == protocol::need_input);
+        CHECK(proto.needed() >= 1);
+        proto.feed(bytes.substr(i, 1));
+    }
+    REQUIRE(proto.next_event() == protocol::received);
+    CHECK(proto.view().reply_type == reply::re);
+    CHECK_THAT(proto.view().attributes, Catch::Equals(std::vector<std::string_view>{"=name=ether1"}));
+
+    REQUIRE(proto.next_event() == protocol::need_input);
+    proto.feed(bytes.substr(bytes.size() - 7));
+    REQUIRE(proto.next_event() == protocol::received);
+    CHECK(proto.view().reply_type == reply::done);
+    CHECK(proto.view().attributes.empty());
+}
+
+TEST_CASE("protocol decodes every sentence of a single feed",
+          "[protocol][api]") {
+    auto proto = logged_in_protocol();
+    proto.feed(encode({"!re", "=name=ether1"})
+               + encode({"!trap", "=message=failure"})
+               + encode({"!fatal", "session terminated"}));
+
+    REQUIRE(proto.next_event() == protocol::received);
+    CHECK(proto.view().reply_type == reply::re);
+    REQUIRE(proto.next_event() == protocol::received);
+    CHECK(proto.view().reply_type == reply::trap);
+    REQUIRE(proto.next_event() == protocol::received);
+    CHECK(proto.view().reply_type == reply::fatal);
+    CHECK(proto.next_event() == protocol::need_input);
+}
+
+TEST_CASE("protocol reports how many bytes are missing",
+          "[protocol][api]") {
+    auto proto = logged_in_protocol();
+    auto bytes = encode({"!re", "=name=ether1"});
+    proto.feed(bytes.substr(0, 5));
+
+    REQUIRE(proto.next_event() == protocol::need_input);
+    // the rest of the =name=ether1 word and the terminating empty word
+    CHECK(proto.needed() == bytes.size() - 5);
+}
+
+TEST_CASE("protocol receives into its own buffer",
+          "[protocol][api]") {
+    auto proto = logged_in_protocol();
+    auto bytes = encode({"!done"});
+
+    auto buf = proto.prepare_input(bytes.size());
+    REQUIRE(proto.input_space() >= bytes.size());
+    bytes.copy(buf, bytes.size());
+    proto.commit_input(bytes.size());
+
+    REQUIRE(proto.next_event() == protocol::received);
+    CHECK(proto.view().reply_type == reply::done);
+}
+
+TEST_CASE("protocol throws on reserved control bytes",
+          "[protocol][api]") {
+    auto proto = logged_in_protocol();
+    proto.feed("\xF8"s);
+
+    CHECK_THROWS_AS(proto.next_event(), bad_socket);
+}
+
+TEST_CASE("protocol queues sentences in order",
+          "[protocol][api]") {
+    protocol proto;
+    sentence snt = "system"_cmd / "identity" / "print";
+    prepared_sentence prep(sentence("interface"_cmd / "print"), {});
+    constexpr auto resource = command_path("system", "resource", "print");
+    constexpr auto quit = command_path("quit");
+
+    proto.send(snt, ".tag=1");
+    proto.send(prep, ".tag=2");
+    proto.send_encoded(resource.encoded());
+
+    auto expected = encode({"/system/identity/print", ".tag=1"})
+                    + encode({"/interface/print", ".tag=2"})
+                    + encode({"/system/resource/print"});
+    CHECK(written(proto) == expected);
+    CHECK(proto.next_output().size() == expected.size());
+
+    proto.consume_output(5);
+    CHECK(written(proto) == expected.substr(5));
+    proto.consume_output(expected.size());
+    CHECK(proto.next_output().empty());
+
+    proto.send_encoded(quit.encoded());
+    CHECK(written(proto) == encode({"/quit"}));
+}
+
+TEST_CASE("protocol sends sentences from where they are",
+          "[protocol][api]") {
+    protocol proto;
+    sentence snt = "system"_cmd / "identity" / "print";
+    constexpr auto quit = command_path("quit");
+
+    proto.send(snt);
+    auto out = proto.next_output();
+    REQUIRE(out.count == 2);
+    CHECK(out.bufs[0].data == snt.encoded().data());
+    CHECK(out.bufs[0].size == snt.encoded().size());
+    proto.consume_output(out.size());
+
+    proto.send_encoded(quit.encoded());
+    out = proto.next_output();
+    REQUIRE(out.count == 1);
+    CHECK(out.bufs[0].data == quit.encoded().data());
+}
+
+TEST_CASE("protocol continues a short write in the middle of a buffer",
+          "[protocol][api]") {
+    protocol proto;
+    sentence first = "interface"_cmd / "print";
+    sentence second = "system"_cmd / "identity" / "print";
+    proto.send(first);
+    proto.send(second, ".tag=2");
+    auto expected = encode({"/interface/print"}) + encode({"/system/identity/print", ".tag=2"});
+
+    // into the words of the second sentence, past the terminator of the first
+    auto split = encode({"/interface/print"}).size() + 3;
+    proto.consume_output(split);
+    auto out = proto.next_output();
+    REQUIRE(out.count == 2);
+    CHECK(out.bufs[0].data == second.encoded().data() + 3);
+    CHECK(written(proto) == expected.substr(split));
+
+    proto.consume_output(out.bufs[0].size);
+    CHECK(written(proto) == encode({"/system/identity/print", ".tag=2"}).substr(second.encoded().size()));
+    proto.consume_output(proto.next_output().size());
+    CHECK(proto.next_output().empty());
+}
+
+TEST_CASE("protocol discards output not written",
+          "[protocol][api]") {
+    protocol proto;
+    sentence snt = "interface"_cmd / "print";
+    proto.send(snt, ".tag=1");
+    proto.consume_output(3);
+
+    proto.discard_output();
+    CHECK(proto.next_output().empty());
+
+    proto.send(snt);
+    CHECK(written(proto) == encode({"/interface/print"}));
+}
+
+TEST_CASE("protocol counts the sentences waiting for replies",
+          "[protocol][api]") {
+    auto proto = logged_in_protocol();
+    CHECK(proto.outstanding() == 0);
+
+    sentence snt = "interface"_cmd / "print";
+    constexpr auto quit = command_path("quit");
+    auto both = encode({"/system/identity/print"}) + encode({"/system/resource/print"});
+    proto.send(snt, ".tag=1");
+    proto.send_encoded(quit.encoded());
+    proto.send_encoded(both);
+    CHECK(proto.outstanding() == 4);
+
+    proto.feed(encode({"!re", "=name=ether1", ".tag=1"})
+               + encode({"!trap", "=message=failure", ".tag=1"})
+               + encode({"!done", ".tag=1"})
+               + encode({"!done"}));
+    REQUIRE(proto.next_event() == protocol::received);
+    CHECK(proto.buffered_input() > 0);
+    REQUIRE(proto.next_event() == protocol::received);
+    CHECK(proto.outstanding() == 4);
+    REQUIRE(proto.next_event() == protocol::received);
+    CHECK(proto.outstanding() == 3);
+    REQUIRE(proto.next_event() == protocol::received);
+    CHECK(proto.outstanding() == 2);
+    CHECK(proto.buffered_input() == 0);
+
+    proto.feed(encode({"!fatal", "session terminated"}));
+    REQUIRE(proto.next_event() == protocol::received);
+    CHECK(proto.outstanding() == 0);
+}
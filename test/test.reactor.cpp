@@ -0,0 +1,142 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik_api_export.h>
+#if defined(MIKROTIK_API_STATIC_DEFINE) && !defined(_WIN32)
+#    include <catch2/catch.hpp>
+
+#    include <cstring>
+#    include <memory>
+#    include <vector>
+
+// test'd
+#    include "impl/reactor.hpp"
+using namespace mikrotik::api::impl;
+
+namespace {
+    struct socket_pair {
+        socket_pair() {
+            ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+        }
+        ~socket_pair() {
+            ::close(fds[0]);
+            ::close(fds[1]);
+        }
+
+        int fds[2] = {-1, -1};
+    };
+
+    std::vector<std::unique_ptr<reactor>>
+    all_reactors() {
+        std::vector<std::unique_ptr<reactor>> ret;
+        ret.push_back(make_poll_reactor());
+#    ifdef MIKROTIK_API_IO_URING
+        if (auto ring = make_uring_reactor())
+            ret.push_back(std::move(ring));
+#    endif
+        return ret;
+    }
+
+    std::vector<reactor::completion>
+    wait_all(reactor& r) {
+        std::vector<reactor::completion> ret;
+        std::vector<reactor::completion> done;
+        while (r.pending() > 0) {
+            r.wait(done, -1);
+            ret.insert(ret.end(), done.begin(), done.end());
+        }
+        return ret;
+    }
+}
+
+TEST_CASE("reactor sends gathered buffers",
+          "[reactor][util][impl]") {
+    for (auto& r : all_reactors()) {
+        socket_pair pair;
+        int data = 0;
+        socket::buffer bufs[] = {{"ab", 2}, {"cde", 3}};
+
+        r->send(pair.fds[0], bufs, 2, &data);
+        auto done = wait_all(*r);
+
+        REQUIRE(done.size() == 1);
+        CHECK(done[0].data == &data);
+        CHECK(done[0].error == 0);
+        CHECK(done[0].bytes == 5);
+
+        char buf[8]{};
+        CHECK(::read(pair.fds[1], buf, sizeof(buf)) == 5);
+        CHECK(std::strcmp(buf, "abcde") == 0);
+    }
+}
+
+TEST_CASE("reactor completes receive when data arrives",
+          "[reactor][util][impl]") {
+    for (auto& r : all_reactors()) {
+        socket_pair pair;
+        int data = 0;
+        char buf[8]{};
+        std::vector<reactor::completion> done;
+
+        r->recv(pair.fds[0], buf, sizeof(buf), &data);
+        r->wait(done, 0);
+        CHECK(done.empty());
+        CHECK(r->pending() == 1);
+
+        ::write(pair.fds[1], "xyz", 3);
+        done = wait_all(*r);
+
+        REQUIRE(done.size() == 1);
+        CHECK(done[0].data == &data);
+        CHECK(done[0].bytes == 3);
+        CHECK(std::strcmp(buf, "xyz") == 0);
+    }
+}
+
+TEST_CASE("reactor reports closed connections as empty receive",
+          "[reactor][util][impl]") {
+    for (auto& r : all_reactors()) {
+        socket_pair pair;
+        int data = 0;
+        char buf[8]{};
+
+        r->recv(pair.fds[0], buf, sizeof(buf), &data);
+        ::shutdown(pair.fds[1], SHUT_WR);
+        auto done = wait_all(*r);
+
+        REQUIRE(done.size() == 1);
+        CHECK(done[0].error == 0);
+        CHECK(done[0].bytes == 0);
+    }
+}
+#endif
@@ -0,0 +1,100 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <string>
+#include <string_view>
+using namespace std::literals;
+
+// test'd
+#include <mikrotik/api/impl/recv_buffer.hpp>
+using namespace mikrotik::api::impl;
+
+namespace {
+    void
+    put(recv_buffer& buf, std::string_view str) {
+        auto ptr = buf.prepare(str.size());
+        std::memcpy(ptr, str.data(), str.size());
+        buf.commit(str.size());
+    }
+}
+
+TEST_CASE("recv_buffer is empty after creation",
+          "[recv_buffer][util][impl]") {
+    recv_buffer buf;
+
+    CHECK(buf.size() == 0);
+    CHECK(buf.data().empty());
+}
+
+TEST_CASE("recv_buffer keeps committed bytes in order",
+          "[recv_buffer][util][impl]") {
+    recv_buffer buf;
+    put(buf, "abc");
+    put(buf, "def");
+
+    CHECK(buf.data() == "abcdef"sv);
+}
+
+TEST_CASE("recv_buffer drops consumed bytes from the front",
+          "[recv_buffer][util][impl]") {
+    recv_buffer buf;
+    put(buf, "abcdef");
+    buf.consume(2);
+
+    CHECK(buf.data() == "cdef"sv);
+}
+
+TEST_CASE("recv_buffer keeps unconsumed bytes when compacting",
+          "[recv_buffer][util][impl]") {
+    recv_buffer buf(8);
+    put(buf, "abcdefgh");
+    buf.consume(6);
+    put(buf, "ijklmn");
+
+    CHECK(buf.data() == "ghijklmn"sv);
+}
+
+TEST_CASE("recv_buffer grows to fit bigger requests",
+          "[recv_buffer][util][impl]") {
+    recv_buffer buf(4);
+    std::string big(1000, 'a');
+    put(buf, "xy");
+    put(buf, big);
+
+    CHECK(buf.size() == 1002);
+    CHECK(buf.space() + buf.size() >= 1002);
+    CHECK(buf.data().substr(0, 3) == "xya"sv);
+}
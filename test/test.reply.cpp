@@ -0,0 +1,174 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+// stdlib
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// test'd
+#include <mikrotik/api/api_handler.hpp>
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/mock/server.hpp>
+#include <mikrotik/api/reply.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+
+namespace {
+    struct counting_resource : std::pmr::memory_resource {
+        std::size_t allocations = 0;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t align) override {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, align);
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    // replaces the default memory resource while alive
+    struct default_resource {
+        explicit default_resource(std::pmr::memory_resource* resource) noexcept
+             : previous(std::pmr::set_default_resource(resource)) { }
+
+        default_resource(const default_resource&) = delete;
+        default_resource& operator=(const default_resource&) = delete;
+
+        ~default_resource() noexcept {
+            std::pmr::set_default_resource(previous);
+        }
+
+        std::pmr::memory_resource* previous;
+    };
+
+    // long enough not to fit any small string buffer
+    mock::row
+    interface(std::size_t idx) {
+        return {{"name", "ether" + std::to_string(idx)},
+                {"comment", std::string(100, 'x')}};
+    }
+}
+
+TEST_CASE("pmr::reply allocates its attributes from its memory resource",
+          "[reply][pmr][api]") {
+    counting_resource fallback;
+    counting_resource pool;
+    default_resource guard(&fallback);
+
+    pmr::reply rep(&pool);
+    rep.attributes.emplace_back(std::string(100, 'x'));
+    rep.attributes.emplace_back("=name=ether1-with-a-long-name");
+
+    CHECK(rep.attributes.get_allocator().resource() == &pool);
+    CHECK(rep.attributes[0].get_allocator().resource() == &pool);
+    CHECK(pool.allocations > 0);
+    CHECK(fallback.allocations == 0);
+}
+
+TEST_CASE("pmr::reply can be stored in pmr containers",
+          "[reply][pmr][api]") {
+    counting_resource fallback;
+    default_resource guard(&fallback);
+    std::pmr::monotonic_buffer_resource mr(std::pmr::new_delete_resource());
+
+    pmr::reply rep;
+    rep.reply_type = reply::re;
+    rep.attributes.emplace_back("=comment=" + std::string(100, 'x'));
+    auto allocated = fallback.allocations;
+
+    std::pmr::vector<pmr::reply> replies(&mr);
+    replies.push_back(rep);
+    replies.push_back(std::move(rep));
+    replies.emplace_back();
+    pmr::reply empty = {};
+    replies.push_back(empty);
+
+    REQUIRE(replies.size() == 4);
+    CHECK(replies[0].reply_type == reply::re);
+    CHECK(replies[1].reply_type == reply::re);
+    CHECK(std::string_view(replies[1].attributes.at(0)) == "=comment=" + std::string(100, 'x'));
+    for (const auto& elem : replies) {
+        CHECK(elem.attributes.get_allocator().resource() == &mr);
+        for (const auto& attr : elem.attributes) {
+            CHECK(attr.get_allocator().resource() == &mr);
+        }
+    }
+    CHECK(fallback.allocations == allocated);
+}
+
+TEST_CASE("api_handler reads pmr replies from the given memory resource",
+          "[reply][pmr][e2e][api]") {
+    mock::server srv;
+    srv.generate("/interface", 10, interface);
+    api_handler api(srv.address(), "admin", "", srv.port());
+
+    counting_resource fallback;
+    counting_resource pool;
+    default_resource guard(&fallback);
+
+    SECTION("into a reply") {
+        pmr::reply rep(&pool);
+        api.send("interface"_cmd / "print");
+        std::size_t rows = 0;
+        for (api.read(rep); rep.reply_type == rep.re; api.read(rep)) {
+            REQUIRE(rep.attributes.size() == 2);
+            CHECK(std::string_view(rep.attributes[1]) == "=comment=" + std::string(100, 'x'));
+            ++rows;
+        }
+        CHECK(rows == 10);
+    }
+    SECTION("with read_pmr") {
+        api.set_memory_resource(&pool);
+        api.send("interface"_cmd / "print");
+        std::vector<pmr::reply> replies;
+        do {
+            replies.push_back(api.read_pmr());
+        } while (replies.back().reply_type == reply::re);
+
+        CHECK(replies.size() == 11);
+        CHECK(replies[0].attributes.get_allocator().resource() == &pool);
+    }
+    CHECK(pool.allocations > 0);
+    CHECK(fallback.allocations == 0);
+}
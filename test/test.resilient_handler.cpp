@@ -0,0 +1,163 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+// stdlib
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+
+// test'd
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/mock/server.hpp>
+#include <mikrotik/api/resilient_handler.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+using namespace std::chrono_literals;
+
+namespace {
+    resilient_options
+    quick_retries() {
+        resilient_options opts;
+        opts.retry.initial = 1ms;
+        opts.retry.max = 10ms;
+        opts.retry.attempts = 3;
+        opts.limits.operation = 2s;
+        return opts;
+    }
+
+    // makes the device end the session, like a reboot would
+    void
+    break_connection(resilient_handler& api) {
+        api.connection().send(sentence("quit"_cmd));
+        REQUIRE(api.connection().read().reply_type == reply::fatal);
+    }
+}
+
+TEST_CASE("backoff delays grow exponentially up to the maximum",
+          "[resilient_handler][backoff][api]") {
+    backoff policy;
+    policy.initial = 100ms;
+    policy.max = 1s;
+    std::mt19937 rng(42);
+
+    for (int i = 0; i < 20; ++i) {
+        CHECK(policy.delay(0, rng) <= 100ms);
+        CHECK(policy.delay(2, rng) <= 400ms);
+        CHECK(policy.delay(30, rng) <= 1s);
+        CHECK(policy.delay(1000, rng) >= 0ms);
+    }
+
+    policy.initial = 0ms;
+    CHECK(policy.delay(3, rng) == 0ms);
+}
+
+TEST_CASE("resilient_handler executes sentences",
+          "[resilient_handler][e2e][api]") {
+    mock::server srv;
+    srv.table("/system/identity", {{{"name", "MikroTik"}}});
+    resilient_handler api(srv.address(), "admin", "", srv.port(), quick_retries());
+    CHECK_FALSE(api.is_connected());
+
+    auto replies = api.execute(sentence("system"_cmd / "identity" / "print"));
+    REQUIRE(replies.size() == 2);
+    CHECK(replies[0].reply_type == reply::re);
+    CHECK(replies[1].reply_type == reply::done);
+    CHECK(api.is_connected());
+    CHECK(api.reconnects() == 0);
+}
+
+TEST_CASE("resilient_handler replays idempotent sentences on a new connection",
+          "[resilient_handler][e2e][api]") {
+    mock::server srv;
+    srv.table("/system/identity", {{{"name", "MikroTik"}}});
+    resilient_handler api(srv.address(), "admin", "", srv.port(), quick_retries());
+    api.execute(sentence("system"_cmd / "identity" / "print"));
+
+    break_connection(api);
+    auto replies = api.execute(sentence("system"_cmd / "identity" / "print"));
+    REQUIRE(replies.size() == 2);
+    CHECK(replies[0].reply_type == reply::re);
+    CHECK(api.reconnects() == 1);
+    CHECK(srv.connections() == 2);
+}
+
+TEST_CASE("resilient_handler does not replay mutating sentences",
+          "[resilient_handler][e2e][api]") {
+    mock::server srv;
+    srv.table("/system/identity", {{{"name", "MikroTik"}}});
+    resilient_handler api(srv.address(), "admin", "", srv.port(), quick_retries());
+    api.execute(sentence("system"_cmd / "identity" / "print"));
+
+    break_connection(api);
+    CHECK_THROWS_AS(api.execute(("system"_cmd / "identity" / "set")[{"name", "other"}]),
+                    bad_socket);
+    CHECK_FALSE(api.is_connected());
+
+    api.execute(sentence("system"_cmd / "identity" / "print"));
+    CHECK(api.reconnects() == 1);
+}
+
+TEST_CASE("resilient_handler reconnects after the device restarts",
+          "[resilient_handler][e2e][api]") {
+    auto srv = std::make_unique<mock::server>();
+    const auto port = srv->port();
+    resilient_handler api(srv->address(), "admin", "", port, quick_retries());
+    api.execute(sentence("system"_cmd / "identity" / "print"));
+
+    srv.reset();
+    srv = std::make_unique<mock::server>(port);
+    srv->table("/system/identity", {{{"name", "rebooted"}}});
+
+    auto replies = api.execute(sentence("system"_cmd / "identity" / "print"));
+    REQUIRE(replies.size() == 2);
+    CHECK(replies[0].reply_type == reply::re);
+    CHECK(api.reconnects() == 1);
+}
+
+TEST_CASE("resilient_handler gives up after the allowed attempts",
+          "[resilient_handler][e2e][api]") {
+    std::uint16_t port;
+    {
+        mock::server srv;
+        port = srv.port();
+    }
+    resilient_handler api(ip_address("127.0.0.1"), "admin", "", port, quick_retries());
+
+    CHECK_THROWS_AS(api.execute(sentence("system"_cmd / "identity" / "print")), bad_socket);
+    CHECK_THROWS_AS(api.connection(), bad_socket);
+    CHECK_FALSE(api.is_connected());
+}
@@ -0,0 +1,148 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+// stdlib
+#include <optional>
+#include <string>
+#include <vector>
+
+// test'd
+#include <mikrotik/api/api_handler.hpp>
+#include <mikrotik/api/attribute_map.hpp>
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/exception/bad_command.hpp>
+#include <mikrotik/api/mock/server.hpp>
+#include <mikrotik/api/row_stream.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+
+namespace {
+    mock::row
+    interface(std::size_t idx) {
+        return {{"name", "ether" + std::to_string(idx)}};
+    }
+
+    std::optional<std::string>
+    identity(api_handler& api) {
+        api.send("system"_cmd / "identity" / "print");
+        auto rep = api.read();
+        if (rep.reply_type != reply::re || api.read().reply_type != reply::done)
+            return std::nullopt;
+        auto name = attribute_map(rep).get("name");
+        return name ? std::optional<std::string>(*name) : std::nullopt;
+    }
+}
+
+TEST_CASE("row_stream does not show its tag in the rows",
+          "[row_stream][e2e][api]") {
+    mock::server srv;
+    srv.generate("/interface", 3, interface);
+    api_handler api(srv.address(), "admin", "", srv.port());
+
+    for (const auto& row : api.stream("interface"_cmd / "print")) {
+        CHECK(row.reply_type == reply::re);
+        CHECK(row.attributes.size() == 1);
+        CHECK(attribute_map(row).get(".tag") == std::nullopt);
+    }
+}
+
+TEST_CASE("row_stream throws bad_command on a trap, and leaves the connection usable",
+          "[row_stream][e2e][api]") {
+    mock::server srv;
+    srv.table("/system/identity", {{{"name", "MikroTik"}}});
+    api_handler api(srv.address(), "admin", "", srv.port());
+
+    auto iterate = [&api] {
+        for (const auto& row : api.stream("no"_cmd / "such" / "print")) {
+            (void) row;
+        }
+    };
+    CHECK_THROWS_AS(iterate(), bad_command);
+    CHECK(identity(api) == "MikroTik");
+}
+
+TEST_CASE("row_stream reads the rest of the rows when destroyed early",
+          "[row_stream][e2e][api]") {
+    mock::server srv;
+    srv.generate("/interface", 1000, interface);
+    srv.table("/system/identity", {{{"name", "MikroTik"}}});
+    api_handler api(srv.address(), "admin", "", srv.port());
+
+    {
+        auto rows = api.stream("interface"_cmd / "print");
+        auto it = rows.begin();
+        ++it;
+        CHECK(attribute_map(*it).get("name") == "ether1");
+    }
+    CHECK(identity(api) == "MikroTik");
+}
+
+TEST_CASE("row_stream cancels followed commands when destroyed early",
+          "[row_stream][e2e][api]") {
+    mock::server srv;
+    srv.generate("/interface", 10, interface);
+    srv.table("/system/identity", {{{"name", "MikroTik"}}});
+    api_handler api(srv.address(), "admin", "", srv.port());
+
+    std::size_t seen = 0;
+    for (const auto& row : api.stream(("interface"_cmd / "print")[{"follow", ""}])) {
+        CHECK(row.reply_type == reply::re);
+        if (++seen == 10)
+            break;
+    }
+    CHECK(seen == 10);
+    CHECK(identity(api) == "MikroTik");
+}
+
+TEST_CASE("row_stream moves the unread replies into the new stream",
+          "[row_stream][e2e][api]") {
+    mock::server srv;
+    srv.generate("/interface", 5, interface);
+    srv.table("/system/identity", {{{"name", "MikroTik"}}});
+    api_handler api(srv.address(), "admin", "", srv.port());
+
+    std::size_t seen = 0;
+    {
+        auto first = api.stream("interface"_cmd / "print");
+        row_stream second(std::move(first));
+        for (const auto& row : second) {
+            (void) row;
+            ++seen;
+        }
+        CHECK(second.done());
+    }
+    CHECK(seen == 5);
+    CHECK(identity(api) == "MikroTik");
+}
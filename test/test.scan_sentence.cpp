@@ -0,0 +1,86 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik_api_export.h>
+#ifdef MIKROTIK_API_STATIC_DEFINE
+#    include <catch2/catch.hpp>
+
+#    include <string>
+#    include <string_view>
+#    include <vector>
+using namespace std::literals;
+
+// test'd
+#    include <mikrotik/api/exception/bad_socket.hpp>
+#    include "impl/scan_sentence.hpp"
+using namespace mikrotik::api::impl;
+
+TEST_CASE("scan_sentence splits a complete sentence into words",
+          "[scan_sentence][util][impl]") {
+    std::vector<std::string_view> words;
+    std::size_t need = 0;
+    auto data = "\x03!re\x07=name=a\x00\x05!done\x00"sv;
+
+    CHECK(scan_sentence(data, words, need) == 13);
+    CHECK_THAT(words, Catch::Equals(std::vector<std::string_view>{"!re", "=name=a"}));
+}
+
+TEST_CASE("scan_sentence asks for the rest of an incomplete word",
+          "[scan_sentence][util][impl]") {
+    std::vector<std::string_view> words;
+    std::size_t need = 0;
+    auto data = "\x03!re\x07=na"sv;
+
+    CHECK(scan_sentence(data, words, need) == 0);
+    CHECK(need == 13);
+}
+
+TEST_CASE("scan_sentence asks for one byte if the terminating word is missing",
+          "[scan_sentence][util][impl]") {
+    std::vector<std::string_view> words;
+    std::size_t need = 0;
+    auto data = "\x05!done"sv;
+
+    CHECK(scan_sentence(data, words, need) == 0);
+    CHECK(need == 7);
+}
+
+TEST_CASE("scan_sentence throws on reserved control bytes",
+          "[scan_sentence][util][impl]") {
+    std::vector<std::string_view> words;
+    std::size_t need = 0;
+    auto data = "\x03!re\xF8\x00"sv;
+
+    CHECK_THROWS_AS(scan_sentence(data, words, need), mikrotik::api::bad_socket);
+}
+#endif
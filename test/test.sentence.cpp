@@ -33,12 +33,58 @@
 
 #include <catch2/catch.hpp>
 
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <string>
+
 // test'd
 #include <mikrotik/api/command.hpp>
+#include <mikrotik/api/ip_address.hpp>
 #include <mikrotik/api/sentence.hpp>
 using namespace mikrotik::api;
 using namespace mikrotik::api::literals;
 
+namespace {
+    struct counting_resource : std::pmr::memory_resource {
+        std::size_t allocations = 0;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t align) override {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, align);
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+
+    // replaces the default memory resource while alive
+    struct default_resource {
+        explicit default_resource(std::pmr::memory_resource* resource) noexcept
+             : previous(std::pmr::set_default_resource(resource)) { }
+
+        default_resource(const default_resource&) = delete;
+        default_resource& operator=(const default_resource&) = delete;
+
+        ~default_resource() noexcept {
+            std::pmr::set_default_resource(previous);
+        }
+
+        std::pmr::memory_resource* previous;
+    };
+}
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef __int128 int128;
+__extension__ typedef unsigned __int128 uint128;
+#endif
+
 TEST_CASE("sentence can be created from a command",
           "[sentence][dsl][api]") {
     auto cmd = "login"_cmd;
@@ -110,3 +156,145 @@ TEST_CASE("named sentence can be expanded with query word",
                                                       "?type=ether",
                                                       "?#|"}));
 }
+
+TEST_CASE("sentence words view the stored words",
+          "[sentence][dsl][api]") {
+    auto snt = ("interface"_cmd / "print")[{".proplist", "name"}];
+    auto words = snt.words();
+
+    CHECK(words.size() == 2);
+    CHECK(words.front() == "/interface/print");
+    CHECK(words.back() == "=.proplist=name");
+    CHECK(words[1] == words.end()[-1]);
+    CHECK(words == sentence{"/interface/print", "=.proplist=name"}.words());
+    CHECK(words != sentence{"/interface/print"}.words());
+}
+
+TEST_CASE("sentence stores words encoded",
+          "[sentence][dsl][api]") {
+    auto snt = ("interface"_cmd / "print")("type");
+
+    CHECK(snt.encoded() == std::string_view("\x10/interface/print\x05?type"));
+    CHECK(sentence().encoded().empty());
+}
+
+TEST_CASE("sentence copies are independent",
+          "[sentence][dsl][api]") {
+    sentence snt("interface"_cmd / "print");
+    auto added = snt["detail"];
+    std::string big(300, 'x');
+    auto grown = added[{"comment", big}];
+
+    CHECK(snt.words().size() == 1);
+    CHECK(added.words().size() == 2);
+    CHECK(grown.words().size() == 3);
+    CHECK(grown.words()[2].size() == 300 + 9);
+    CHECK(grown.words()[1] == "=detail=");
+}
+
+TEST_CASE("sentence builders add attributes with typed values",
+          "[sentence][dsl][api]") {
+    sentence snt("interface"_cmd / "vlan" / "add");
+    snt.add_attribute("name", "vlan42")
+       .add_attribute("vlan-id", 42)
+       .add_attribute("mtu", -1L)
+       .add_attribute("disabled", false)
+       .add_attribute("arp", true)
+       .add_attribute("address", ip_address{"10.0.0.1"})
+       .add_attribute("comment");
+
+    CHECK_THAT(snt.words(),
+               Catch::Equals(std::vector<std::string>{"/interface/vlan/add",
+                                                      "=name=vlan42",
+                                                      "=vlan-id=42",
+                                                      "=mtu=-1",
+                                                      "=disabled=no",
+                                                      "=arp=yes",
+                                                      "=address=10.0.0.1",
+                                                      "=comment="}));
+}
+
+TEST_CASE("sentence builders add queries with typed values",
+          "[sentence][dsl][api]") {
+    sentence snt("interface"_cmd / "print");
+    snt.add_query("type", "vlan")
+       .add_query(">mtu", 1500u)
+       .add_query("running", true)
+       .add_query("address", ip_address{"10.0.0.1"})
+       .add_query("#|");
+
+    CHECK_THAT(snt.words(),
+               Catch::Equals(std::vector<std::string>{"/interface/print",
+                                                      "?type=vlan",
+                                                      "?>mtu=1500",
+                                                      "?running=yes",
+                                                      "?address=10.0.0.1",
+                                                      "?#|"}));
+}
+
+TEST_CASE("sentence builders write the extremes of every integer type",
+          "[sentence][dsl][api]") {
+    sentence snt("interface"_cmd / "set");
+    snt.add_attribute("a", std::numeric_limits<std::int64_t>::min())
+       .add_attribute("b", std::numeric_limits<std::uint64_t>::max())
+       .add_query("c", std::numeric_limits<std::int8_t>::min());
+
+    CHECK_THAT(snt.words(),
+               Catch::Equals(std::vector<std::string>{"/interface/set",
+                                                      "=a=-9223372036854775808",
+                                                      "=b=18446744073709551615",
+                                                      "?c=-128"}));
+
+#ifdef __SIZEOF_INT128__
+    if constexpr (sentence::is_typed_value<int128>) {
+        sentence wide("interface"_cmd / "set");
+        wide.add_attribute("min", std::numeric_limits<int128>::min())
+            .add_attribute("max", std::numeric_limits<uint128>::max());
+
+        CHECK_THAT(wide.words(),
+                   Catch::Equals(std::vector<std::string>{"/interface/set",
+                                                          "=min=-170141183460469231731687303715884105728",
+                                                          "=max=340282366920938463463374607431768211455"}));
+    }
+#endif
+}
+
+TEST_CASE("sentence builders produce the same words as the DSL",
+          "[sentence][dsl][api]") {
+    sentence snt("ip"_cmd / "address" / "print");
+    snt.add_attribute(".proplist", "address")
+       .add_query("interface", "ether1");
+
+    CHECK(snt.words() == (("ip"_cmd / "address" / "print")[{".proplist", "address"}]({"interface", "ether1"})).words());
+    CHECK(snt.encoded() == (("ip"_cmd / "address" / "print")[{".proplist", "address"}]({"interface", "ether1"})).encoded());
+}
+
+TEST_CASE("sentence allocates long words from its memory resource",
+          "[sentence][dsl][api]") {
+    char buf[16 * 1024];
+    std::pmr::monotonic_buffer_resource pool(buf, sizeof(buf), std::pmr::null_memory_resource());
+    sentence snt(&pool);
+    snt.add_word("/interface/print");
+    snt.add_attribute("comment", std::string(1000, 'x'));
+
+    auto cp = snt["detail"];
+    CHECK(cp.memory_resource() == &pool);
+    CHECK(cp.words().size() == 3);
+    CHECK(cp.words()[1].size() == 1000 + 9);
+}
+
+TEST_CASE("sentence does not allocate from the default memory resource when given one",
+          "[sentence][dsl][api]") {
+    counting_resource fallback;
+    counting_resource pool;
+    default_resource guard(&fallback);
+
+    sentence snt(&pool);
+    snt.add_word("/interface/print");
+    snt.add_attribute("comment", std::string(1000, 'x'));
+    auto cp = snt["detail"]({"name", std::string(1000, 'y')});
+
+    CHECK(cp.words().size() == 4);
+    CHECK(pool.allocations > 0);
+    CHECK(fallback.allocations == 0);
+}
@@ -0,0 +1,236 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+// stdlib
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// test'd
+#include <mikrotik/api/attribute_map.hpp>
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/exception/bad_socket.hpp>
+#include <mikrotik/api/exception/socket_timeout.hpp>
+#include <mikrotik/api/mock/server.hpp>
+#include <mikrotik/api/shared_connection.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+using namespace std::chrono_literals;
+
+namespace {
+    void
+    echo(mock::server& srv) {
+        srv.on("/echo", [](const mock::request& req) {
+            return std::vector<reply>{{reply::re, {"=value=" + std::string(*req.attribute("value"))}},
+                                      {reply::done, {}}};
+        });
+    }
+}
+
+TEST_CASE("shared_connection completes futures with the replies",
+          "[shared_connection][e2e][api]") {
+    mock::server srv;
+    srv.table("/interface", {{{"name", "ether1"}}, {{"name", "ether2"}}});
+    shared_connection conn(srv.address(), "admin", "", srv.port());
+
+    auto replies = conn.submit(sentence("interface"_cmd / "print")).get();
+    REQUIRE(replies.size() == 3);
+    CHECK(replies[0].reply_type == reply::re);
+    CHECK_THAT(replies[0].attributes, Catch::Equals(std::vector<std::string>{"=name=ether1"}));
+    CHECK(replies[1].reply_type == reply::re);
+    CHECK(replies[2].reply_type == reply::done);
+    CHECK(replies[2].attributes.empty());
+    CHECK(conn.pending() == 0);
+    CHECK_FALSE(conn.failed());
+}
+
+TEST_CASE("shared_connection calls callbacks with the replies",
+          "[shared_connection][e2e][api]") {
+    mock::server srv;
+    shared_connection conn(srv.address(), "admin", "", srv.port());
+
+    std::promise<std::vector<reply>> result;
+    conn.submit(sentence("nothing"_cmd / "here"),
+                [&result](std::vector<reply>&& replies, std::exception_ptr err) {
+                    CHECK_FALSE(err);
+                    result.set_value(std::move(replies));
+                });
+
+    auto replies = result.get_future().get();
+    REQUIRE(replies.size() == 2);
+    CHECK(replies[0].reply_type == reply::trap);
+    CHECK(replies[1].reply_type == reply::done);
+}
+
+TEST_CASE("shared_connection keeps working after a callback throws",
+          "[shared_connection][e2e][api]") {
+    mock::server srv;
+    echo(srv);
+    shared_connection conn(srv.address(), "admin", "", srv.port());
+
+    std::promise<void> called;
+    conn.submit(sentence("echo"_cmd)[{"value", "1"}],
+                [&called](std::vector<reply>&&, std::exception_ptr) {
+                    called.set_value();
+                    throw std::runtime_error("callback failed");
+                });
+    called.get_future().get();
+
+    auto replies = conn.submit(sentence("echo"_cmd)[{"value", "2"}]).get();
+    REQUIRE(replies.size() == 2);
+    CHECK(attribute_map(replies[0]).get("value") == "2");
+    CHECK_FALSE(conn.failed());
+    CHECK(conn.pending() == 0);
+}
+
+TEST_CASE("shared_connection rejects empty callbacks",
+          "[shared_connection][api]") {
+    mock::server srv;
+    shared_connection conn(srv.address(), "admin", "", srv.port());
+
+    CHECK_THROWS_AS(conn.submit(sentence("interface"_cmd / "print"), shared_connection::completion{}),
+                    std::invalid_argument);
+    CHECK(conn.pending() == 0);
+}
+
+TEST_CASE("shared_connection routes replies to many submitting threads",
+          "[shared_connection][e2e][api]") {
+    mock::server srv;
+    echo(srv);
+    shared_connection conn(srv.address(), "admin", "", srv.port());
+
+    constexpr const int threads = 8;
+    constexpr const int requests = 200;
+    std::atomic<int> wrong{0};
+    std::vector<std::thread> submitters;
+    for (int t = 0; t < threads; ++t) {
+        submitters.emplace_back([&, t] {
+            std::vector<std::future<std::vector<reply>>> futures;
+            for (int i = 0; i < requests; ++i) {
+                sentence snt("echo"_cmd);
+                snt.add_attribute("value", t * requests + i);
+                futures.push_back(conn.submit(std::move(snt)));
+            }
+            for (int i = 0; i < requests; ++i) {
+                auto replies = futures[static_cast<std::size_t>(i)].get();
+                if (replies.size() != 2
+                    || attribute_map(replies[0]).get("value") != std::to_string(t * requests + i))
+                    ++wrong;
+            }
+        });
+    }
+    for (auto& thr : submitters) {
+        thr.join();
+    }
+
+    CHECK(wrong == 0);
+    CHECK(srv.requests() == threads * requests + 1);
+    CHECK(srv.connections() == 1);
+}
+
+TEST_CASE("shared_connection fails sentences once the connection is lost",
+          "[shared_connection][e2e][api]") {
+    mock::server srv;
+    shared_connection conn(srv.address(), "admin", "", srv.port());
+
+    std::promise<std::exception_ptr> quit;
+    conn.submit(sentence("quit"_cmd),
+                [&quit](std::vector<reply>&& replies, std::exception_ptr err) {
+                    CHECK(replies.size() == 1);
+                    quit.set_value(err);
+                });
+    CHECK(quit.get_future().get());
+    CHECK(conn.failed());
+
+    auto later = conn.submit(sentence("interface"_cmd / "print"));
+    CHECK_THROWS_AS(later.get(), bad_socket);
+    CHECK(conn.pending() == 0);
+}
+
+TEST_CASE("shared_connection fails sentences in flight when destroyed",
+          "[shared_connection][e2e][api]") {
+    mock::server srv;
+    srv.latency(std::chrono::milliseconds(200));
+    std::future<std::vector<reply>> late;
+    {
+        shared_connection conn(srv.address(), "admin", "", srv.port());
+        late = conn.submit(sentence("interface"_cmd / "print"));
+    }
+    CHECK_THROWS_AS(late.get(), bad_socket);
+}
+
+TEST_CASE("shared_connection times out a device not answering",
+          "[shared_connection][socket_timeout][e2e][api]") {
+    mock::server srv;
+    // answered only when the test finishes, releasing the thread of the server
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    srv.on("/stall", [released](const mock::request&) {
+        released.wait_for(10s);
+        return std::vector<reply>{{reply::done, {}}};
+    });
+
+    timeouts limits;
+    limits.operation = 100ms;
+    shared_connection conn(srv.address(), "admin", "", srv.port(), limits);
+
+    auto start = std::chrono::steady_clock::now();
+    auto stalled = conn.submit(sentence("stall"_cmd));
+    auto after = conn.submit(sentence("interface"_cmd / "print"));
+    CHECK_THROWS_AS(stalled.get(), socket_timeout);
+    CHECK_THROWS_AS(after.get(), socket_timeout);
+    CHECK(std::chrono::steady_clock::now() - start < 5s);
+    CHECK(conn.failed());
+    release.set_value();
+}
+
+TEST_CASE("shared_connection does not time out while idle",
+          "[shared_connection][socket_timeout][e2e][api]") {
+    mock::server srv;
+    echo(srv);
+    timeouts limits;
+    limits.operation = 50ms;
+    shared_connection conn(srv.address(), "admin", "", srv.port(), limits);
+
+    std::this_thread::sleep_for(150ms);
+    auto replies = conn.submit(sentence("echo"_cmd)[{"value", "1"}]).get();
+    REQUIRE(replies.size() == 2);
+    CHECK(attribute_map(replies[0]).get("value") == "1");
+    CHECK_FALSE(conn.failed());
+}
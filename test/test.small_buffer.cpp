@@ -0,0 +1,134 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <memory_resource>
+#include <numeric>
+#include <utility>
+
+// test'd
+#include <mikrotik/api/impl/small_buffer.hpp>
+using namespace mikrotik::api::impl;
+
+namespace {
+    struct counting_resource : std::pmr::memory_resource {
+        std::size_t allocated = 0;
+        std::size_t deallocated = 0;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t align) override {
+            allocated += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, align);
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t align) override {
+            deallocated += bytes;
+            std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+}
+
+TEST_CASE("small_buffer stores small contents inline",
+          "[small_buffer][util][impl]") {
+    small_buffer<int, 4> buf;
+    for (int i = 0; i < 4; ++i) {
+        buf.push_back(i);
+    }
+
+    CHECK(buf.is_inline());
+    CHECK(buf.size() == 4);
+    CHECK(buf.data()[3] == 3);
+}
+
+TEST_CASE("small_buffer keeps contents when growing out of inline storage",
+          "[small_buffer][util][impl]") {
+    small_buffer<int, 4> buf;
+    for (int i = 0; i < 100; ++i) {
+        buf.push_back(i);
+    }
+
+    CHECK_FALSE(buf.is_inline());
+    CHECK(buf.size() == 100);
+    CHECK(std::accumulate(buf.data(), buf.data() + buf.size(), 0) == 4950);
+}
+
+TEST_CASE("small_buffer copies and moves its contents",
+          "[small_buffer][util][impl]") {
+    small_buffer<char, 4> small;
+    small.append("abc", 3);
+    small_buffer<char, 4> big;
+    big.append("abcdefgh", 8);
+
+    auto small_cp = small;
+    auto big_cp = big;
+    CHECK(small_cp.size() == 3);
+    CHECK(big_cp.size() == 8);
+    CHECK(big_cp.data() != big.data());
+
+    auto small_mv = std::move(small_cp);
+    auto big_data = big_cp.data();
+    auto big_mv = std::move(big_cp);
+    CHECK(small_mv.size() == 3);
+    CHECK(small_mv.data()[2] == 'c');
+    CHECK(big_mv.data() == big_data);
+    CHECK(big_cp.size() == 0);
+
+    small_mv = big_mv;
+    CHECK(small_mv.size() == 8);
+    CHECK(small_mv.data()[7] == 'h');
+}
+
+TEST_CASE("small_buffer allocates from its memory resource",
+          "[small_buffer][util][impl]") {
+    counting_resource res;
+    {
+        small_buffer<char, 4> buf(&res);
+        buf.append("abc", 3);
+        CHECK(res.allocated == 0);
+
+        buf.append("defgh", 5);
+        CHECK(res.allocated >= 8);
+
+        auto cp = buf;
+        CHECK(cp.resource() == &res);
+        auto mv = std::move(cp);
+        CHECK(mv.resource() == &res);
+    }
+    CHECK(res.allocated == res.deallocated);
+}
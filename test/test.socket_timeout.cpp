@@ -0,0 +1,145 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+// stdlib
+#include <chrono>
+#include <string_view>
+#include <type_traits>
+
+// test'd
+#include <mikrotik/api/api_handler.hpp>
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/exception/socket_timeout.hpp>
+#include <mikrotik/api/mock/server.hpp>
+#ifndef _WIN32
+#    include <arpa/inet.h>
+#    include <netinet/in.h>
+#    include <sys/socket.h>
+#    include <unistd.h>
+#endif
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+using namespace std::chrono_literals;
+
+TEST_CASE("socket_timeout creates correct error message",
+          "[socket_timeout][exception][api]") {
+    socket_timeout ex("reading a reply", 250ms);
+
+    CHECK(ex.what() == std::string_view{"error: failure while handling sockets: reading a reply timed out after 250 ms"});
+    CHECK(ex.operation() == "reading a reply");
+    CHECK(ex.limit() == 250ms);
+    CHECK(std::is_base_of_v<bad_socket, socket_timeout>);
+}
+
+TEST_CASE("api_handler times out logging into a slow device",
+          "[socket_timeout][e2e][api]") {
+    mock::server srv;
+    srv.latency(500ms);
+    timeouts limits;
+    limits.login = 100ms;
+
+    auto start = std::chrono::steady_clock::now();
+    CHECK_THROWS_AS(api_handler(srv.address(), "admin", "", srv.port(), limits), socket_timeout);
+    CHECK(std::chrono::steady_clock::now() - start < 400ms);
+}
+
+TEST_CASE("api_handler times out reading a late reply",
+          "[socket_timeout][e2e][api]") {
+    mock::server srv;
+    srv.table("/interface", {{{"name", "ether1"}}});
+    timeouts limits;
+    limits.operation = 100ms;
+    api_handler api(srv.address(), "admin", "", srv.port(), limits);
+    CHECK(api.get_timeouts().operation == 100ms);
+
+    api.send("interface"_cmd / "print");
+    CHECK(api.read().reply_type == reply::re);
+    CHECK(api.read().reply_type == reply::done);
+
+    srv.latency(500ms);
+    api.send("interface"_cmd / "print");
+    try {
+        api.read();
+        FAIL("read did not time out");
+    } catch (const socket_timeout& ex) {
+        CHECK(ex.operation() == "reading a reply");
+        CHECK(ex.limit() == 100ms);
+    }
+}
+
+TEST_CASE("api_handler waits without a time limit by default",
+          "[socket_timeout][e2e][api]") {
+    mock::server srv;
+    srv.table("/interface", {{{"name", "ether1"}}});
+    api_handler api(srv.address(), "admin", "", srv.port());
+    api.set_timeouts(timeouts{0ms, 0ms, 50ms});
+    api.set_timeouts({});
+
+    srv.latency(100ms);
+    api.send("interface"_cmd / "print");
+    CHECK(api.read().reply_type == reply::re);
+    CHECK(api.read().reply_type == reply::done);
+}
+
+#ifndef _WIN32
+TEST_CASE("api_handler times out connecting to an unresponsive device",
+          "[socket_timeout][e2e][api]") {
+    // a listener which never accepts: once its queue is full, the
+    // handshake of the next connection is not answered
+    int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    REQUIRE(::bind(listener, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    REQUIRE(::listen(listener, 0) == 0);
+    socklen_t len = sizeof(addr);
+    ::getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len);
+    int filler = ::socket(AF_INET, SOCK_STREAM, 0);
+    ::connect(filler, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+
+    timeouts limits;
+    limits.connect = 100ms;
+    try {
+        api_handler api("127.0.0.1", "admin", "", ntohs(addr.sin_port), limits);
+        FAIL("connect did not time out");
+    } catch (const socket_timeout& ex) {
+        CHECK(ex.operation().rfind("connecting to 127.0.0.1:", 0) == 0);
+        CHECK(ex.limit() == 100ms);
+    }
+
+    ::close(filler);
+    ::close(listener);
+}
+#endif
@@ -0,0 +1,125 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <mikrotik_api_export.h>
+#if defined(MIKROTIK_API_STATIC_DEFINE) && !defined(_WIN32)
+#    include <catch2/catch.hpp>
+
+#    include <cerrno>
+#    include <string>
+
+// test'd
+#    include "impl/calc_len.hpp"
+#    include "impl/socket_funcs.hpp"
+#    include <mikrotik/api/command.hpp>
+#    include <mikrotik/api/protocol.hpp>
+#    include <mikrotik/api/sentence.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+namespace sock = mikrotik::api::impl::socket;
+
+namespace {
+    struct socket_pair {
+        socket_pair() {
+            ::socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+        }
+        ~socket_pair() {
+            ::close(fds[0]);
+            ::close(fds[1]);
+        }
+
+        int fds[2] = {-1, -1};
+    };
+}
+
+TEST_CASE("gathered send continues after short writes",
+          "[socket][protocol][impl]") {
+    socket_pair pair;
+    int size = 4096;
+    REQUIRE(::setsockopt(pair.fds[0], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size)) == 0);
+    REQUIRE(sock::set_nonblocking(pair.fds[0], true) == 0);
+
+    sentence snt = "file"_cmd / "set";
+    std::string expected = impl::calc_len("/file/set") + "/file/set";
+    for (char name : {'a', 'b', 'c', 'd'}) {
+        std::string value(20'000, name);
+        snt.add_attribute(std::string(1, name), value);
+        auto word = "=" + std::string(1, name) + "=" + value;
+        expected += impl::calc_len(word) + word;
+    }
+    expected += '\0';
+
+    protocol proto;
+    proto.send(snt);
+    std::string received;
+    std::size_t short_writes = 0;
+    while (!proto.next_output().empty()) {
+        auto out = proto.next_output();
+        auto sent = sock::send(pair.fds[0], out.bufs, out.count);
+        if (sent == SOCKET_ERROR) {
+            REQUIRE(sock::would_block(sock::get_last_error()));
+            // only make a little room, so the next write is short again
+            char buf[1000];
+            auto read = ::read(pair.fds[1], buf, sizeof(buf));
+            REQUIRE(read > 0);
+            received.append(buf, static_cast<std::size_t>(read));
+            continue;
+        }
+        if (static_cast<std::size_t>(sent) < out.size())
+            ++short_writes;
+        proto.consume_output(static_cast<std::size_t>(sent));
+    }
+    while (received.size() < expected.size()) {
+        char buf[4096];
+        auto read = ::read(pair.fds[1], buf, sizeof(buf));
+        REQUIRE(read > 0);
+        received.append(buf, static_cast<std::size_t>(read));
+    }
+
+    CHECK(short_writes > 1);
+    CHECK(received == expected);
+}
+
+TEST_CASE("sending to a closed connection fails without a signal",
+          "[socket][impl]") {
+    socket_pair pair;
+    ::close(pair.fds[1]);
+    pair.fds[1] = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    // sockets of the library are created with it already
+    sock::no_sigpipe(pair.fds[0]);
+
+    sock::buffer buf{"x", 1};
+    CHECK(sock::send(pair.fds[0], &buf, 1) == SOCKET_ERROR);
+    CHECK(sock::get_last_error() == EPIPE);
+}
+#endif
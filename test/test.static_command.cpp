@@ -0,0 +1,101 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2020, bodand
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by bodand on 2026-10-17.
+//
+
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <string_view>
+using namespace std::literals;
+
+// test'd
+#include <mikrotik/api/command.hpp>
+#include <mikrotik/api/static_command.hpp>
+using namespace mikrotik::api;
+using namespace mikrotik::api::literals;
+
+TEST_CASE("command_path joins the parts like the command DSL",
+          "[static_command][dsl][api]") {
+    constexpr auto cmd = command_path("interface", "print");
+
+    static_assert(cmd.word() == "/interface/print");
+    CHECK(cmd.word() == ("interface"_cmd / "print").cmd);
+}
+
+TEST_CASE("static_command is encoded with length prefix and terminator",
+          "[static_command][dsl][api]") {
+    constexpr auto cmd = command_path("interface", "print");
+
+    static_assert(cmd.size == 18);
+    CHECK(cmd.encoded() == "\x10/interface/print\0"sv);
+}
+
+TEST_CASE("static_command uses longer length prefix for long words",
+          "[static_command][dsl][api]") {
+    constexpr auto cmd = command_path("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa");
+
+    static_assert(cmd.size == 2 + 131 + 1);
+    CHECK(cmd.encoded().substr(0, 2) == "\x80\x83"sv);
+    CHECK(cmd.word() == "/aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa");
+    CHECK(cmd.encoded().back() == '\0');
+}
+
+TEST_CASE("static_command fits the length prefix of one and two byte words",
+          "[static_command][dsl][api]") {
+    constexpr auto root = command_path("");
+    constexpr auto short_cmd = command_path("a");
+
+    static_assert(root.size == 3);
+    static_assert(short_cmd.size == 4);
+    CHECK(root.encoded() == "\x01/\0"sv);
+    CHECK(short_cmd.encoded() == "\x02/a\0"sv);
+}
+
+TEST_CASE("static_command interoperates with the sentence DSL",
+          "[static_command][dsl][api]") {
+    constexpr auto cmd = command_path("interface", "print");
+
+    CHECK(cmd[{".proplist", "name"}].words() == ("interface"_cmd / "print")[{".proplist", "name"}].words());
+    CHECK(cmd("disabled").words() == ("interface"_cmd / "print")("disabled").words());
+    CHECK(static_cast<sentence>(cmd).words() == sentence("interface"_cmd / "print").words());
+    CHECK(static_cast<command>(cmd).cmd == "/interface/print");
+}
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+TEST_CASE("ct udl creates the same command as command_path",
+          "[udl_ct][udl][dsl][api]") {
+    CHECK("interface/print"_ct.encoded() == command_path("interface", "print").encoded());
+    CHECK("/interface/print"_ct.encoded() == command_path("interface", "print").encoded());
+    CHECK("/"_ct.encoded() == command_path("").encoded());
+    CHECK("a"_ct.encoded() == command_path("a").encoded());
+}
+#endif